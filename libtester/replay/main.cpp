@@ -0,0 +1,152 @@
+/**
+ * @file libtester/replay/main.cpp
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Replays channel captures against a local server.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// libtester Includes
+#include <CaptureReplay.h>
+
+// libcomp Includes
+#include <Log.h>
+
+// Standard C++11 Includes
+#include <iostream>
+
+static void Usage()
+{
+    std::cerr << "SYNTAX: comp_replay --capture FILE [options]" << std::endl
+        << "  --capture FILE    channel capture (*.hack) to replay"
+        << std::endl
+        << "  --clients N       virtual clients replaying the capture"
+        << std::endl
+        << "  --speed X         time scale (1 = real time, 10 = ten times"
+        " faster, 0 = as fast as possible)" << std::endl
+        << "  --io-threads N    threads running the network service"
+        << std::endl
+        << "  --drivers N       threads stepping the clients" << std::endl
+        << "  --ramp RATE       clients started per second" << std::endl
+        << "  --timeout SEC     give up after this many seconds" << std::endl
+        << "  --prefix NAME     account name prefix" << std::endl
+        << "  --password PASS   account password" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    libtester::BotSwarmConfig config;
+    libcomp::String capturePath;
+    double speed = 1.0;
+
+    config.botCount = 1;
+    config.duration = 3600;
+
+    for(int i = 1; i < argc; i++)
+    {
+        libcomp::String arg = argv[i];
+
+        if(arg == "--help" || (i + 1) >= argc)
+        {
+            Usage();
+
+            return arg == "--help" ? 0 : -1;
+        }
+
+        libcomp::String value = argv[++i];
+        bool ok = true;
+
+        if(arg == "--capture")
+        {
+            capturePath = value;
+        }
+        else if(arg == "--clients")
+        {
+            config.botCount = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--speed")
+        {
+            speed = value.ToDecimal<double>(&ok);
+            ok = ok && 0.0 <= speed;
+        }
+        else if(arg == "--io-threads")
+        {
+            config.ioThreads = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--drivers")
+        {
+            config.driverThreads = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--ramp")
+        {
+            config.rampRate = value.ToDecimal<double>(&ok);
+        }
+        else if(arg == "--timeout")
+        {
+            config.duration = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--prefix")
+        {
+            config.usernamePrefix = value;
+        }
+        else if(arg == "--password")
+        {
+            config.password = value;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if(!ok)
+        {
+            std::cerr << "Bad value for " << arg.C() << ": "
+                << value.C() << std::endl;
+            Usage();
+
+            return -1;
+        }
+    }
+
+    if(capturePath.IsEmpty())
+    {
+        Usage();
+
+        return -1;
+    }
+
+    libcomp::Log::GetSingletonPtr()->AddStandardOutputHook();
+
+    libtester::CaptureFile capture;
+
+    if(!capture.Load(capturePath))
+    {
+        return -1;
+    }
+
+    libtester::CaptureReplay replay(capture, speed);
+
+    bool result = replay.Run(config);
+    replay.Report();
+
+    return result ? 0 : -1;
+}
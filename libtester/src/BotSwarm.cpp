@@ -0,0 +1,849 @@
+/**
+ * @file libtester/src/BotSwarm.cpp
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Load generator multiplexing many simulated players.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BotSwarm.h"
+
+// libcomp Includes
+#include <Crypto.h>
+#include <Log.h>
+
+// object Includes
+#include <PacketLogin.h>
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+using namespace libtester;
+
+static const uint32_t SWARM_CLIENT_VERSION = 1666;
+static const uint16_t SWARM_LOBBY_PORT = 10666;
+static const uint16_t SWARM_CHANNEL_PORT = 14666;
+
+BotSwarmConfig::BotSwarmConfig() : botCount(100), ioThreads(4),
+    driverThreads(4), rampRate(10.0), duration(60), thinkTime(1000),
+    replyTimeout(30000), usernamePrefix("swarmbot"),
+    password("swarm_password"), moveWeight(50), chatWeight(20),
+    skillWeight(20), zoneWeight(10), skillID(0), seed(0)
+{
+}
+
+SwarmBot::SwarmBot(BotSwarm *pSwarm, uint32_t index,
+    asio::io_service& service) : mSwarm(pSwarm), mIndex(index),
+    mState(State::IDLE), mService(service), mSessionKey(-1), mZoneIndex(0),
+    mX(0.0f), mY(0.0f), mRandom(pSwarm->GetConfig().seed + index)
+{
+    mUsername = libcomp::String("%1%2").Arg(
+        pSwarm->GetConfig().usernamePrefix).Arg(index);
+}
+
+SwarmBot::~SwarmBot()
+{
+}
+
+void SwarmBot::Start()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    mLoginStart = now;
+    mLobby = std::make_shared<LobbyClient>(mService);
+    mLobby->GetConnection()->SetName(libcomp::String("lobby_%1").Arg(
+        mUsername));
+
+    if(!mLobby->Connect(SWARM_LOBBY_PORT))
+    {
+        Fail("lobby connect failed");
+        return;
+    }
+
+    Expect(State::LOBBY_ENCRYPT, now);
+}
+
+void SwarmBot::Stop()
+{
+    if(mLobby)
+    {
+        mLobby->Disconnect();
+        mLobby.reset();
+    }
+
+    if(mChannel)
+    {
+        mChannel->Disconnect();
+        mChannel.reset();
+    }
+
+    if(State::FAILED != mState)
+    {
+        mState = State::DONE;
+    }
+}
+
+SwarmBot::State SwarmBot::GetState() const
+{
+    return mState;
+}
+
+void SwarmBot::Expect(State state,
+    const std::chrono::steady_clock::time_point& now)
+{
+    mState = state;
+    mRequestStart = now;
+}
+
+bool SwarmBot::TimedOut(const std::chrono::steady_clock::time_point& now) const
+{
+    return Elapsed(now, mRequestStart) > (double)mSwarm->GetConfig()
+        .replyTimeout;
+}
+
+double SwarmBot::Elapsed(const std::chrono::steady_clock::time_point& now,
+    const std::chrono::steady_clock::time_point& since) const
+{
+    std::chrono::duration<double, std::milli> duration = now - since;
+
+    return duration.count();
+}
+
+void SwarmBot::Fail(const libcomp::String& reason)
+{
+    LogGeneralWarning([&]()
+    {
+        return libcomp::String("Bot %1 failed in state %2: %3\n")
+            .Arg(mUsername).Arg(to_underlying(mState)).Arg(reason);
+    });
+
+    switch(mState)
+    {
+    case State::WAIT_SKILL:
+        mSwarm->GetSkillStats().RecordFailure();
+        break;
+    case State::WAIT_ZONE:
+        mSwarm->GetZoneChangeStats().RecordFailure();
+        break;
+    default:
+        mSwarm->GetLoginStats().RecordFailure();
+        break;
+    }
+
+    mState = State::FAILED;
+    mSwarm->BotFailed();
+
+    Stop();
+}
+
+bool SwarmBot::Step(const std::chrono::steady_clock::time_point& now)
+{
+    switch(mState)
+    {
+    case State::IDLE:
+    case State::FAILED:
+    case State::DONE:
+        return false;
+    case State::LOBBY_ENCRYPT:
+    case State::LOBBY_LOGIN:
+    case State::LOBBY_AUTH:
+    case State::LOBBY_CHARACTER_LIST:
+    case State::LOBBY_CREATE_CHARACTER:
+    case State::LOBBY_START_GAME:
+        return StepLobby(now);
+    case State::CHANNEL_ENCRYPT:
+    case State::CHANNEL_LOGIN:
+    case State::CHANNEL_AUTH:
+    case State::CHANNEL_SEND_DATA:
+    case State::CHANNEL_STATE:
+        return StepChannel(now);
+    default:
+        return StepActive(now);
+    }
+}
+
+void SwarmBot::SendLogin()
+{
+    objects::PacketLogin obj;
+    obj.SetClientVersion(SWARM_CLIENT_VERSION);
+    obj.SetUsername(mUsername);
+
+    libcomp::Packet p;
+    p.WritePacketCode(ClientToLobbyPacketCode_t::PACKET_LOGIN);
+    obj.SavePacket(p);
+
+    mLobby->GetConnection()->SendPacket(p);
+}
+
+bool SwarmBot::StepLobby(const std::chrono::steady_clock::time_point& now)
+{
+    bool failed = false;
+    uint16_t code = 0;
+    libcomp::ReadOnlyPacket reply;
+
+    if(State::LOBBY_ENCRYPT == mState)
+    {
+        if(!mLobby->PollEncrypted(failed))
+        {
+            if(failed || TimedOut(now))
+            {
+                Fail("lobby encryption");
+            }
+
+            return false;
+        }
+
+        SendLogin();
+        Expect(State::LOBBY_LOGIN, now);
+
+        return true;
+    }
+
+    static const std::map<State, uint16_t> replyCodes = {
+        { State::LOBBY_LOGIN,
+            to_underlying(LobbyToClientPacketCode_t::PACKET_LOGIN) },
+        { State::LOBBY_AUTH,
+            to_underlying(LobbyToClientPacketCode_t::PACKET_AUTH) },
+        { State::LOBBY_CHARACTER_LIST,
+            to_underlying(LobbyToClientPacketCode_t::PACKET_CHARACTER_LIST) },
+        { State::LOBBY_CREATE_CHARACTER, to_underlying(
+            LobbyToClientPacketCode_t::PACKET_CREATE_CHARACTER) },
+        { State::LOBBY_START_GAME,
+            to_underlying(LobbyToClientPacketCode_t::PACKET_START_GAME) },
+    };
+
+    uint16_t expected = replyCodes.at(mState);
+
+    if(!mLobby->PollForPacket({ expected }, reply, code, failed))
+    {
+        if(failed || TimedOut(now))
+        {
+            Fail("lobby reply");
+        }
+
+        return false;
+    }
+
+    libcomp::Packet p;
+
+    switch(mState)
+    {
+    case State::LOBBY_LOGIN:
+        {
+            int32_t err = reply.ReadS32Little();
+
+            if(to_underlying(ErrorCodes_t::ACCOUNT_STILL_LOGGED_IN) == err)
+            {
+                // A previous run has not been logged out yet; ask again.
+                SendLogin();
+                return true;
+            }
+            else if(to_underlying(ErrorCodes_t::SUCCESS) != err)
+            {
+                Fail(libcomp::String("login error %1").Arg(err));
+                return true;
+            }
+
+            uint32_t challenge = reply.ReadU32Little();
+            libcomp::String salt = reply.ReadString16Little(
+                libcomp::Convert::ENCODING_UTF8);
+
+            p.WritePacketCode(ClientToLobbyPacketCode_t::PACKET_AUTH);
+            p.WriteString16Little(libcomp::Convert::ENCODING_UTF8,
+                libcomp::Crypto::HashPassword(libcomp::Crypto::HashPassword(
+                mSwarm->GetConfig().password, salt), libcomp::String(
+                "%1").Arg(challenge)), true);
+
+            mLobby->GetConnection()->SendPacket(p);
+            Expect(State::LOBBY_AUTH, now);
+        }
+        break;
+    case State::LOBBY_AUTH:
+        if(to_underlying(ErrorCodes_t::SUCCESS) != reply.ReadS32Little())
+        {
+            Fail("auth error");
+            return true;
+        }
+
+        p.WritePacketCode(ClientToLobbyPacketCode_t::PACKET_CHARACTER_LIST);
+        mLobby->GetConnection()->SendPacket(p);
+        Expect(State::LOBBY_CHARACTER_LIST, now);
+        break;
+    case State::LOBBY_CHARACTER_LIST:
+        (void)reply.ReadU32Little(); // login time
+        (void)reply.ReadU8(); // ticket count
+
+        if(0 != reply.ReadU8())
+        {
+            p.WritePacketCode(ClientToLobbyPacketCode_t::PACKET_START_GAME);
+            p.WriteU8(0);
+            p.WriteS8(0);
+
+            mLobby->GetConnection()->SendPacket(p);
+            Expect(State::LOBBY_START_GAME, now);
+        }
+        else
+        {
+            // First run for this account so make the character now.
+            p.WritePacketCode(
+                ClientToLobbyPacketCode_t::PACKET_CREATE_CHARACTER);
+            p.WriteS8(0); // world
+            p.WriteString16Little(libcomp::Convert::ENCODING_CP932,
+                mUsername, true);
+            p.WriteS8(to_underlying(objects::Character::Gender_t::MALE));
+            p.WriteU32Little(0x00000065); // skin
+            p.WriteU32Little(0x00000001); // face
+            p.WriteU32Little(0x00000001); // hair
+            p.WriteU32Little(0x00000008); // hair color
+            p.WriteU32Little(0x00000008); // eye color
+            p.WriteU32Little(0x00000C3F); // top
+            p.WriteU32Little(0x00000D64); // bottom
+            p.WriteU32Little(0x00000DB4); // feet
+            p.WriteU32Little(0x00001131); // comp
+            p.WriteU32Little(0x000004B1); // weapon
+
+            mLobby->GetConnection()->SendPacket(p);
+            Expect(State::LOBBY_CREATE_CHARACTER, now);
+        }
+        break;
+    case State::LOBBY_CREATE_CHARACTER:
+        if(to_underlying(ErrorCodes_t::SUCCESS) != reply.ReadS32Little())
+        {
+            Fail("create character error");
+            return true;
+        }
+
+        p.WritePacketCode(ClientToLobbyPacketCode_t::PACKET_CHARACTER_LIST);
+        mLobby->GetConnection()->SendPacket(p);
+        Expect(State::LOBBY_CHARACTER_LIST, now);
+        break;
+    case State::LOBBY_START_GAME:
+        mSessionKey = reply.ReadS32Little();
+
+        if(0 > mSessionKey)
+        {
+            Fail("start game error");
+            return true;
+        }
+
+        mLobby->Disconnect();
+        mLobby.reset();
+
+        mChannel = std::make_shared<ChannelClient>(mService);
+        mChannel->GetConnection()->SetName(libcomp::String(
+            "channel_%1").Arg(mUsername));
+
+        if(!mChannel->Connect(SWARM_CHANNEL_PORT))
+        {
+            Fail("channel connect failed");
+            return true;
+        }
+
+        Expect(State::CHANNEL_ENCRYPT, now);
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+bool SwarmBot::StepChannel(const std::chrono::steady_clock::time_point& now)
+{
+    bool failed = false;
+    uint16_t code = 0;
+    libcomp::ReadOnlyPacket reply;
+    libcomp::Packet p;
+
+    if(State::CHANNEL_ENCRYPT == mState)
+    {
+        if(!mChannel->PollEncrypted(failed))
+        {
+            if(failed || TimedOut(now))
+            {
+                Fail("channel encryption");
+            }
+
+            return false;
+        }
+
+        p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_LOGIN);
+        p.WriteString16Little(libcomp::Convert::ENCODING_UTF8,
+            mUsername, true);
+        p.WriteS32Little(mSessionKey);
+
+        mChannel->GetConnection()->SendPacket(p);
+        Expect(State::CHANNEL_LOGIN, now);
+
+        return true;
+    }
+
+    static const std::map<State, uint16_t> replyCodes = {
+        { State::CHANNEL_LOGIN,
+            to_underlying(ChannelToClientPacketCode_t::PACKET_LOGIN) },
+        { State::CHANNEL_AUTH,
+            to_underlying(ChannelToClientPacketCode_t::PACKET_AUTH) },
+        { State::CHANNEL_SEND_DATA,
+            to_underlying(ChannelToClientPacketCode_t::PACKET_ZONE_CHANGE) },
+        { State::CHANNEL_STATE, to_underlying(
+            ChannelToClientPacketCode_t::PACKET_CHARACTER_DATA) },
+    };
+
+    uint16_t expected = replyCodes.at(mState);
+
+    if(!mChannel->PollForPacket({ expected }, reply, code, failed))
+    {
+        if(failed || TimedOut(now))
+        {
+            Fail("channel reply");
+        }
+
+        return false;
+    }
+
+    switch(mState)
+    {
+    case State::CHANNEL_LOGIN:
+        if(1 != reply.ReadU32Little())
+        {
+            Fail("channel login error");
+            return true;
+        }
+
+        p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_AUTH);
+        p.WriteString16Little(libcomp::Convert::ENCODING_UTF8,
+            "0000000000000000000000000000000000000000", true);
+
+        mChannel->GetConnection()->SendPacket(p);
+        Expect(State::CHANNEL_AUTH, now);
+        break;
+    case State::CHANNEL_AUTH:
+        if(to_underlying(ErrorCodes_t::SUCCESS) != reply.ReadU32Little())
+        {
+            Fail("channel auth error");
+            return true;
+        }
+
+        p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_SEND_DATA);
+        mChannel->GetConnection()->SendPacket(p);
+        Expect(State::CHANNEL_SEND_DATA, now);
+        break;
+    case State::CHANNEL_SEND_DATA:
+        // The login ends once the character is placed in a zone.
+        mSwarm->GetLoginStats().Record(Elapsed(now, mLoginStart));
+
+        p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_STATE);
+        mChannel->GetConnection()->SendPacket(p);
+        Expect(State::CHANNEL_STATE, now);
+        break;
+    case State::CHANNEL_STATE:
+        p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_POPULATE_ZONE);
+        p.WriteS32Little(mChannel->GetEntityID());
+        mChannel->GetConnection()->SendPacket(p);
+
+        mChannelStart = now;
+        mNextAction = now;
+        mState = State::ACTIVE;
+        mSwarm->BotActive();
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+bool SwarmBot::StepActive(const std::chrono::steady_clock::time_point& now)
+{
+    bool failed = false;
+    uint16_t code = 0;
+    libcomp::ReadOnlyPacket reply;
+
+    if(State::WAIT_SKILL == mState)
+    {
+        if(!mChannel->PollForPacket({
+            to_underlying(ChannelToClientPacketCode_t::PACKET_SKILL_ACTIVATED),
+            to_underlying(ChannelToClientPacketCode_t::PACKET_SKILL_FAILED)
+            }, reply, code, failed))
+        {
+            if(failed || TimedOut(now))
+            {
+                Fail("skill reply");
+            }
+
+            return false;
+        }
+
+        // A failure still measures the full round trip.
+        mSwarm->GetSkillStats().Record(Elapsed(now, mRequestStart));
+        mState = State::ACTIVE;
+
+        return true;
+    }
+    else if(State::WAIT_ZONE == mState)
+    {
+        if(!mChannel->PollForPacket({ to_underlying(
+            ChannelToClientPacketCode_t::PACKET_ZONE_CHANGE) }, reply, code,
+            failed))
+        {
+            if(failed || TimedOut(now))
+            {
+                Fail("zone change reply");
+            }
+
+            return false;
+        }
+
+        mSwarm->GetZoneChangeStats().Record(Elapsed(now, mRequestStart));
+
+        libcomp::Packet p;
+        p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_POPULATE_ZONE);
+        p.WriteS32Little(mChannel->GetEntityID());
+        mChannel->GetConnection()->SendPacket(p);
+
+        mState = State::ACTIVE;
+
+        return true;
+    }
+
+    // Drain anything the server pushed so the queue does not grow.
+    mChannel->PollForPacket({}, reply, code, failed);
+
+    if(failed)
+    {
+        Fail("disconnected");
+        return true;
+    }
+
+    if(now < mNextAction)
+    {
+        return false;
+    }
+
+    auto& config = mSwarm->GetConfig();
+
+    mNextAction = now + std::chrono::milliseconds(config.thinkTime);
+
+    uint32_t total = config.moveWeight + config.chatWeight +
+        (config.skillID ? config.skillWeight : 0) +
+        (config.zones.empty() ? 0 : config.zoneWeight);
+
+    if(0 == total)
+    {
+        return false;
+    }
+
+    uint32_t roll = std::uniform_int_distribution<uint32_t>(
+        0, total - 1)(mRandom);
+
+    if(roll < config.moveWeight)
+    {
+        SendMove(now);
+        return true;
+    }
+
+    roll -= config.moveWeight;
+
+    if(roll < config.chatWeight)
+    {
+        SendChat();
+        return true;
+    }
+
+    roll -= config.chatWeight;
+
+    if(config.skillID && roll < config.skillWeight)
+    {
+        SendSkill();
+        Expect(State::WAIT_SKILL, now);
+        return true;
+    }
+
+    SendZoneChange();
+    Expect(State::WAIT_ZONE, now);
+
+    return true;
+}
+
+void SwarmBot::SendMove(const std::chrono::steady_clock::time_point& now)
+{
+    std::uniform_real_distribution<float> offset(-500.0f, 500.0f);
+
+    float destX = mX + offset(mRandom);
+    float destY = mY + offset(mRandom);
+
+    // Client time is seconds since the channel login.
+    float start = (float)(Elapsed(now, mChannelStart) / 1000.0);
+    float stop = start + 1.0f;
+
+    libcomp::Packet p;
+    p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_MOVE);
+    p.WriteS32Little(mChannel->GetEntityID());
+    p.WriteFloat(destX);
+    p.WriteFloat(destY);
+    p.WriteFloat(mX);
+    p.WriteFloat(mY);
+    p.WriteFloat(500.0f); // rate per second
+    p.WriteFloat(start);
+    p.WriteFloat(stop);
+
+    mChannel->GetConnection()->SendPacket(p);
+
+    mX = destX;
+    mY = destY;
+}
+
+void SwarmBot::SendChat()
+{
+    libcomp::Packet p;
+    p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_CHAT);
+    p.WriteU16Little(to_underlying(ChatType_t::CHAT_SAY));
+    p.WriteString16Little(libcomp::Convert::Encoding_t::ENCODING_UTF8,
+        libcomp::String("swarm chatter from %1").Arg(mIndex), true);
+
+    mChannel->GetConnection()->SendPacket(p);
+}
+
+void SwarmBot::SendSkill()
+{
+    libcomp::Packet p;
+    p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_SKILL_ACTIVATE);
+    p.WriteS32Little(mChannel->GetEntityID());
+    p.WriteU32Little(mSwarm->GetConfig().skillID);
+    p.WriteU32Little(ACTIVATION_NOTARGET);
+
+    mChannel->GetConnection()->SendPacket(p);
+}
+
+void SwarmBot::SendZoneChange()
+{
+    auto& zones = mSwarm->GetConfig().zones;
+
+    mZoneIndex = (mZoneIndex + 1) % (uint32_t)zones.size();
+    mX = mY = 0.0f;
+
+    // Bot accounts are GMs so the zone command moves them directly.
+    libcomp::Packet p;
+    p.WritePacketCode(ClientToChannelPacketCode_t::PACKET_CHAT);
+    p.WriteU16Little(to_underlying(ChatType_t::CHAT_SAY));
+    p.WriteString16Little(libcomp::Convert::Encoding_t::ENCODING_UTF8,
+        libcomp::String("@zone %1").Arg(zones[mZoneIndex]), true);
+
+    mChannel->GetConnection()->SendPacket(p);
+}
+
+BotSwarm::BotSwarm(const BotSwarmConfig& config,
+    const BotFactory_t& factory) : mConfig(config), mRunning(false),
+    mActiveCount(0), mFinishedCount(0), mFailedCount(0),
+    mLoginStats("login"), mZoneChangeStats("zone_change"),
+    mSkillStats("skill")
+{
+    mConfig.ioThreads = std::max(1U, mConfig.ioThreads);
+    mConfig.driverThreads = std::max(1U, mConfig.driverThreads);
+
+    if(0.0 >= mConfig.rampRate)
+    {
+        mConfig.rampRate = 1.0;
+    }
+
+    for(uint32_t i = 0; i < mConfig.botCount; i++)
+    {
+        mBots.push_back(factory ? factory(this, i, mService) :
+            std::make_shared<SwarmBot>(this, i, mService));
+    }
+}
+
+BotSwarm::~BotSwarm()
+{
+    mRunning = false;
+
+    for(auto& t : mDriverThreads)
+    {
+        if(t.joinable())
+        {
+            t.join();
+        }
+    }
+
+    mBots.clear();
+    mWork.reset();
+    mService.stop();
+
+    for(auto& t : mIOThreads)
+    {
+        if(t.joinable())
+        {
+            t.join();
+        }
+    }
+}
+
+const BotSwarmConfig& BotSwarm::GetConfig() const
+{
+    return mConfig;
+}
+
+LatencyStats& BotSwarm::GetLoginStats()
+{
+    return mLoginStats;
+}
+
+LatencyStats& BotSwarm::GetZoneChangeStats()
+{
+    return mZoneChangeStats;
+}
+
+LatencyStats& BotSwarm::GetSkillStats()
+{
+    return mSkillStats;
+}
+
+void BotSwarm::BotActive()
+{
+    mActiveCount++;
+}
+
+void BotSwarm::BotFinished()
+{
+    mFinishedCount++;
+}
+
+void BotSwarm::BotFailed()
+{
+    mFailedCount++;
+}
+
+bool BotSwarm::Run()
+{
+    mWork.reset(new asio::io_service::work(mService));
+
+    for(uint32_t i = 0; i < mConfig.ioThreads; i++)
+    {
+        mIOThreads.push_back(std::thread([this]()
+        {
+            mService.run();
+        }));
+    }
+
+    mStartTime = std::chrono::steady_clock::now();
+    mRunning = true;
+
+    for(uint32_t i = 0; i < mConfig.driverThreads; i++)
+    {
+        mDriverThreads.push_back(std::thread(&BotSwarm::DriverLoop,
+            this, i));
+    }
+
+    auto rampTime = std::chrono::milliseconds((int64_t)(
+        (double)mConfig.botCount / mConfig.rampRate * 1000.0));
+    auto endTime = mStartTime + rampTime +
+        std::chrono::seconds(mConfig.duration);
+
+    while(std::chrono::steady_clock::now() < endTime &&
+        (mFinishedCount + mFailedCount) < mConfig.botCount)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        LogGeneralInfo([&]()
+        {
+            return libcomp::String("Swarm: %1 active, %2 finished, %3 failed"
+                " of %4\n").Arg(mActiveCount.load())
+                .Arg(mFinishedCount.load()).Arg(mFailedCount.load())
+                .Arg(mConfig.botCount);
+        });
+    }
+
+    mRunning = false;
+
+    for(auto& t : mDriverThreads)
+    {
+        t.join();
+    }
+
+    mDriverThreads.clear();
+
+    for(auto& bot : mBots)
+    {
+        bot->Stop();
+    }
+
+    return 0 < mActiveCount;
+}
+
+void BotSwarm::DriverLoop(uint32_t driver)
+{
+    // Each driver owns every Nth bot so no bot is stepped concurrently.
+    std::vector<std::shared_ptr<SwarmBot>> bots;
+
+    for(size_t i = driver; i < mBots.size(); i += mConfig.driverThreads)
+    {
+        bots.push_back(mBots[i]);
+    }
+
+    size_t started = 0;
+
+    while(mRunning)
+    {
+        auto now = std::chrono::steady_clock::now();
+        bool didWork = false;
+
+        // Start any bots whose ramp slot has arrived.
+        while(started < bots.size())
+        {
+            size_t index = driver + started * mConfig.driverThreads;
+            auto startAt = mStartTime + std::chrono::microseconds((int64_t)(
+                (double)index / mConfig.rampRate * 1000000.0));
+
+            if(now < startAt)
+            {
+                break;
+            }
+
+            bots[started++]->Start();
+            didWork = true;
+        }
+
+        for(size_t i = 0; i < started; i++)
+        {
+            didWork |= bots[i]->Step(now);
+        }
+
+        if(!didWork)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void BotSwarm::Report() const
+{
+    std::cout << "bots," << mConfig.botCount << std::endl;
+    std::cout << "active," << mActiveCount.load() << std::endl;
+    std::cout << "finished," << mFinishedCount.load() << std::endl;
+    std::cout << "failed," << mFailedCount.load() << std::endl;
+    std::cout << LatencyStats::FormatHeader().C() << std::endl;
+    std::cout << mLoginStats.Format().C() << std::endl;
+    std::cout << mZoneChangeStats.Format().C() << std::endl;
+    std::cout << mSkillStats.Format().C() << std::endl;
+}
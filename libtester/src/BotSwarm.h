@@ -0,0 +1,247 @@
+/**
+ * @file libtester/src/BotSwarm.h
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Load generator multiplexing many simulated players.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBTESTER_SRC_BOTSWARM_H
+#define LIBTESTER_SRC_BOTSWARM_H
+
+// libtester Includes
+#include "ChannelClient.h"
+#include "LatencyStats.h"
+#include "LobbyClient.h"
+
+// Standard C++11 Includes
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+
+namespace libtester
+{
+
+/**
+ * Settings for a @ref BotSwarm run.
+ */
+struct BotSwarmConfig
+{
+    BotSwarmConfig();
+
+    /// Number of simulated players.
+    uint32_t botCount;
+
+    /// Threads running the shared io_service for every connection.
+    uint32_t ioThreads;
+
+    /// Threads stepping the bot behaviours.
+    uint32_t driverThreads;
+
+    /// Bots started per second during the ramp.
+    double rampRate;
+
+    /// Seconds to keep the swarm running once fully ramped.
+    uint32_t duration;
+
+    /// Milliseconds between behaviour actions for a single bot.
+    uint32_t thinkTime;
+
+    /// Milliseconds to wait for a reply before counting a failure.
+    uint32_t replyTimeout;
+
+    /// Account name prefix; bot N logs in as <prefix><N>.
+    libcomp::String usernamePrefix;
+
+    /// Password shared by every bot account.
+    libcomp::String password;
+
+    /// Relative weights for each scripted behaviour.
+    uint32_t moveWeight;
+    uint32_t chatWeight;
+    uint32_t skillWeight;
+    uint32_t zoneWeight;
+
+    /// Skill activated by the skill behaviour.
+    uint32_t skillID;
+
+    /// Zones cycled through by the zone change behaviour.
+    std::vector<uint32_t> zones;
+
+    /// Seed for the behaviour selection.
+    uint32_t seed;
+};
+
+class BotSwarm;
+
+/**
+ * Single simulated player. A bot never blocks: each call to @ref Step
+ * advances its state machine using whatever messages have arrived.
+ */
+class SwarmBot
+{
+public:
+    enum class State
+    {
+        IDLE,
+        LOBBY_ENCRYPT,
+        LOBBY_LOGIN,
+        LOBBY_AUTH,
+        LOBBY_CHARACTER_LIST,
+        LOBBY_CREATE_CHARACTER,
+        LOBBY_START_GAME,
+        CHANNEL_ENCRYPT,
+        CHANNEL_LOGIN,
+        CHANNEL_AUTH,
+        CHANNEL_SEND_DATA,
+        CHANNEL_STATE,
+        ACTIVE,
+        WAIT_SKILL,
+        WAIT_ZONE,
+        FAILED,
+        DONE,
+    };
+
+    SwarmBot(BotSwarm *pSwarm, uint32_t index, asio::io_service& service);
+    virtual ~SwarmBot();
+
+    void Start();
+    void Stop();
+
+    /**
+     * Advance the bot.
+     * @param now Current time
+     * @return true if the bot did any work
+     */
+    bool Step(const std::chrono::steady_clock::time_point& now);
+
+    State GetState() const;
+
+protected:
+    /**
+     * Run the scripted behaviour once the bot is in a zone. Override to
+     * replace the default weighted move/chat/skill/zone behaviour.
+     * @param now Current time
+     * @return true if the bot did any work
+     */
+    virtual bool StepActive(const std::chrono::steady_clock::time_point& now);
+
+    void Expect(State state, const std::chrono::steady_clock::time_point& now);
+    bool TimedOut(const std::chrono::steady_clock::time_point& now) const;
+    double Elapsed(const std::chrono::steady_clock::time_point& now,
+        const std::chrono::steady_clock::time_point& since) const;
+    void Fail(const libcomp::String& reason);
+
+    BotSwarm *mSwarm;
+    uint32_t mIndex;
+    std::shared_ptr<ChannelClient> mChannel;
+    State mState;
+
+private:
+    bool StepLobby(const std::chrono::steady_clock::time_point& now);
+    bool StepChannel(const std::chrono::steady_clock::time_point& now);
+
+    void SendLogin();
+    void SendMove(const std::chrono::steady_clock::time_point& now);
+    void SendChat();
+    void SendSkill();
+    void SendZoneChange();
+
+    libcomp::String mUsername;
+    asio::io_service& mService;
+
+    std::shared_ptr<LobbyClient> mLobby;
+
+    int32_t mSessionKey;
+    uint32_t mZoneIndex;
+    float mX, mY;
+
+    std::chrono::steady_clock::time_point mLoginStart;
+    std::chrono::steady_clock::time_point mRequestStart;
+    std::chrono::steady_clock::time_point mChannelStart;
+    std::chrono::steady_clock::time_point mNextAction;
+
+    std::mt19937 mRandom;
+};
+
+/**
+ * Load generator that multiplexes many @ref SwarmBot sessions over a small
+ * shared io_service pool and a small pool of driver threads.
+ */
+class BotSwarm
+{
+public:
+    typedef std::function<std::shared_ptr<SwarmBot>(BotSwarm*, uint32_t,
+        asio::io_service&)> BotFactory_t;
+
+    BotSwarm(const BotSwarmConfig& config,
+        const BotFactory_t& factory = BotFactory_t());
+    ~BotSwarm();
+
+    /**
+     * Ramp up every bot, run for the configured duration (or until every
+     * bot has finished) and disconnect.
+     * @return true if at least one bot reached the active state
+     */
+    bool Run();
+
+    const BotSwarmConfig& GetConfig() const;
+
+    LatencyStats& GetLoginStats();
+    LatencyStats& GetZoneChangeStats();
+    LatencyStats& GetSkillStats();
+
+    void BotActive();
+    void BotFinished();
+    void BotFailed();
+
+    /**
+     * Write the latency percentiles as CSV to stdout.
+     */
+    void Report() const;
+
+private:
+    void DriverLoop(uint32_t driver);
+
+    BotSwarmConfig mConfig;
+
+    asio::io_service mService;
+    std::unique_ptr<asio::io_service::work> mWork;
+    std::vector<std::thread> mIOThreads;
+    std::vector<std::thread> mDriverThreads;
+
+    std::vector<std::shared_ptr<SwarmBot>> mBots;
+    std::chrono::steady_clock::time_point mStartTime;
+    std::atomic<bool> mRunning;
+
+    std::atomic<uint32_t> mActiveCount;
+    std::atomic<uint32_t> mFinishedCount;
+    std::atomic<uint32_t> mFailedCount;
+
+    LatencyStats mLoginStats;
+    LatencyStats mZoneChangeStats;
+    LatencyStats mSkillStats;
+};
+
+} // namespace libtester
+
+#endif // LIBTESTER_SRC_BOTSWARM_H
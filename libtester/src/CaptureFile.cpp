@@ -0,0 +1,247 @@
+/**
+ * @file libtester/src/CaptureFile.cpp
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Reader for channel captures written by comp_logger.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CaptureFile.h"
+
+// libcomp Includes
+#include <Compress.h>
+#include <Log.h>
+#include <Packet.h>
+
+// Standard C++11 Includes
+#include <cstring>
+#include <fstream>
+
+using namespace libtester;
+
+static const uint32_t FORMAT_MAGIC = 0x4B434148; // HACK
+static const uint32_t FORMAT_VER1  = 0x00010000; // Major, Minor, Patch (1.0.0)
+static const uint32_t FORMAT_VER2  = 0x00010100; // Major, Minor, Patch (1.1.0)
+
+static const uint32_t GZIP_MAGIC = 0x677A6970; // gzip
+static const uint32_t MAX_PACKET_SIZE = 1048576;
+
+CaptureFile::CaptureFile()
+{
+}
+
+bool CaptureFile::Load(const libcomp::String& path)
+{
+    std::ifstream file(path.C(), std::ifstream::binary);
+
+    if(!file.good())
+    {
+        LogGeneralError([&]()
+        {
+            return libcomp::String("Failed to open capture: %1\n").Arg(path);
+        });
+
+        return false;
+    }
+
+    uint32_t magic = 0, ver = 0;
+
+    file.read((char*)&magic, 4);
+    file.read((char*)&ver, 4);
+
+    // Lobby captures (COMP) are not replayed.
+    if(!file.good() || FORMAT_MAGIC != magic ||
+        (FORMAT_VER1 != ver && FORMAT_VER2 != ver))
+    {
+        LogGeneralError([&]()
+        {
+            return libcomp::String("Invalid or corrupt channel capture: %1\n")
+                .Arg(path);
+        });
+
+        return false;
+    }
+
+    uint64_t stamp = 0;
+    uint32_t addrlen = 0;
+
+    file.read((char*)&stamp, FORMAT_VER1 == ver ? 4 : 8);
+    file.read((char*)&addrlen, 4);
+
+    if(!file.good() || 1024 < addrlen)
+    {
+        return false;
+    }
+
+    std::vector<char> address(addrlen);
+
+    if(addrlen)
+    {
+        file.read(&address[0], addrlen);
+        mAddress = libcomp::String(&address[0], addrlen);
+    }
+
+    mCommands.clear();
+
+    std::vector<char> packet;
+
+    while(file.peek() != std::ifstream::traits_type::eof())
+    {
+        uint8_t source = 0;
+        uint64_t micro = 0;
+        uint32_t sz = 0;
+
+        stamp = 0;
+
+        file.read((char*)&source, sizeof(source));
+
+        if(FORMAT_VER1 == ver)
+        {
+            file.read((char*)&stamp, 4);
+            micro = stamp * 1000000ULL;
+        }
+        else
+        {
+            file.read((char*)&stamp, 8);
+            file.read((char*)&micro, 8);
+        }
+
+        file.read((char*)&sz, sizeof(sz));
+
+        if(!file.good() || MAX_PACKET_SIZE < sz)
+        {
+            // Truncated capture, keep what was read so far.
+            break;
+        }
+
+        packet.resize(sz);
+
+        if(sz)
+        {
+            file.read(&packet[0], sz);
+        }
+
+        if(!file.good() || !ParsePacket(source, micro, packet))
+        {
+            break;
+        }
+    }
+
+    return !mCommands.empty();
+}
+
+bool CaptureFile::ParsePacket(uint8_t source, uint64_t micro,
+    std::vector<char>& packet)
+{
+    // Padded size, real size and the compression header.
+    if(24 > packet.size())
+    {
+        return true;
+    }
+
+    libcomp::Packet p;
+    p.WriteArray(&packet[0], (uint32_t)packet.size());
+    p.Seek(8);
+
+    std::vector<char> data;
+
+    if(GZIP_MAGIC == p.ReadU32Big())
+    {
+        int32_t uncompressedSize = p.ReadS32Little();
+        int32_t compressedSize = p.ReadS32Little();
+        (void)p.ReadU32Big(); // lv6
+
+        if(0 > compressedSize || 0 > uncompressedSize ||
+            (uint32_t)compressedSize > p.Left() ||
+            MAX_PACKET_SIZE < (uint32_t)uncompressedSize)
+        {
+            return false;
+        }
+
+        data.resize((size_t)uncompressedSize);
+
+        if(compressedSize != uncompressedSize)
+        {
+            int32_t written = libcomp::Compress::Decompress(
+                &packet[p.Tell()], &data[0], compressedSize,
+                uncompressedSize);
+
+            if(written != uncompressedSize)
+            {
+                return false;
+            }
+        }
+        else if(uncompressedSize)
+        {
+            memcpy(&data[0], &packet[p.Tell()], (size_t)uncompressedSize);
+        }
+    }
+    else
+    {
+        data.assign(packet.begin() + 24, packet.end());
+    }
+
+    if(data.empty())
+    {
+        return true;
+    }
+
+    libcomp::Packet cmds;
+    cmds.WriteArray(&data[0], (uint32_t)data.size());
+    cmds.Rewind();
+
+    while(6 <= cmds.Left())
+    {
+        cmds.Skip(2); // Big endian size
+
+        uint32_t cmdStart = cmds.Tell();
+        uint16_t cmdSize = cmds.ReadU16Little();
+
+        if(4 > cmdSize || (cmdStart + cmdSize) > (uint32_t)data.size())
+        {
+            break;
+        }
+
+        CaptureCommand cmd;
+        cmd.source = source;
+        cmd.micro = micro;
+        cmd.code = cmds.ReadU16Little();
+        cmd.data.assign(data.begin() + cmdStart + 4,
+            data.begin() + cmdStart + cmdSize);
+
+        mCommands.push_back(std::move(cmd));
+
+        cmds.Seek(cmdStart + cmdSize);
+    }
+
+    return true;
+}
+
+const std::vector<CaptureCommand>& CaptureFile::GetCommands() const
+{
+    return mCommands;
+}
+
+libcomp::String CaptureFile::GetAddress() const
+{
+    return mAddress;
+}
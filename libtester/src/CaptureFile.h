@@ -0,0 +1,81 @@
+/**
+ * @file libtester/src/CaptureFile.h
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Reader for channel captures written by comp_logger.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBTESTER_SRC_CAPTUREFILE_H
+#define LIBTESTER_SRC_CAPTUREFILE_H
+
+// libcomp Includes
+#include <CString.h>
+
+// Standard C++11 Includes
+#include <vector>
+
+namespace libtester
+{
+
+/**
+ * Single command decoded from a capture.
+ */
+struct CaptureCommand
+{
+    /// 0 if the command came from the client, 1 if from the server.
+    uint8_t source;
+
+    /// Capture time in microseconds.
+    uint64_t micro;
+
+    /// Command code.
+    uint16_t code;
+
+    /// Command data without the size and code.
+    std::vector<char> data;
+};
+
+/**
+ * Channel capture file as written by the logger and read by capgrep.
+ * Every packet is split into the individual commands it carries.
+ */
+class CaptureFile
+{
+public:
+    CaptureFile();
+
+    bool Load(const libcomp::String& path);
+
+    const std::vector<CaptureCommand>& GetCommands() const;
+    libcomp::String GetAddress() const;
+
+private:
+    bool ParsePacket(uint8_t source, uint64_t micro,
+        std::vector<char>& packet);
+
+    libcomp::String mAddress;
+    std::vector<CaptureCommand> mCommands;
+};
+
+} // namespace libtester
+
+#endif // LIBTESTER_SRC_CAPTUREFILE_H
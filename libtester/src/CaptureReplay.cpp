@@ -0,0 +1,394 @@
+/**
+ * @file libtester/src/CaptureReplay.cpp
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Replays a channel capture against a local server.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CaptureReplay.h"
+
+// libcomp Includes
+#include <Log.h>
+#include <PacketCodes.h>
+
+// Standard C++11 Includes
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+using namespace libtester;
+
+ReplayBot::ReplayBot(CaptureReplay *pReplay, BotSwarm *pSwarm,
+    uint32_t index, asio::io_service& service) :
+    SwarmBot(pSwarm, index, service), mReplay(pReplay), mNext(0),
+    mStarted(false)
+{
+}
+
+ReplayBot::~ReplayBot()
+{
+}
+
+void ReplayBot::Rewrite(const ReplayCommand& cmd,
+    std::vector<char>& data) const
+{
+    auto offsets = CaptureReplay::GetRewriteOffsets(cmd.code);
+
+    if(!offsets)
+    {
+        return;
+    }
+
+    auto& partnerIDs = mReplay->GetOriginalPartnerIDs();
+
+    for(uint32_t offset : *offsets)
+    {
+        if((offset + sizeof(int32_t)) > data.size())
+        {
+            continue;
+        }
+
+        // Captures and the server are both little endian.
+        int32_t value;
+        memcpy(&value, &data[offset], sizeof(value));
+
+        int32_t replacement = value;
+
+        if(-1 == value)
+        {
+            continue;
+        }
+        else if(value == mReplay->GetOriginalEntityID())
+        {
+            replacement = mChannel->GetEntityID();
+        }
+        else if(partnerIDs.find(value) != partnerIDs.end() &&
+            -1 != mChannel->GetPartnerEntityID())
+        {
+            replacement = mChannel->GetPartnerEntityID();
+        }
+        else if(value == mReplay->GetOriginalWorldCID() &&
+            -1 != mChannel->GetWorldCID())
+        {
+            replacement = mChannel->GetWorldCID();
+        }
+
+        memcpy(&data[offset], &replacement, sizeof(replacement));
+    }
+}
+
+bool ReplayBot::StepActive(const std::chrono::steady_clock::time_point& now)
+{
+    bool failed = false;
+    uint16_t code = 0;
+    libcomp::ReadOnlyPacket reply;
+
+    // Process (and learn IDs from) everything the server sent.
+    mChannel->PollForPacket({}, reply, code, failed);
+
+    if(failed)
+    {
+        Fail("disconnected during replay");
+        return true;
+    }
+
+    if(!mStarted)
+    {
+        mStarted = true;
+        mReplayStart = now;
+    }
+
+    auto& commands = mReplay->GetCommands();
+    double speed = mReplay->GetSpeed();
+    double elapsed = Elapsed(now, mReplayStart) * 1000.0; // microseconds
+    bool didWork = false;
+
+    while(mNext < commands.size())
+    {
+        auto& cmd = commands[mNext];
+        double due = 0.0 < speed ? (double)cmd.offset / speed : 0.0;
+
+        if(due > elapsed)
+        {
+            break;
+        }
+
+        std::vector<char> data = cmd.data;
+        Rewrite(cmd, data);
+
+        libcomp::Packet p;
+        p.WriteU16Little(cmd.code);
+
+        if(!data.empty())
+        {
+            p.WriteArray(&data[0], (uint32_t)data.size());
+        }
+
+        mChannel->GetConnection()->SendPacket(p);
+        mReplay->CommandSent(data.size() + 2, (elapsed - due) / 1000.0);
+
+        mNext++;
+        didWork = true;
+    }
+
+    if(mNext >= commands.size())
+    {
+        mReplay->GetCompletionStats().Record(Elapsed(now, mReplayStart));
+        mSwarm->BotFinished();
+
+        Stop();
+
+        return true;
+    }
+
+    return didWork;
+}
+
+CaptureReplay::CaptureReplay(const CaptureFile& capture, double speed) :
+    mSpeed(speed), mOriginalEntityID(-1), mOriginalWorldCID(-1),
+    mCommandsSent(0), mBytesSent(0), mRunTime(0.0),
+    mCompletionStats("replay_complete"), mLagStats("send_lag")
+{
+    // These are replaced by the fresh login every virtual client does.
+    static const std::set<uint16_t> skipCodes = {
+        to_underlying(ClientToChannelPacketCode_t::PACKET_LOGIN),
+        to_underlying(ClientToChannelPacketCode_t::PACKET_AUTH),
+        to_underlying(ClientToChannelPacketCode_t::PACKET_SEND_DATA),
+        to_underlying(ClientToChannelPacketCode_t::PACKET_STATE),
+        to_underlying(ClientToChannelPacketCode_t::PACKET_LOGOUT),
+    };
+
+    auto& commands = capture.GetCommands();
+
+    // The login sends the first populate so start replaying after it.
+    size_t start = 0;
+
+    for(size_t i = 0; i < commands.size(); i++)
+    {
+        if(0 == commands[i].source && commands[i].code == to_underlying(
+            ClientToChannelPacketCode_t::PACKET_POPULATE_ZONE))
+        {
+            start = i + 1;
+            break;
+        }
+    }
+
+    uint64_t firstMicro = 0;
+    bool haveFirst = false;
+
+    for(size_t i = 0; i < commands.size(); i++)
+    {
+        auto& cmd = commands[i];
+
+        if(1 == cmd.source)
+        {
+            // Learn the IDs the recorded client was given.
+            libcomp::Packet p;
+
+            if(!cmd.data.empty())
+            {
+                p.WriteArray(&cmd.data[0], (uint32_t)cmd.data.size());
+                p.Rewind();
+            }
+
+            if(cmd.code == to_underlying(
+                ChannelToClientPacketCode_t::PACKET_CHARACTER_DATA) &&
+                4 <= p.Size() && -1 == mOriginalEntityID)
+            {
+                mOriginalEntityID = p.ReadS32Little();
+            }
+            else if(cmd.code == to_underlying(
+                ChannelToClientPacketCode_t::PACKET_PARTNER_DATA) &&
+                4 <= p.Size())
+            {
+                mOriginalPartnerIDs.insert(p.ReadS32Little());
+            }
+            else if(cmd.code == to_underlying(
+                ChannelToClientPacketCode_t::PACKET_FRIEND_INFO_SELF) &&
+                2 <= p.Size() && -1 == mOriginalWorldCID)
+            {
+                (void)p.ReadString16Little(libcomp::Convert::ENCODING_CP932,
+                    true);
+
+                if(4 <= p.Left())
+                {
+                    mOriginalWorldCID = (int32_t)p.ReadU32Little();
+                }
+            }
+
+            continue;
+        }
+
+        if(i < start || skipCodes.find(cmd.code) != skipCodes.end())
+        {
+            continue;
+        }
+
+        if(!haveFirst)
+        {
+            firstMicro = cmd.micro;
+            haveFirst = true;
+        }
+
+        ReplayCommand replay;
+        replay.offset = cmd.micro >= firstMicro ? cmd.micro - firstMicro : 0;
+        replay.code = cmd.code;
+        replay.data = cmd.data;
+
+        mCommands.push_back(std::move(replay));
+    }
+}
+
+const std::vector<uint32_t>* CaptureReplay::GetRewriteOffsets(uint16_t code)
+{
+    static const std::unordered_map<uint16_t, std::vector<uint32_t>> rules = {
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_POPULATE_ZONE),
+            { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_MOVE), { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_PIVOT), { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_ROTATE), { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_STOP_MOVEMENT),
+            { 0 } },
+        { to_underlying(
+            ClientToChannelPacketCode_t::PACKET_FIX_OBJECT_POSITION), { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_SPOT_TRIGGERED),
+            { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_SKILL_ACTIVATE),
+            { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_SKILL_EXECUTE),
+            { 0, 5 } },
+        { to_underlying(
+            ClientToChannelPacketCode_t::PACKET_SKILL_EXECUTE_INSTANT),
+            { 0, 8 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_SKILL_CANCEL),
+            { 0 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_SKILL_TARGET),
+            { 0, 4 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_PARTY_KICK),
+            { 0, 4 } },
+        { to_underlying(ClientToChannelPacketCode_t::PACKET_CLAN_KICK),
+            { 4 } },
+    };
+
+    auto it = rules.find(code);
+
+    return it != rules.end() ? &it->second : nullptr;
+}
+
+bool CaptureReplay::Run(const BotSwarmConfig& config)
+{
+    if(mCommands.empty())
+    {
+        LogGeneralError([&]()
+        {
+            return libcomp::String("Capture has no client commands to"
+                " replay.\n");
+        });
+
+        return false;
+    }
+
+    LogGeneralInfo([&]()
+    {
+        return libcomp::String("Replaying %1 commands (entity %2, world CID"
+            " %3) on %4 clients\n").Arg((uint64_t)mCommands.size())
+            .Arg(mOriginalEntityID).Arg(mOriginalWorldCID)
+            .Arg(config.botCount);
+    });
+
+    mSwarm.reset(new BotSwarm(config, [this](BotSwarm *pSwarm,
+        uint32_t index, asio::io_service& service)
+    {
+        return std::make_shared<ReplayBot>(this, pSwarm, index, service);
+    }));
+
+    auto start = std::chrono::steady_clock::now();
+    bool result = mSwarm->Run();
+    std::chrono::duration<double> runTime = std::chrono::steady_clock::now() -
+        start;
+
+    mRunTime = runTime.count();
+
+    return result && 0 < mCompletionStats.Summarize().count;
+}
+
+void CaptureReplay::Report() const
+{
+    if(mSwarm)
+    {
+        mSwarm->Report();
+    }
+
+    double seconds = 0.0 < mRunTime ? mRunTime : 1.0;
+
+    std::cout << LatencyStats::FormatHeader().C() << std::endl;
+    std::cout << mCompletionStats.Format().C() << std::endl;
+    std::cout << mLagStats.Format().C() << std::endl;
+    std::cout << "commands_sent," << mCommandsSent.load() << std::endl;
+    std::cout << "bytes_sent," << mBytesSent.load() << std::endl;
+    std::cout << "commands_per_sec," << ((double)mCommandsSent.load() /
+        seconds) << std::endl;
+    std::cout << "bytes_per_sec," << ((double)mBytesSent.load() /
+        seconds) << std::endl;
+}
+
+const std::vector<ReplayCommand>& CaptureReplay::GetCommands() const
+{
+    return mCommands;
+}
+
+double CaptureReplay::GetSpeed() const
+{
+    return mSpeed;
+}
+
+int32_t CaptureReplay::GetOriginalEntityID() const
+{
+    return mOriginalEntityID;
+}
+
+const std::set<int32_t>& CaptureReplay::GetOriginalPartnerIDs() const
+{
+    return mOriginalPartnerIDs;
+}
+
+int32_t CaptureReplay::GetOriginalWorldCID() const
+{
+    return mOriginalWorldCID;
+}
+
+void CaptureReplay::CommandSent(size_t bytes, double lag)
+{
+    mCommandsSent++;
+    mBytesSent += (uint64_t)bytes;
+
+    if(0.0 < mSpeed)
+    {
+        mLagStats.Record(lag);
+    }
+}
+
+LatencyStats& CaptureReplay::GetCompletionStats()
+{
+    return mCompletionStats;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file libtester/src/CaptureReplay.h
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Replays a channel capture against a local server.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBTESTER_SRC_CAPTUREREPLAY_H
+#define LIBTESTER_SRC_CAPTUREREPLAY_H
+
+// libtester Includes
+#include "BotSwarm.h"
+#include "CaptureFile.h"
+
+// Standard C++11 Includes
+#include <set>
+
+namespace libtester
+{
+
+class CaptureReplay;
+
+/**
+ * Client command from a capture scheduled for replay.
+ */
+struct ReplayCommand
+{
+    /// Microseconds after the first replayed command.
+    uint64_t offset;
+
+    /// Command code.
+    uint16_t code;
+
+    /// Command data without the size and code.
+    std::vector<char> data;
+};
+
+/**
+ * Virtual client that logs in like a @ref SwarmBot and then re-drives the
+ * client to channel stream of a capture.
+ */
+class ReplayBot : public SwarmBot
+{
+public:
+    ReplayBot(CaptureReplay *pReplay, BotSwarm *pSwarm, uint32_t index,
+        asio::io_service& service);
+    virtual ~ReplayBot();
+
+protected:
+    virtual bool StepActive(const std::chrono::steady_clock::time_point& now);
+
+private:
+    void Rewrite(const ReplayCommand& cmd, std::vector<char>& data) const;
+
+    CaptureReplay *mReplay;
+    size_t mNext;
+    bool mStarted;
+    std::chrono::steady_clock::time_point mReplayStart;
+};
+
+/**
+ * Replay engine for a capture recorded by the logger. The client commands
+ * are extracted once and shared by every virtual client. Entity IDs, the
+ * partner entity ID and the world CID seen in the capture are rewritten
+ * to the values of each virtual client; session keys come from a fresh
+ * lobby login.
+ */
+class CaptureReplay
+{
+public:
+    /**
+     * @param capture Loaded capture
+     * @param speed Time scale, 1 replays in real time, 10 ten times as
+     *  fast and 0 sends every command as fast as possible
+     */
+    CaptureReplay(const CaptureFile& capture, double speed);
+
+    /**
+     * Run the capture on every bot of the swarm.
+     * @param config Swarm settings; botCount is the fan-out
+     * @return true if at least one client finished the capture
+     */
+    bool Run(const BotSwarmConfig& config);
+
+    void Report() const;
+
+    const std::vector<ReplayCommand>& GetCommands() const;
+    double GetSpeed() const;
+
+    int32_t GetOriginalEntityID() const;
+    const std::set<int32_t>& GetOriginalPartnerIDs() const;
+    int32_t GetOriginalWorldCID() const;
+
+    /**
+     * Offsets of 32-bit fields in a command that may hold an entity ID or
+     * world CID of the recorded character.
+     */
+    static const std::vector<uint32_t>* GetRewriteOffsets(uint16_t code);
+
+    void CommandSent(size_t bytes, double lag);
+    LatencyStats& GetCompletionStats();
+
+private:
+    std::vector<ReplayCommand> mCommands;
+    double mSpeed;
+
+    int32_t mOriginalEntityID;
+    std::set<int32_t> mOriginalPartnerIDs;
+    int32_t mOriginalWorldCID;
+
+    std::atomic<uint64_t> mCommandsSent;
+    std::atomic<uint64_t> mBytesSent;
+    double mRunTime;
+
+    LatencyStats mCompletionStats;
+    LatencyStats mLagStats;
+    std::unique_ptr<BotSwarm> mSwarm;
+};
+
+} // namespace libtester
+
+#endif // LIBTESTER_SRC_CAPTUREREPLAY_H
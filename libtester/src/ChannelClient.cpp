@@ -47,7 +47,23 @@
 using namespace libtester;
 
 ChannelClient::ChannelClient() : TestClient(), mEntityID(-1),
-    mPartnerEntityID(-1), mZoneID(-1), mActivationID(-1), mAccountDumpParts(0),
+    mPartnerEntityID(-1), mZoneID(-1), mWorldCID(-1), mActivationID(-1),
+    mAccountDumpParts(0), mLastAccountDumpPart(0)
+{
+    mCharacter = std::make_shared<objects::Character>();
+    mCharacter->SetCoreStats(std::make_shared<objects::EntityStats>());
+
+    for(int i = 0; i < 10; ++i)
+    {
+        mDemonIDs[i] = -1;
+    }
+
+    SetConnection(std::make_shared<libcomp::ChannelConnection>(mService));
+}
+
+ChannelClient::ChannelClient(asio::io_service& service) :
+    TestClient(service), mEntityID(-1), mPartnerEntityID(-1), mZoneID(-1),
+    mWorldCID(-1), mActivationID(-1), mAccountDumpParts(0),
     mLastAccountDumpPart(0)
 {
     mCharacter = std::make_shared<objects::Character>();
@@ -373,6 +389,12 @@ void ChannelClient::HandlePacket(ChannelToClientPacketCode_t cmd,
         case ChannelToClientPacketCode_t::PACKET_DEMON_BOX_DATA:
             HandleDemonBoxData(p);
             break;
+        case ChannelToClientPacketCode_t::PACKET_PARTNER_DATA:
+            HandlePartnerData(p);
+            break;
+        case ChannelToClientPacketCode_t::PACKET_FRIEND_INFO_SELF:
+            HandleFriendInfoSelf(p);
+            break;
 
         case ChannelToClientPacketCode_t::PACKET_AMALA_SERVER_VERSION:
             HandleAmalaServerVersion(p);
@@ -394,6 +416,21 @@ int32_t ChannelClient::GetEntityID() const
     return mEntityID;
 }
 
+int32_t ChannelClient::GetZoneID() const
+{
+    return mZoneID;
+}
+
+int32_t ChannelClient::GetPartnerEntityID() const
+{
+    return mPartnerEntityID;
+}
+
+int32_t ChannelClient::GetWorldCID() const
+{
+    return mWorldCID;
+}
+
 int8_t ChannelClient::GetActivationID() const
 {
     return mActivationID;
@@ -430,6 +467,7 @@ namespace libcomp
             binding.Func("AmalaRequestAccountDump",
                 &ChannelClient::AmalaRequestAccountDump);
             binding.Func("GetEntityID", &ChannelClient::GetEntityID);
+            binding.Func("GetZoneID", &ChannelClient::GetZoneID);
             binding.Func("GetActivationID", &ChannelClient::GetActivationID);
             binding.Func("GetDemonID", &ChannelClient::GetDemonID);
             binding.Func("ContractDemon", &ChannelClient::ContractDemon);
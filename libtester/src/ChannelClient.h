@@ -46,6 +46,7 @@ class ChannelClient : public TestClient
 {
 public:
     ChannelClient();
+    ChannelClient(asio::io_service& service);
     ChannelClient(const ChannelClient& other);
     virtual ~ChannelClient();
 
@@ -77,6 +78,9 @@ public:
     bool EventResponse(int32_t option);
 
     int32_t GetEntityID() const;
+    int32_t GetZoneID() const;
+    int32_t GetPartnerEntityID() const;
+    int32_t GetWorldCID() const;
     int8_t GetActivationID() const;
     int64_t GetDemonID(int8_t slot) const;
 
@@ -88,6 +92,8 @@ private:
     void HandleCharacterData(libcomp::ReadOnlyPacket& p);
     void HandleDemonBoxData(libcomp::ReadOnlyPacket& p);
     void HandleZoneChange(libcomp::ReadOnlyPacket& p);
+    void HandlePartnerData(libcomp::ReadOnlyPacket& p);
+    void HandleFriendInfoSelf(libcomp::ReadOnlyPacket& p);
 
     void HandleAmalaServerVersion(libcomp::ReadOnlyPacket& p);
     void HandleAmalaAccountDumpHeader(libcomp::ReadOnlyPacket& p);
@@ -96,6 +102,7 @@ private:
     int32_t mEntityID;
     int32_t mPartnerEntityID;
     int32_t mZoneID;
+    int32_t mWorldCID;
     int8_t mActivationID;
     int64_t mDemonIDs[10];
 
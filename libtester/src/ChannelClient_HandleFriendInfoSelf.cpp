@@ -0,0 +1,9 @@
+#include "ChannelClient.h"
+
+using namespace libtester;
+
+void ChannelClient::HandleFriendInfoSelf(libcomp::ReadOnlyPacket& p)
+{
+    (void)p.ReadString16Little(libcomp::Convert::ENCODING_CP932, true);
+    mWorldCID = (int32_t)p.ReadU32Little();
+}
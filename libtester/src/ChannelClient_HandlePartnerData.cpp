@@ -0,0 +1,8 @@
+#include "ChannelClient.h"
+
+using namespace libtester;
+
+void ChannelClient::HandlePartnerData(libcomp::ReadOnlyPacket& p)
+{
+    mPartnerEntityID = p.ReadS32Little();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file libtester/src/LatencyStats.cpp
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Thread-safe latency sample collection and percentiles.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LatencyStats.h"
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <cmath>
+
+using namespace libtester;
+
+LatencyStats::LatencyStats(const libcomp::String& name) : mName(name),
+    mFailures(0)
+{
+}
+
+void LatencyStats::Record(double ms)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mSamples.push_back(ms);
+}
+
+void LatencyStats::RecordFailure()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mFailures++;
+}
+
+libcomp::String LatencyStats::GetName() const
+{
+    return mName;
+}
+
+LatencyStats::Summary LatencyStats::Summarize() const
+{
+    std::vector<double> samples;
+    Summary summary = { 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        samples = mSamples;
+        summary.failures = mFailures;
+    }
+
+    summary.count = samples.size();
+
+    if(samples.empty())
+    {
+        return summary;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest-rank percentile.
+    auto percentile = [&samples](double pct)
+    {
+        size_t rank = (size_t)std::ceil(pct / 100.0 *
+            (double)samples.size());
+
+        return samples[rank > 0 ? rank - 1 : 0];
+    };
+
+    double total = 0.0;
+
+    for(double sample : samples)
+    {
+        total += sample;
+    }
+
+    summary.min = samples.front();
+    summary.mean = total / (double)samples.size();
+    summary.p50 = percentile(50.0);
+    summary.p90 = percentile(90.0);
+    summary.p95 = percentile(95.0);
+    summary.p99 = percentile(99.0);
+    summary.max = samples.back();
+
+    return summary;
+}
+
+libcomp::String LatencyStats::FormatHeader()
+{
+    return "operation,count,failures,min_ms,mean_ms,p50_ms,p90_ms,p95_ms,"
+        "p99_ms,max_ms";
+}
+
+libcomp::String LatencyStats::Format() const
+{
+    auto s = Summarize();
+
+    return libcomp::String("%1,%2,%3,%4,%5,").Arg(mName)
+        .Arg((uint64_t)s.count).Arg((uint64_t)s.failures).Arg(s.min)
+        .Arg(s.mean) + libcomp::String("%1,%2,%3,%4,%5").Arg(s.p50)
+        .Arg(s.p90).Arg(s.p95).Arg(s.p99).Arg(s.max);
+}
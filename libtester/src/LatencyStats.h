@@ -0,0 +1,83 @@
+/**
+ * @file libtester/src/LatencyStats.h
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Thread-safe latency sample collection and percentiles.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBTESTER_SRC_LATENCYSTATS_H
+#define LIBTESTER_SRC_LATENCYSTATS_H
+
+// libcomp Includes
+#include <CString.h>
+
+// Standard C++11 Includes
+#include <mutex>
+#include <vector>
+
+namespace libtester
+{
+
+/**
+ * Collection of round trip times (in milliseconds) for a single operation
+ * type. Samples may be recorded from any thread.
+ */
+class LatencyStats
+{
+public:
+    /**
+     * Snapshot of the collected samples.
+     */
+    struct Summary
+    {
+        size_t count;
+        size_t failures;
+        double min;
+        double mean;
+        double p50;
+        double p90;
+        double p95;
+        double p99;
+        double max;
+    };
+
+    LatencyStats(const libcomp::String& name);
+
+    void Record(double ms);
+    void RecordFailure();
+
+    libcomp::String GetName() const;
+    Summary Summarize() const;
+
+    static libcomp::String FormatHeader();
+    libcomp::String Format() const;
+
+private:
+    libcomp::String mName;
+    size_t mFailures;
+    std::vector<double> mSamples;
+    mutable std::mutex mLock;
+};
+
+} // namespace libtester
+
+#endif // LIBTESTER_SRC_LATENCYSTATS_H
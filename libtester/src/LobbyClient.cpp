@@ -57,6 +57,13 @@ LobbyClient::LobbyClient() : TestClient(), mSessionKey(-1),
     SetConnection(std::make_shared<libcomp::LobbyConnection>(mService));
 }
 
+LobbyClient::LobbyClient(asio::io_service& service) : TestClient(service),
+    mSessionKey(-1), mWaitForLogout(false), mLoginTime(0), mTicketCount(0),
+    mTicketCost(0), mCP(0)
+{
+    SetConnection(std::make_shared<libcomp::LobbyConnection>(mService));
+}
+
 LobbyClient::LobbyClient(const LobbyClient& other) : TestClient(other)
 {
     (void)other;
@@ -65,6 +65,7 @@ public:
     };
 
     LobbyClient();
+    LobbyClient(asio::io_service& service);
     LobbyClient(const LobbyClient& other);
     virtual ~LobbyClient();
 
@@ -42,13 +42,22 @@ using namespace libtester;
 
 constexpr asio::steady_timer::duration TestClient::DEFAULT_TIMEOUT;
 
-TestClient::TestClient() : mTimer(mService), mMessageQueue(
+TestClient::TestClient() : mOwnedService(new asio::io_service),
+    mService(*mOwnedService), mTimer(mService), mMessageQueue(
     new libcomp::MessageQueue<libcomp::Message::Message*>())
 {
 }
 
-TestClient::TestClient(const TestClient& other) : mTimer(mService),
-    mMessageQueue(new libcomp::MessageQueue<libcomp::Message::Message*>())
+TestClient::TestClient(asio::io_service& service) : mService(service),
+    mTimer(mService), mMessageQueue(
+    new libcomp::MessageQueue<libcomp::Message::Message*>())
+{
+}
+
+TestClient::TestClient(const TestClient& other) :
+    mOwnedService(new asio::io_service), mService(*mOwnedService),
+    mTimer(mService), mMessageQueue(
+    new libcomp::MessageQueue<libcomp::Message::Message*>())
 {
     (void)other;
 
@@ -57,11 +66,21 @@ TestClient::TestClient(const TestClient& other) : mTimer(mService),
 
 TestClient::~TestClient()
 {
-    mService.stop();
+    if(mOwnedService)
+    {
+        mService.stop();
 
-    if(mServiceThread.joinable())
+        if(mServiceThread.joinable())
+        {
+            mServiceThread.join();
+        }
+    }
+    else if(mConnection)
     {
-        mServiceThread.join();
+        // The service belongs to someone else so just make sure the
+        // connection is not left running on it.
+        mTimer.cancel();
+        mConnection->Close();
     }
 
     ClearMessages();
@@ -79,10 +98,14 @@ bool TestClient::Connect(uint16_t port)
 
     bool result = mConnection->Connect("127.0.0.1", port);
 
-    mServiceThread = std::thread([&]()
+    // A shared service is run by the owner (see BotSwarm).
+    if(mOwnedService)
     {
-        mService.run();
-    });
+        mServiceThread = std::thread([&]()
+        {
+            mService.run();
+        });
+    }
 
     return result;
 }
@@ -97,6 +120,11 @@ std::shared_ptr<libcomp::EncryptedConnection> TestClient::GetConnection()
     return mConnection;
 }
 
+bool TestClient::UsesSharedService() const
+{
+    return !mOwnedService;
+}
+
 bool TestClient::HasDisconnectOrTimeout()
 {
     for(auto msg : mReceivedMessages)
@@ -277,6 +305,80 @@ bool TestClient::WaitForMessage(std::function<WaitStatus(
     return result;
 }
 
+void TestClient::PollMessages()
+{
+    std::list<libcomp::Message::Message*> msgs;
+    mMessageQueue->DequeueAny(msgs);
+    mReceivedMessages.splice(mReceivedMessages.end(), msgs);
+}
+
+bool TestClient::PollEncrypted(bool& failed)
+{
+    PollMessages();
+
+    failed = HasDisconnectOrTimeout();
+
+    for(auto it = mReceivedMessages.begin(); it != mReceivedMessages.end();
+        it++)
+    {
+        if(nullptr != dynamic_cast<libcomp::Message::Encrypted*>(*it))
+        {
+            delete *it;
+            mReceivedMessages.erase(it);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TestClient::PollForPacket(const std::set<uint16_t>& codes,
+    libcomp::ReadOnlyPacket& p, uint16_t& code, bool& failed)
+{
+    // Non-blocking version of WaitForPacket for callers that multiplex
+    // many clients on a few threads.
+    PollMessages();
+
+    failed = HasDisconnectOrTimeout();
+
+    bool foundPacket = false;
+
+    for(auto it = mReceivedMessages.begin(); it != mReceivedMessages.end();)
+    {
+        auto pmsg = dynamic_cast<libcomp::Message::Packet*>(*it);
+
+        if(nullptr == pmsg)
+        {
+            it++;
+            continue;
+        }
+
+        auto cmdCode = pmsg->GetCommandCode();
+        libcomp::ReadOnlyPacket copy(pmsg->GetPacket());
+
+        HandlePacket(static_cast<ChannelToClientPacketCode_t>(
+            cmdCode), copy);
+
+        if(codes.find(cmdCode) != codes.end())
+        {
+            foundPacket = true;
+            code = cmdCode;
+            p = libcomp::ReadOnlyPacket(pmsg->GetPacket());
+        }
+
+        delete pmsg;
+        it = mReceivedMessages.erase(it);
+
+        if(foundPacket)
+        {
+            break;
+        }
+    }
+
+    return foundPacket;
+}
+
 std::list<libcomp::Message::Message*> TestClient::TakeMessages()
 {
     return std::move(mReceivedMessages);
@@ -34,6 +34,8 @@
 
 // Standard C++11 Includes
 #include <functional>
+#include <memory>
+#include <set>
 #include <thread>
 
 namespace libtester
@@ -55,6 +57,7 @@ public:
     };
 
     TestClient();
+    TestClient(asio::io_service& service);
     TestClient(const TestClient& other);
     virtual ~TestClient();
 
@@ -78,17 +81,25 @@ public:
     MessageList TakeMessages();
     void ClearMessages();
 
+    bool PollEncrypted(bool& failed);
+    bool PollForPacket(const std::set<uint16_t>& codes,
+        libcomp::ReadOnlyPacket& p, uint16_t& code, bool& failed);
+
+    bool UsesSharedService() const;
+
     std::shared_ptr<libcomp::EncryptedConnection> GetConnection();
 
 protected:
     void SetConnection(const std::shared_ptr<
         libcomp::EncryptedConnection>& conn);
     bool HasDisconnectOrTimeout();
+    void PollMessages();
 
     virtual void HandlePacket(ChannelToClientPacketCode_t cmd,
         libcomp::ReadOnlyPacket& p);
 
-    asio::io_service mService;
+    std::unique_ptr<asio::io_service> mOwnedService;
+    asio::io_service& mService;
     std::thread mServiceThread;
     asio::steady_timer mTimer;
 
@@ -0,0 +1,235 @@
+/**
+ * @file libtester/swarm/main.cpp
+ * @ingroup libtester
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Headless load generator for a local lobby/world/channel stack.
+ *
+ * This file is part of the COMP_hack Tester Library (libtester).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// libtester Includes
+#include <BotSwarm.h>
+
+// libcomp Includes
+#include <Log.h>
+
+// Standard C++11 Includes
+#include <fstream>
+#include <iostream>
+
+static void Usage()
+{
+    std::cerr << "SYNTAX: comp_swarm [options]" << std::endl
+        << "  --bots N          number of simulated players" << std::endl
+        << "  --io-threads N    threads running the network service"
+        << std::endl
+        << "  --drivers N       threads stepping bot behaviour" << std::endl
+        << "  --ramp RATE       bots started per second" << std::endl
+        << "  --duration SEC    run time once fully ramped" << std::endl
+        << "  --think MS        time between bot actions" << std::endl
+        << "  --timeout MS      reply timeout" << std::endl
+        << "  --prefix NAME     account name prefix" << std::endl
+        << "  --password PASS   account password" << std::endl
+        << "  --weights M,C,S,Z move/chat/skill/zone weights" << std::endl
+        << "  --skill ID        skill used by the skill behaviour"
+        << std::endl
+        << "  --zones A,B,...   zones cycled by the zone behaviour"
+        << std::endl
+        << "  --seed N          behaviour random seed" << std::endl
+        << "  --gen-setup FILE  write a lobby setup file with the bot"
+        " accounts and exit" << std::endl;
+}
+
+static bool WriteSetup(const libtester::BotSwarmConfig& config,
+    const libcomp::String& path)
+{
+    std::ofstream out(path.C());
+
+    if(!out.good())
+    {
+        return false;
+    }
+
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    out << "<objgen>" << std::endl;
+
+    for(uint32_t i = 0; i < config.botCount; i++)
+    {
+        // Bots need GM access to change zones with @zone.
+        out << "    <object name=\"Account\">" << std::endl
+            << "        <member name=\"Username\">"
+            << config.usernamePrefix.C() << i << "</member>" << std::endl
+            << "        <member name=\"DisplayName\">Swarm Bot " << i
+            << "</member>" << std::endl
+            << "        <member name=\"Email\">" << config.usernamePrefix.C()
+            << i << "@swarm.test</member>" << std::endl
+            << "        <member name=\"Password\">" << config.password.C()
+            << "</member>" << std::endl
+            << "        <member name=\"CP\">1000000</member>" << std::endl
+            << "        <member name=\"TicketCount\">1</member>" << std::endl
+            << "        <member name=\"UserLevel\">1000</member>"
+            << std::endl
+            << "        <member name=\"Enabled\">true</member>" << std::endl
+            << "    </object>" << std::endl;
+    }
+
+    out << "</objgen>" << std::endl;
+
+    return out.good();
+}
+
+int main(int argc, char *argv[])
+{
+    libtester::BotSwarmConfig config;
+    libcomp::String setupPath;
+
+    for(int i = 1; i < argc; i++)
+    {
+        libcomp::String arg = argv[i];
+
+        if(arg == "--help")
+        {
+            Usage();
+
+            return 0;
+        }
+        else if((i + 1) >= argc)
+        {
+            Usage();
+
+            return -1;
+        }
+
+        libcomp::String value = argv[++i];
+        bool ok = true;
+
+        if(arg == "--bots")
+        {
+            config.botCount = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--io-threads")
+        {
+            config.ioThreads = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--drivers")
+        {
+            config.driverThreads = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--ramp")
+        {
+            config.rampRate = value.ToDecimal<double>(&ok);
+        }
+        else if(arg == "--duration")
+        {
+            config.duration = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--think")
+        {
+            config.thinkTime = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--timeout")
+        {
+            config.replyTimeout = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--prefix")
+        {
+            config.usernamePrefix = value;
+        }
+        else if(arg == "--password")
+        {
+            config.password = value;
+        }
+        else if(arg == "--weights")
+        {
+            auto weights = value.Split(",");
+            ok = 4 == weights.size();
+
+            uint32_t *targets[] = { &config.moveWeight, &config.chatWeight,
+                &config.skillWeight, &config.zoneWeight };
+            size_t idx = 0;
+
+            for(auto it = weights.begin(); ok && it != weights.end(); it++)
+            {
+                *targets[idx++] = it->ToInteger<uint32_t>(&ok);
+            }
+        }
+        else if(arg == "--skill")
+        {
+            config.skillID = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--zones")
+        {
+            config.zones.clear();
+
+            for(auto zone : value.Split(","))
+            {
+                config.zones.push_back(zone.ToInteger<uint32_t>(&ok));
+
+                if(!ok)
+                {
+                    break;
+                }
+            }
+        }
+        else if(arg == "--seed")
+        {
+            config.seed = value.ToInteger<uint32_t>(&ok);
+        }
+        else if(arg == "--gen-setup")
+        {
+            setupPath = value;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if(!ok)
+        {
+            std::cerr << "Bad value for " << arg.C() << ": "
+                << value.C() << std::endl;
+            Usage();
+
+            return -1;
+        }
+    }
+
+    if(!setupPath.IsEmpty())
+    {
+        if(!WriteSetup(config, setupPath))
+        {
+            std::cerr << "Failed to write " << setupPath.C() << std::endl;
+
+            return -1;
+        }
+
+        return 0;
+    }
+
+    libcomp::Log::GetSingletonPtr()->AddStandardOutputHook();
+
+    libtester::BotSwarm swarm(config);
+
+    bool result = swarm.Run();
+    swarm.Report();
+
+    return result ? 0 : -1;
+}
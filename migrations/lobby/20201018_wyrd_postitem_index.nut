@@ -0,0 +1,22 @@
+import("server");
+
+function up(db, server)
+{
+    // Post items are listed per account by timestamp then type
+    print("Adding post item listing index.");
+
+    if(!db.Execute("CREATE INDEX IF NOT EXISTS " +
+        "idx_PostItem_Account_Timestamp_Type " +
+        "ON PostItem (Account, Timestamp, Type);"))
+    {
+        print("ERROR: Post item index creation failed");
+        return false;
+    }
+
+    return true;
+}
+
+function down(db)
+{
+    return true;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file server/channel/bench/AccountBench.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Benchmarks for account manager serialization.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// Standard C++11 Includes
+#include <list>
+
+// object Includes
+#include <Item.h>
+
+// channel Includes
+#include "AccountManager.h"
+#include "ChannelServer.h"
+
+using namespace channel;
+using namespace channel::bench;
+
+namespace
+{
+
+/// Number of items in the synthetic account, roughly every item box and
+/// the depository filled
+const uint32_t ACCOUNT_ITEM_COUNT = 2000;
+
+} // namespace
+
+void channel::bench::AddAccountBenchmarks(BenchmarkSuite& suite)
+{
+    suite.Add("AccountManager::DumpObject", [](const std::shared_ptr<
+        ChannelServer>& server) -> BenchmarkOp
+    {
+        auto accountManager = std::make_shared<AccountManager>(server);
+
+        // A large account is mostly items so dump that many of them the
+        // same way DumpAccount streams each object
+        auto items = std::make_shared<std::list<
+            std::shared_ptr<objects::Item>>>();
+        for(uint32_t i = 0; i < ACCOUNT_ITEM_COUNT; i++)
+        {
+            auto item = libcomp::PersistentObject::New<objects::Item>(true);
+            item->SetType(1000 + i % 500);
+            item->SetStackSize((uint16_t)(1 + i % 50));
+            item->SetBoxSlot((int8_t)(i % 50));
+            items->push_back(item);
+        }
+
+        return [accountManager, items]()
+        {
+            uint64_t size = 0;
+            for(auto& item : *items)
+            {
+                accountManager->DumpObject(item, [&size](
+                    const std::string& data)
+                    {
+                        size += data.size();
+
+                        return true;
+                    });
+            }
+
+            BenchmarkSuite::Consume(size);
+        };
+    });
+}
@@ -0,0 +1,169 @@
+/**
+ * @file server/channel/bench/Benchmark.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Minimal micro-benchmark runner for channel hot paths.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// libcomp Includes
+#include <Git.h>
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+using namespace channel;
+using namespace channel::bench;
+
+namespace
+{
+
+/// Sink for values produced by benchmark operations
+std::atomic<uint64_t> gSink(0);
+
+/// Time an operation run a number of times in a row
+uint64_t TimeIterations(const BenchmarkOp& op, uint64_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0; i < iterations; i++)
+    {
+        op();
+    }
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+/// Escape a string for use in JSON output
+std::string Escape(const std::string& str)
+{
+    std::string escaped;
+    for(char c : str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            escaped.push_back('\\');
+        }
+
+        escaped.push_back(c);
+    }
+
+    return escaped;
+}
+
+} // namespace
+
+BenchmarkSuite::BenchmarkSuite(const std::shared_ptr<ChannelServer>& server)
+    : mServer(server)
+{
+}
+
+void BenchmarkSuite::Add(const std::string& name,
+    const BenchmarkSetup& setup)
+{
+    mBenchmarks.push_back(std::make_pair(name, setup));
+}
+
+size_t BenchmarkSuite::Run(std::ostream& out, const std::string& filter,
+    uint32_t samples, uint64_t minSampleTime)
+{
+    size_t count = 0;
+    for(auto& pair : mBenchmarks)
+    {
+        if(!filter.empty() && pair.first.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        auto op = pair.second(mServer);
+        if(!op)
+        {
+            continue;
+        }
+
+        auto result = Measure(pair.first, op, samples, minSampleTime);
+
+        out << "{\"name\":\"" << Escape(result.Name) << "\""
+            << ",\"iterations\":" << result.Iterations
+            << ",\"samples\":" << result.Samples
+            << ",\"min_ns\":" << result.MinNs
+            << ",\"median_ns\":" << result.MedianNs
+            << ",\"mean_ns\":" << result.MeanNs
+            << ",\"commit\":\"" << Escape(szGitCommittish) << "\"}"
+            << std::endl;
+
+        count++;
+    }
+
+    return count;
+}
+
+void BenchmarkSuite::Consume(uint64_t value)
+{
+    gSink.fetch_add(value, std::memory_order_relaxed);
+}
+
+BenchmarkResult BenchmarkSuite::Measure(const std::string& name,
+    const BenchmarkOp& op, uint32_t samples, uint64_t minSampleTime) const
+{
+    BenchmarkResult result;
+    result.Name = name;
+    result.Samples = std::max(samples, (uint32_t)1);
+
+    // Warm up and double the iteration count until one sample takes long
+    // enough for the clock resolution to not matter
+    uint64_t minNs = minSampleTime * 1000ULL;
+    uint64_t iterations = 1;
+    while(TimeIterations(op, iterations) < minNs &&
+        iterations < (1ULL << 30))
+    {
+        iterations *= 2;
+    }
+
+    result.Iterations = iterations;
+
+    std::vector<double> perOp;
+    perOp.reserve(result.Samples);
+    for(uint32_t i = 0; i < result.Samples; i++)
+    {
+        perOp.push_back((double)TimeIterations(op, iterations) /
+            (double)iterations);
+    }
+
+    std::sort(perOp.begin(), perOp.end());
+
+    double total = 0.0;
+    for(double ns : perOp)
+    {
+        total += ns;
+    }
+
+    result.MinNs = perOp.front();
+    result.MedianNs = perOp[perOp.size() / 2];
+    result.MeanNs = total / (double)perOp.size();
+
+    return result;
+}
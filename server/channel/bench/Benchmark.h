@@ -0,0 +1,182 @@
+/**
+ * @file server/channel/bench/Benchmark.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Minimal micro-benchmark runner for channel hot paths.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_BENCH_BENCHMARK_H
+#define SERVER_CHANNEL_BENCH_BENCHMARK_H
+
+// Standard C++11 Includes
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace channel
+{
+
+class ChannelServer;
+
+namespace bench
+{
+
+/// Operation being measured, called once per iteration
+typedef std::function<void()> BenchmarkOp;
+
+/// Builds the fixture for a benchmark and returns the operation to measure.
+/// Everything the operation needs should be captured by it so the fixture
+/// lives exactly as long as the benchmark runs.
+typedef std::function<BenchmarkOp(const std::shared_ptr<
+    ChannelServer>& server)> BenchmarkSetup;
+
+/**
+ * Timing results of a single benchmark.
+ */
+struct BenchmarkResult
+{
+    /// Name of the benchmark
+    std::string Name;
+
+    /// Number of times the operation was run per sample
+    uint64_t Iterations = 0;
+
+    /// Number of samples taken
+    uint32_t Samples = 0;
+
+    /// Fastest sample in nanoseconds per operation
+    double MinNs = 0.0;
+
+    /// Median sample in nanoseconds per operation
+    double MedianNs = 0.0;
+
+    /// Mean of all samples in nanoseconds per operation
+    double MeanNs = 0.0;
+};
+
+/**
+ * Set of named benchmarks that are each set up, calibrated and timed in
+ * turn. Results are written as one JSON object per line so runs from
+ * different commits can be compared by a script.
+ */
+class BenchmarkSuite
+{
+public:
+    /**
+     * Create a new benchmark suite.
+     * @param server Pointer to a channel server that has not been
+     *  initialized, used by fixtures that need a server to construct
+     *  managers with
+     */
+    BenchmarkSuite(const std::shared_ptr<ChannelServer>& server);
+
+    /**
+     * Add a benchmark to the suite.
+     * @param name Unique name of the benchmark
+     * @param setup Function that builds the fixture and returns the
+     *  operation to measure
+     */
+    void Add(const std::string& name, const BenchmarkSetup& setup);
+
+    /**
+     * Run every benchmark whose name contains the filter.
+     * @param out Stream to write the JSON results to
+     * @param filter Substring benchmark names must contain to run, empty
+     *  runs everything
+     * @param samples Number of timed samples to take per benchmark
+     * @param minSampleTime Minimum time in microseconds a single sample
+     *  should take, used to calibrate the iteration count
+     * @return Number of benchmarks that were run
+     */
+    size_t Run(std::ostream& out, const std::string& filter = {},
+        uint32_t samples = 15, uint64_t minSampleTime = 20000);
+
+    /**
+     * Consume a value produced by a benchmark operation so the compiler
+     * can not remove the work that produced it.
+     * @param value Value to consume
+     */
+    static void Consume(uint64_t value);
+
+private:
+    /**
+     * Time a single benchmark.
+     * @param name Name of the benchmark
+     * @param op Operation to time
+     * @param samples Number of timed samples to take
+     * @param minSampleTime Minimum time in microseconds per sample
+     * @return Timing results
+     */
+    BenchmarkResult Measure(const std::string& name, const BenchmarkOp& op,
+        uint32_t samples, uint64_t minSampleTime) const;
+
+    /// Pointer to the uninitialized channel server
+    std::shared_ptr<ChannelServer> mServer;
+
+    /// Registered benchmarks in the order they were added
+    std::list<std::pair<std::string, BenchmarkSetup>> mBenchmarks;
+};
+
+/**
+ * Add the account dump benchmarks.
+ * @param suite Suite to add the benchmarks to
+ */
+void AddAccountBenchmarks(BenchmarkSuite& suite);
+
+/**
+ * Add the zone geometry and pathing benchmarks.
+ * @param suite Suite to add the benchmarks to
+ */
+void AddGeometryBenchmarks(BenchmarkSuite& suite);
+
+/**
+ * Add the zone entity query benchmarks.
+ * @param suite Suite to add the benchmarks to
+ */
+void AddZoneBenchmarks(BenchmarkSuite& suite);
+
+/**
+ * Add the character manager benchmarks.
+ * @param suite Suite to add the benchmarks to
+ */
+void AddCharacterBenchmarks(BenchmarkSuite& suite);
+
+/**
+ * Add the quest progress benchmarks.
+ * @param suite Suite to add the benchmarks to
+ */
+void AddQuestBenchmarks(BenchmarkSuite& suite);
+
+/**
+ * Add the packet encode and decode benchmarks.
+ * @param suite Suite to add the benchmarks to
+ */
+void AddPacketBenchmarks(BenchmarkSuite& suite);
+
+} // namespace bench
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_BENCH_BENCHMARK_H
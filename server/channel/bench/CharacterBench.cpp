@@ -0,0 +1,68 @@
+/**
+ * @file server/channel/bench/CharacterBench.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Benchmarks for character manager calculations.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// Standard C++11 Includes
+#include <list>
+
+// object Includes
+#include <ItemDrop.h>
+
+// channel Includes
+#include "ChannelServer.h"
+#include "CharacterManager.h"
+
+using namespace channel;
+using namespace channel::bench;
+
+void channel::bench::AddCharacterBenchmarks(BenchmarkSuite& suite)
+{
+    suite.Add("CharacterManager::DetermineDrops", [](const std::shared_ptr<
+        ChannelServer>& server) -> BenchmarkOp
+    {
+        auto characterManager = std::make_shared<CharacterManager>(server);
+
+        // A large drop set with a spread of rates like a boss would have
+        auto drops = std::make_shared<std::list<
+            std::shared_ptr<objects::ItemDrop>>>();
+        for(uint32_t i = 0; i < 50; i++)
+        {
+            auto drop = std::make_shared<objects::ItemDrop>();
+            drop->SetItemType(1000 + i);
+            drop->SetRate((float)(i % 10) * 10.f + 0.5f);
+            drop->SetMinStack(1);
+            drop->SetMaxStack(5);
+            drops->push_back(drop);
+        }
+
+        return [characterManager, drops]()
+        {
+            BenchmarkSuite::Consume(characterManager->DetermineDrops(*drops,
+                30).size());
+        };
+    });
+}
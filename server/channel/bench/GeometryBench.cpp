@@ -0,0 +1,213 @@
+/**
+ * @file server/channel/bench/GeometryBench.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Benchmarks for zone collision checks and path finding.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// Standard C++11 Includes
+#include <random>
+#include <vector>
+
+// object Includes
+#include <QmpNavPoint.h>
+#include <ServerZone.h>
+
+// channel Includes
+#include "Zone.h"
+#include "ZoneGeometry.h"
+#include "ZoneManager.h"
+
+using namespace channel;
+using namespace channel::bench;
+
+namespace
+{
+
+/// Number of obstacle cells along each side of the synthetic zone
+const uint32_t GRID_SIZE = 20;
+
+/// Width of each obstacle cell, obstacles fill the middle of the cell and
+/// leave corridors along the cell edges
+const float CELL_SIZE = 500.f;
+
+/// Build a closed square shape
+std::shared_ptr<ZoneQmpShape> MakeSquare(float x1, float y1, float x2,
+    float y2)
+{
+    auto shape = std::make_shared<ZoneQmpShape>();
+    shape->IsLine = false;
+
+    Point a(x1, y1), b(x2, y1), c(x2, y2), d(x1, y2);
+    shape->Lines = { Line(a, b), Line(b, c), Line(c, d), Line(d, a) };
+    shape->Vertices = { a, b, c, d };
+    shape->Boundaries[0] = a;
+    shape->Boundaries[1] = c;
+
+    return shape;
+}
+
+/// Build a grid of square obstacles with nav points at every corridor
+/// intersection connected to their neighbors
+std::shared_ptr<ZoneGeometry> MakeGeometry()
+{
+    auto geometry = std::make_shared<ZoneGeometry>();
+    geometry->QmpFilename = "bench.qmp";
+
+    uint32_t instanceID = 1;
+    for(uint32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for(uint32_t j = 0; j < GRID_SIZE; j++)
+        {
+            float x = (float)i * CELL_SIZE;
+            float y = (float)j * CELL_SIZE;
+
+            auto shape = MakeSquare(x + 100.f, y + 100.f, x + 400.f,
+                y + 400.f);
+            shape->ShapeID = instanceID;
+            shape->InstanceID = instanceID++;
+            geometry->Shapes.push_back(shape);
+        }
+    }
+
+    uint32_t side = GRID_SIZE + 1;
+    for(uint32_t i = 0; i < side; i++)
+    {
+        for(uint32_t j = 0; j < side; j++)
+        {
+            auto point = std::make_shared<objects::QmpNavPoint>();
+            point->SetPointID(i * side + j + 1);
+            point->SetX((int32_t)((float)i * CELL_SIZE));
+            point->SetY((int32_t)((float)j * CELL_SIZE));
+
+            if(i > 0)
+            {
+                point->SetDistances((i - 1) * side + j + 1, CELL_SIZE);
+            }
+
+            if(i + 1 < side)
+            {
+                point->SetDistances((i + 1) * side + j + 1, CELL_SIZE);
+            }
+
+            if(j > 0)
+            {
+                point->SetDistances(i * side + j, CELL_SIZE);
+            }
+
+            if(j + 1 < side)
+            {
+                point->SetDistances(i * side + j + 2, CELL_SIZE);
+            }
+
+            geometry->NavPoints[point->GetPointID()] = point;
+        }
+    }
+
+    return geometry;
+}
+
+/// Build a fixed set of random paths across the synthetic zone
+std::vector<Line> MakePaths(size_t count)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(0.f,
+        (float)GRID_SIZE * CELL_SIZE);
+
+    std::vector<Line> paths;
+    paths.reserve(count);
+    for(size_t i = 0; i < count; i++)
+    {
+        float x = dist(rng);
+        float y = dist(rng);
+
+        // Keep paths roughly as long as a skill or movement check would be
+        paths.push_back(Line(x, y, x + dist(rng) / 10.f,
+            y + dist(rng) / 10.f));
+    }
+
+    return paths;
+}
+
+} // namespace
+
+void channel::bench::AddGeometryBenchmarks(BenchmarkSuite& suite)
+{
+    suite.Add("ZoneShape::Collides", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        auto shape = MakeSquare(400.f, 400.f, 600.f, 600.f);
+        auto paths = std::make_shared<std::vector<Line>>(MakePaths(1024));
+        auto next = std::make_shared<size_t>(0);
+
+        return [shape, paths, next]()
+        {
+            Point point;
+            Line surface;
+            const Line& path = (*paths)[(*next)++ % paths->size()];
+            BenchmarkSuite::Consume(shape->Collides(path, point, surface)
+                ? 1 : 0);
+        };
+    });
+
+    suite.Add("ZoneGeometry::Collides", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        auto geometry = MakeGeometry();
+        auto paths = std::make_shared<std::vector<Line>>(MakePaths(1024));
+        auto next = std::make_shared<size_t>(0);
+
+        return [geometry, paths, next]()
+        {
+            Point point;
+            const Line& path = (*paths)[(*next)++ % paths->size()];
+            BenchmarkSuite::Consume(geometry->Collides(path, point)
+                ? 1 : 0);
+        };
+    });
+
+    suite.Add("ZoneManager::GetShortestPath", [](const std::shared_ptr<
+        ChannelServer>& server) -> BenchmarkOp
+    {
+        auto definition = std::make_shared<objects::ServerZone>();
+        definition->SetID(1);
+
+        auto zone = std::make_shared<Zone>(1, definition);
+        zone->SetGeometry(MakeGeometry());
+
+        auto zoneManager = std::make_shared<ZoneManager>(server);
+
+        // Opposite corridors of the zone so the path has to go around
+        // many obstacles
+        Point source(0.f, 250.f);
+        Point dest((float)GRID_SIZE * CELL_SIZE,
+            (float)GRID_SIZE * CELL_SIZE - 250.f);
+
+        return [zone, zoneManager, source, dest]()
+        {
+            BenchmarkSuite::Consume(zoneManager->GetShortestPath(zone,
+                source, dest).size());
+        };
+    });
+}
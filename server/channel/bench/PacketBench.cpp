@@ -0,0 +1,100 @@
+/**
+ * @file server/channel/bench/PacketBench.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Benchmarks for packet encoding and decoding.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// libcomp Includes
+#include <Packet.h>
+#include <PacketCodes.h>
+
+using namespace channel;
+using namespace channel::bench;
+
+namespace
+{
+
+/// Number of entries written to the synthetic packet, roughly the size of
+/// a busy zone's entity list
+const uint16_t ENTRY_COUNT = 100;
+
+/// Write a packet shaped like the larger channel to client packets
+void Encode(libcomp::Packet& p)
+{
+    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_CHAT);
+    p.WriteU16Little(ENTRY_COUNT);
+    for(uint16_t i = 0; i < ENTRY_COUNT; i++)
+    {
+        p.WriteS32Little((int32_t)i);
+        p.WriteFloat((float)i * 10.f);
+        p.WriteFloat((float)i * 20.f);
+        p.WriteS8(1);
+        p.WriteString16Little(libcomp::Convert::Encoding_t::ENCODING_UTF8,
+            "Benchmark entity name", true);
+    }
+}
+
+} // namespace
+
+void channel::bench::AddPacketBenchmarks(BenchmarkSuite& suite)
+{
+    suite.Add("Packet::Encode", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        return []()
+        {
+            libcomp::Packet p;
+            Encode(p);
+            BenchmarkSuite::Consume(p.Size());
+        };
+    });
+
+    suite.Add("Packet::Decode", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        auto p = std::make_shared<libcomp::Packet>();
+        Encode(*p);
+
+        return [p]()
+        {
+            p->Seek(2);
+
+            uint64_t total = 0;
+            uint16_t count = p->ReadU16Little();
+            for(uint16_t i = 0; i < count; i++)
+            {
+                total += (uint64_t)p->ReadS32Little();
+                total += (uint64_t)p->ReadFloat();
+                total += (uint64_t)p->ReadFloat();
+                total += (uint64_t)p->ReadS8();
+                total += p->ReadString16Little(
+                    libcomp::Convert::Encoding_t::ENCODING_UTF8, true)
+                    .Length();
+            }
+
+            BenchmarkSuite::Consume(total);
+        };
+    });
+}
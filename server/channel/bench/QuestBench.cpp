@@ -0,0 +1,150 @@
+/**
+ * @file server/channel/bench/QuestBench.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Benchmarks for quest progress updates.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// Standard C++11 Includes
+#include <set>
+#include <unordered_map>
+
+// object Includes
+#include <Quest.h>
+
+// channel Includes
+#include "ClientState.h"
+
+using namespace channel;
+using namespace channel::bench;
+
+namespace
+{
+
+/// Number of active quests, well past what a player normally has open
+const int16_t ACTIVE_QUEST_COUNT = 200;
+
+/// Number of kill requirements in the current phase of each quest
+const uint8_t KILL_REQUIREMENTS = 3;
+
+/// Number of enemy types the kill requirements are spread over
+const uint32_t ENEMY_TYPES = 400;
+
+/// Kill count each requirement needs, high enough to never be reached
+const int32_t REQUIRED_KILLS = 1000000;
+
+/**
+ * Client with many active quests and its index of kill requirements.
+ */
+struct ActiveQuests
+{
+    ActiveQuests() : State(new ClientState)
+    {
+        std::unordered_map<uint32_t, std::list<QuestKillRequirement>> reqs;
+        for(int16_t questID = 1; questID <= ACTIVE_QUEST_COUNT; questID++)
+        {
+            auto quest = std::make_shared<objects::Quest>();
+            quest->SetQuestID(questID);
+            quest->SetPhase(1);
+            Quests[questID] = quest;
+
+            for(uint8_t i = 0; i < KILL_REQUIREMENTS; i++)
+            {
+                QuestKillRequirement req;
+                req.QuestID = questID;
+                req.Phase = 1;
+                req.Index = i;
+
+                reqs[(uint32_t)(questID * KILL_REQUIREMENTS + i) %
+                    ENEMY_TYPES].push_back(req);
+            }
+        }
+
+        State->SetQuestKillRequirements(reqs);
+    }
+
+    /// Client the quests belong to
+    std::unique_ptr<ClientState> State;
+
+    /// Active quests by quest ID
+    std::unordered_map<int16_t, std::shared_ptr<objects::Quest>> Quests;
+
+    /// Enemy type of the next kill
+    uint32_t NextEnemy = 0;
+};
+
+} // namespace
+
+void channel::bench::AddQuestBenchmarks(BenchmarkSuite& suite)
+{
+    // EventManager::UpdateQuestKillCount needs quest definitions, the world
+    // database and a connected client so this runs the part of it that
+    // scales with the number of active quests: finding the requirements
+    // the killed enemy types count towards and updating their counts.
+    suite.Add("ClientState::GetQuestKillRequirements", [](
+        const std::shared_ptr<ChannelServer>& server) -> BenchmarkOp
+    {
+        (void)server;
+
+        auto fixture = std::make_shared<ActiveQuests>();
+
+        return [fixture]()
+        {
+            // A typical fight kills a few different enemy types
+            std::unordered_map<uint32_t, int32_t> kills;
+            for(uint32_t i = 0; i < 3; i++)
+            {
+                kills[fixture->NextEnemy] = 1;
+                fixture->NextEnemy = (fixture->NextEnemy + 7) % ENEMY_TYPES;
+            }
+
+            std::set<int16_t> countUpdates;
+            for(auto& kPair : kills)
+            {
+                for(auto& killReq : fixture->State->GetQuestKillRequirements(
+                    kPair.first))
+                {
+                    auto it = fixture->Quests.find(killReq.QuestID);
+                    if(it == fixture->Quests.end() ||
+                        it->second->GetPhase() != killReq.Phase)
+                    {
+                        continue;
+                    }
+
+                    auto quest = it->second;
+                    int32_t customData = quest->GetCustomData(
+                        (size_t)killReq.Index);
+                    if(customData < REQUIRED_KILLS)
+                    {
+                        countUpdates.insert(killReq.QuestID);
+                        quest->SetCustomData((size_t)killReq.Index,
+                            customData + kPair.second);
+                    }
+                }
+            }
+
+            BenchmarkSuite::Consume(countUpdates.size());
+        };
+    });
+}
@@ -0,0 +1,193 @@
+/**
+ * @file server/channel/bench/ZoneBench.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Benchmarks for zone entity position queries.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// libcomp Includes
+#include <DefinitionManager.h>
+
+// Standard C++11 Includes
+#include <random>
+#include <vector>
+
+// object Includes
+#include <Enemy.h>
+#include <EntityStats.h>
+#include <ServerZone.h>
+
+// channel Includes
+#include "ChannelServer.h"
+#include "EnemyState.h"
+#include "Zone.h"
+
+using namespace channel;
+using namespace channel::bench;
+
+namespace
+{
+
+/// Number of enemies in the crowded zone
+const int32_t CROWD_SIZE = 2000;
+
+/// Width and height of the area the crowd is spread over
+const float CROWD_AREA = 10000.f;
+
+/// Radius used for the range queries, roughly an aggro check
+const double QUERY_RADIUS = 2000.0;
+
+/**
+ * Zone full of enemies, half of which are moving for the whole run.
+ */
+struct CrowdedZone
+{
+    CrowdedZone() : Definitions(new libcomp::DefinitionManager)
+    {
+        auto definition = std::make_shared<objects::ServerZone>();
+        definition->SetID(1);
+
+        Instance = std::make_shared<Zone>(1, definition);
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(0.f, CROWD_AREA);
+
+        uint64_t now = ChannelServer::GetServerTime();
+        for(int32_t i = 0; i < CROWD_SIZE; i++)
+        {
+            auto stats = std::make_shared<objects::EntityStats>();
+            stats->SetLevel(50);
+            stats->SetHP(1000);
+
+            auto enemy = std::make_shared<objects::Enemy>();
+            enemy->SetCoreStats(stats);
+
+            auto eState = std::make_shared<EnemyState>();
+            eState->SetEntity(enemy, Definitions.get());
+            eState->SetEntityID(i + 1);
+
+            float x = dist(rng);
+            float y = dist(rng);
+            eState->SetOriginX(x);
+            eState->SetOriginY(y);
+            eState->SetOriginTicks(now);
+            eState->SetCurrentX(x);
+            eState->SetCurrentY(y);
+
+            if(i % 2)
+            {
+                // Keep moving well past the end of the run so every query
+                // has to interpolate
+                eState->SetDestinationX(dist(rng));
+                eState->SetDestinationY(dist(rng));
+                eState->SetDestinationRotation(1.f);
+                eState->SetDestinationTicks(now + 3600000000ULL);
+            }
+            else
+            {
+                eState->SetDestinationX(x);
+                eState->SetDestinationY(y);
+                eState->SetDestinationTicks(now);
+            }
+
+            Instance->AddEnemy(eState);
+            eState->SetZone(Instance, false);
+        }
+
+        // Fixed query centers so every run checks the same spots
+        for(size_t i = 0; i < 256; i++)
+        {
+            Centers.push_back(Point(dist(rng), dist(rng)));
+        }
+    }
+
+    ~CrowdedZone()
+    {
+        // Break the references between the zone and its entities
+        Instance->Cleanup();
+    }
+
+    /// Definitions used to set the enemies, left empty
+    std::unique_ptr<libcomp::DefinitionManager> Definitions;
+
+    /// Zone the enemies are in
+    std::shared_ptr<Zone> Instance;
+
+    /// Centers of the range queries
+    std::vector<Point> Centers;
+
+    /// Index of the next query center to use
+    size_t Next = 0;
+};
+
+} // namespace
+
+void channel::bench::AddZoneBenchmarks(BenchmarkSuite& suite)
+{
+    suite.Add("Zone::GetActiveEntitiesInRadius", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        auto crowd = std::make_shared<CrowdedZone>();
+
+        return [crowd]()
+        {
+            const Point& center = crowd->Centers[crowd->Next++ %
+                crowd->Centers.size()];
+            BenchmarkSuite::Consume(crowd->Instance->GetActiveEntitiesInRadius(
+                center.x, center.y, QUERY_RADIUS).size());
+        };
+    });
+
+    suite.Add("Zone::GetSnapshotEntitiesInRadius", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        auto crowd = std::make_shared<CrowdedZone>();
+
+        // Queries all happen within the tick the snapshot was taken on
+        uint64_t now = ChannelServer::GetServerTime();
+        crowd->Instance->UpdatePositionSnapshot(now);
+
+        return [crowd, now]()
+        {
+            const Point& center = crowd->Centers[crowd->Next++ %
+                crowd->Centers.size()];
+            BenchmarkSuite::Consume(crowd->Instance->GetSnapshotEntitiesInRadius(
+                center.x, center.y, QUERY_RADIUS, now).size());
+        };
+    });
+
+    suite.Add("Zone::UpdatePositionSnapshot", [](const std::shared_ptr<
+        ChannelServer>&) -> BenchmarkOp
+    {
+        auto crowd = std::make_shared<CrowdedZone>();
+
+        return [crowd]()
+        {
+            crowd->Instance->UpdatePositionSnapshot(
+                ChannelServer::GetServerTime());
+            BenchmarkSuite::Consume(crowd->Instance->GetPositionSnapshot(
+                ChannelServer::GetServerTime()) ? 1 : 0);
+        };
+    });
+}
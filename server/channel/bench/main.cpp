@@ -0,0 +1,124 @@
+/**
+ * @file server/channel/bench/main.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Entry point of the channel micro-benchmarks.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+// libcomp Includes
+#include <ServerCommandLineParser.h>
+
+// object Includes
+#include <ChannelConfig.h>
+#include <WorldSharedConfig.h>
+
+// Standard C++11 Includes
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// channel Includes
+#include "ChannelServer.h"
+
+/**
+ * Run the channel micro-benchmarks. Results are written to standard output
+ * (or the file passed to --output) as one JSON object per line.
+ *
+ * Usage: comp_channel_bench [--filter NAME] [--samples N] [--output FILE]
+ */
+int main(int argc, const char *argv[])
+{
+    std::string filter;
+    std::string outputPath;
+    uint32_t samples = 15;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(0 == strcmp(argv[i], "--filter") && (i + 1) < argc)
+        {
+            filter = argv[++i];
+        }
+        else if(0 == strcmp(argv[i], "--samples") && (i + 1) < argc)
+        {
+            samples = (uint32_t)atoi(argv[++i]);
+        }
+        else if(0 == strcmp(argv[i], "--output") && (i + 1) < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--filter NAME]"
+                " [--samples N] [--output FILE]" << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Fixtures are all built in process so the server is never initialized
+    // and no database or client data is needed
+    auto config = std::make_shared<objects::ChannelConfig>();
+    config->SetWorldSharedConfig(
+        std::make_shared<objects::WorldSharedConfig>());
+
+    auto server = std::make_shared<channel::ChannelServer>(argv[0], config,
+        std::make_shared<libcomp::ServerCommandLineParser>());
+
+    channel::bench::BenchmarkSuite suite(server);
+    channel::bench::AddAccountBenchmarks(suite);
+    channel::bench::AddGeometryBenchmarks(suite);
+    channel::bench::AddZoneBenchmarks(suite);
+    channel::bench::AddCharacterBenchmarks(suite);
+    channel::bench::AddPacketBenchmarks(suite);
+    channel::bench::AddQuestBenchmarks(suite);
+
+    size_t count = 0;
+    if(!outputPath.empty())
+    {
+        std::ofstream out(outputPath.c_str());
+        if(!out.good())
+        {
+            std::cerr << "Failed to open output file: " << outputPath
+                << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        count = suite.Run(out, filter, samples);
+    }
+    else
+    {
+        count = suite.Run(std::cout, filter, samples);
+    }
+
+    if(!count)
+    {
+        std::cerr << "No benchmarks matched the filter." << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,356 @@
+/**
+ * @file server/channel/sim/ZoneSimulation.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Deterministic headless simulation of a single zone.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ZoneSimulation.h"
+
+// libcomp Includes
+#include <DefinitionManager.h>
+
+// Standard C++11 Includes
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+// object Includes
+#include <Enemy.h>
+#include <EntityStats.h>
+#include <ServerZone.h>
+
+// channel Includes
+#include "ChannelServer.h"
+#include "EnemyState.h"
+#include "Zone.h"
+
+using namespace channel;
+
+// Time between simulated ticks in microseconds, matching the server tick
+#define SIM_TICK_INTERVAL 100000ULL
+
+// Simulated time the first tick runs at
+#define SIM_START_TIME 1000000000ULL
+
+// Width and height of the area enemies are spawned and wander in
+#define SIM_AREA_SIZE 4000.f
+
+// Movement speed in units per second used for every move
+#define SIM_MOVE_SPEED 300.f
+
+// Chance out of 100 that an idle enemy starts wandering each tick
+#define SIM_WANDER_CHANCE 5
+
+// Furthest an enemy wanders from its current position
+#define SIM_WANDER_DISTANCE 500.f
+
+namespace
+{
+
+/// Current simulated time
+std::atomic<uint64_t> gSimulationTime(SIM_START_TIME);
+
+/// Get the bit pattern of a float so output does not depend on formatting
+uint32_t FloatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    return bits;
+}
+
+} // namespace
+
+ZoneSimulation::ZoneSimulation(const std::shared_ptr<ChannelServer>& server,
+    uint32_t seed, uint32_t enemyCount) : mServer(server),
+    mDefinitions(new libcomp::DefinitionManager), mRNG(seed),
+    mHash(14695981039346656037ULL)
+{
+    gSimulationTime = SIM_START_TIME;
+    ChannelServer::SetServerTimeFunction(&ZoneSimulation::GetTime);
+
+    auto definition = std::make_shared<objects::ServerZone>();
+    definition->SetID(1);
+
+    mZone = std::make_shared<Zone>(1, definition);
+
+    std::uniform_real_distribution<float> dist(0.f, SIM_AREA_SIZE);
+
+    uint64_t now = GetTime();
+    for(uint32_t i = 0; i < enemyCount; i++)
+    {
+        auto stats = std::make_shared<objects::EntityStats>();
+        stats->SetLevel(50);
+        stats->SetHP(1000);
+
+        auto enemy = std::make_shared<objects::Enemy>();
+        enemy->SetCoreStats(stats);
+
+        auto eState = std::make_shared<EnemyState>();
+        eState->SetEntity(enemy, mDefinitions.get());
+        eState->SetEntityID((int32_t)i + 1);
+
+        float x = dist(mRNG);
+        float y = dist(mRNG);
+        eState->SetOriginX(x);
+        eState->SetOriginY(y);
+        eState->SetOriginTicks(now);
+        eState->SetCurrentX(x);
+        eState->SetCurrentY(y);
+        eState->SetDestinationX(x);
+        eState->SetDestinationY(y);
+        eState->SetDestinationTicks(now);
+
+        mZone->AddEnemy(eState);
+        eState->SetZone(mZone, false);
+    }
+}
+
+ZoneSimulation::~ZoneSimulation()
+{
+    // Break the references between the zone and its entities
+    mZone->Cleanup();
+
+    ChannelServer::SetServerTimeFunction(nullptr);
+}
+
+bool ZoneSimulation::LoadScript(std::istream& in, std::string& error)
+{
+    std::list<SimulationInput> inputs;
+
+    std::string line;
+    size_t lineNumber = 0;
+    while(std::getline(in, line))
+    {
+        lineNumber++;
+
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream lineIn(line);
+
+        SimulationInput input;
+        input.Text = line;
+
+        std::string type;
+        if(!(lineIn >> input.Tick >> type >> input.EntityID))
+        {
+            error = "Invalid input on line " + std::to_string(lineNumber);
+
+            return false;
+        }
+
+        bool valid = true;
+        if(type == "move")
+        {
+            input.Type = SimulationInput::Type_t::MOVE;
+            valid = (bool)(lineIn >> input.X >> input.Y);
+        }
+        else if(type == "stop")
+        {
+            input.Type = SimulationInput::Type_t::STOP;
+        }
+        else if(type == "rotate")
+        {
+            input.Type = SimulationInput::Type_t::ROTATE;
+            valid = (bool)(lineIn >> input.X);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if(!valid)
+        {
+            error = "Invalid input on line " + std::to_string(lineNumber);
+
+            return false;
+        }
+
+        inputs.push_back(input);
+    }
+
+    // Keep the script order for inputs on the same tick
+    inputs.sort([](const SimulationInput& a, const SimulationInput& b)
+        {
+            return a.Tick < b.Tick;
+        });
+
+    mInputs = inputs;
+
+    mScripted.clear();
+    for(auto& input : mInputs)
+    {
+        mScripted[input.EntityID] = true;
+    }
+
+    return true;
+}
+
+uint64_t ZoneSimulation::Run(uint32_t ticks, std::ostream& out)
+{
+    std::uniform_int_distribution<int> chance(1, 100);
+    std::uniform_real_distribution<float> offset(-SIM_WANDER_DISTANCE,
+        SIM_WANDER_DISTANCE);
+
+    auto input = mInputs.begin();
+    for(uint32_t tick = 0; tick < ticks; tick++)
+    {
+        uint64_t now = SIM_START_TIME + (uint64_t)tick * SIM_TICK_INTERVAL;
+        gSimulationTime = now;
+
+        for(; input != mInputs.end() && input->Tick <= tick; input++)
+        {
+            if(Apply(*input, now))
+            {
+                Write(out, "I " + std::to_string(tick) + " " + input->Text);
+            }
+            else
+            {
+                Write(out, "X " + std::to_string(tick) + " " + input->Text);
+            }
+        }
+
+        mZone->UpdatePositionSnapshot(now);
+
+        auto snapshot = mZone->GetPositionSnapshot(now);
+        for(size_t i = 0; i < snapshot->EntityIDs.size(); i++)
+        {
+            int32_t entityID = snapshot->EntityIDs[i];
+
+            EntityRecord record;
+            record.X = FloatBits(snapshot->X[i]);
+            record.Y = FloatBits(snapshot->Y[i]);
+            record.Rotation = FloatBits(snapshot->Rotation[i]);
+            record.Flags = snapshot->Flags[i];
+
+            auto it = mRecords.find(entityID);
+            if(it == mRecords.end() || it->second.X != record.X ||
+                it->second.Y != record.Y ||
+                it->second.Rotation != record.Rotation ||
+                it->second.Flags != record.Flags)
+            {
+                std::ostringstream line;
+                line << "E " << tick << " " << entityID << std::hex
+                    << " " << record.X << " " << record.Y << " "
+                    << record.Rotation << " " << (uint32_t)record.Flags;
+                Write(out, line.str());
+
+                mRecords[entityID] = record;
+            }
+
+            // Idle enemies the script does not control wander around
+            // in place of AI
+            if(!(record.Flags & POSITION_SNAPSHOT_MOVING) &&
+                mScripted.find(entityID) == mScripted.end() &&
+                chance(mRNG) <= SIM_WANDER_CHANCE)
+            {
+                auto eState = snapshot->Entities[i].lock();
+                if(eState)
+                {
+                    float x = snapshot->X[i] + offset(mRNG);
+                    float y = snapshot->Y[i] + offset(mRNG);
+                    Move(eState, x, y, now);
+                }
+            }
+        }
+    }
+
+    std::ostringstream line;
+    line << "H " << std::hex << mHash;
+    out << line.str() << std::endl;
+
+    return mHash;
+}
+
+uint64_t ZoneSimulation::GetTime()
+{
+    return gSimulationTime;
+}
+
+bool ZoneSimulation::Apply(const SimulationInput& input, uint64_t now)
+{
+    auto eState = mZone->GetActiveEntity(input.EntityID);
+    if(!eState)
+    {
+        return false;
+    }
+
+    eState->RefreshCurrentPosition(now);
+
+    switch(input.Type)
+    {
+    case SimulationInput::Type_t::MOVE:
+        Move(eState, input.X, input.Y, now);
+        break;
+    case SimulationInput::Type_t::STOP:
+        eState->Stop(now);
+        break;
+    case SimulationInput::Type_t::ROTATE:
+        eState->SetOriginRotation(eState->GetCurrentRotation());
+        eState->SetDestinationRotation(input.X);
+        eState->SetOriginTicks(now);
+        eState->SetDestinationTicks(now + SIM_TICK_INTERVAL);
+        break;
+    }
+
+    return true;
+}
+
+void ZoneSimulation::Move(const std::shared_ptr<ActiveEntityState>& eState,
+    float x, float y, uint64_t now)
+{
+    float originX = eState->GetCurrentX();
+    float originY = eState->GetCurrentY();
+
+    float distance = std::sqrt((float)(std::pow(x - originX, 2) +
+        std::pow(y - originY, 2)));
+
+    eState->SetOriginX(originX);
+    eState->SetOriginY(originY);
+    eState->SetOriginRotation(eState->GetCurrentRotation());
+    eState->SetOriginTicks(now);
+
+    eState->SetDestinationX(x);
+    eState->SetDestinationY(y);
+    eState->SetDestinationRotation(eState->GetCurrentRotation());
+    eState->SetDestinationTicks(now + (uint64_t)(distance /
+        SIM_MOVE_SPEED * 1000000.f));
+}
+
+void ZoneSimulation::Write(std::ostream& out, const std::string& line)
+{
+    for(char c : line)
+    {
+        mHash ^= (uint8_t)c;
+        mHash *= 1099511628211ULL;
+    }
+
+    mHash ^= (uint8_t)'\n';
+    mHash *= 1099511628211ULL;
+
+    out << line << "\n";
+}
@@ -0,0 +1,211 @@
+/**
+ * @file server/channel/sim/ZoneSimulation.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Deterministic headless simulation of a single zone.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SIM_ZONESIMULATION_H
+#define SERVER_CHANNEL_SIM_ZONESIMULATION_H
+
+// Standard C++11 Includes
+#include <cstdint>
+#include <istream>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace libcomp
+{
+class DefinitionManager;
+}
+
+namespace channel
+{
+
+class ActiveEntityState;
+class ChannelServer;
+class Zone;
+
+/**
+ * Scripted input applied to an entity at a fixed tick.
+ */
+struct SimulationInput
+{
+    /**
+     * Type of input
+     */
+    enum class Type_t : uint8_t
+    {
+        MOVE,   //!< Move to a position
+        STOP,   //!< Stop at the current position
+        ROTATE, //!< Turn in place
+    };
+
+    /// Tick the input is applied on
+    uint32_t Tick = 0;
+
+    /// Type of input
+    Type_t Type = Type_t::MOVE;
+
+    /// ID of the entity the input is applied to
+    int32_t EntityID = 0;
+
+    /// Destination X coordinate or rotation
+    float X = 0.f;
+
+    /// Destination Y coordinate
+    float Y = 0.f;
+
+    /// Line of the script the input was read from
+    std::string Text;
+};
+
+/**
+ * Runs a single zone headless on a simulated clock. The zone is filled
+ * with synthetic enemies and driven by scripted inputs and seeded idle
+ * wandering. Every tick the zone's position snapshot is taken and each
+ * entity state change is written out. Given the same seed, enemy count
+ * and script two runs write identical output so behavior can be compared
+ * across builds.
+ */
+class ZoneSimulation
+{
+public:
+    /**
+     * Create a new simulation.
+     * @param server Pointer to a channel server that has not been
+     *  initialized
+     * @param seed Seed for every random decision made by the simulation
+     * @param enemyCount Number of enemies to spawn in the zone
+     */
+    ZoneSimulation(const std::shared_ptr<ChannelServer>& server,
+        uint32_t seed, uint32_t enemyCount);
+
+    /**
+     * Clean up the simulation.
+     */
+    ~ZoneSimulation();
+
+    /**
+     * Load scripted inputs. Each non-empty line that does not start with #
+     * is one of:
+     *   <tick> move <entity ID> <x> <y>
+     *   <tick> stop <entity ID>
+     *   <tick> rotate <entity ID> <rotation>
+     * @param in Stream to read the script from
+     * @param error Output parameter set to the reason the script failed to
+     *  load
+     * @return true if the script loaded
+     */
+    bool LoadScript(std::istream& in, std::string& error);
+
+    /**
+     * Run the simulation.
+     * @param ticks Number of ticks to run for
+     * @param out Stream to write every state change to
+     * @return Hash of everything written to the output
+     */
+    uint64_t Run(uint32_t ticks, std::ostream& out);
+
+    /**
+     * Get the current simulated time. This is installed as the server
+     * time function while the simulation exists.
+     * @return Current simulated time in microseconds
+     */
+    static uint64_t GetTime();
+
+private:
+    /**
+     * Recorded state of an entity on the last tick it was written out.
+     */
+    struct EntityRecord
+    {
+        /// Bit pattern of the X coordinate
+        uint32_t X = 0;
+
+        /// Bit pattern of the Y coordinate
+        uint32_t Y = 0;
+
+        /// Bit pattern of the rotation
+        uint32_t Rotation = 0;
+
+        /// POSITION_SNAPSHOT flags
+        uint8_t Flags = 0;
+    };
+
+    /**
+     * Apply an input to its entity.
+     * @param input Input to apply
+     * @param now Current simulated time
+     * @return true if the entity exists
+     */
+    bool Apply(const SimulationInput& input, uint64_t now);
+
+    /**
+     * Start an entity moving from its current position.
+     * @param eState Pointer to the entity
+     * @param x Destination X coordinate
+     * @param y Destination Y coordinate
+     * @param now Current simulated time
+     */
+    void Move(const std::shared_ptr<ActiveEntityState>& eState, float x,
+        float y, uint64_t now);
+
+    /**
+     * Write a line to the output and add it to the hash.
+     * @param out Stream to write to
+     * @param line Line to write without the line ending
+     */
+    void Write(std::ostream& out, const std::string& line);
+
+    /// Pointer to the uninitialized channel server
+    std::shared_ptr<ChannelServer> mServer;
+
+    /// Definitions used to set the enemies, left empty
+    std::unique_ptr<libcomp::DefinitionManager> mDefinitions;
+
+    /// Zone being simulated
+    std::shared_ptr<Zone> mZone;
+
+    /// Scripted inputs in tick order
+    std::list<SimulationInput> mInputs;
+
+    /// Entities the script has given inputs to, these do not wander
+    std::unordered_map<int32_t, bool> mScripted;
+
+    /// State of each entity as of the last line written for it
+    std::unordered_map<int32_t, EntityRecord> mRecords;
+
+    /// Random number generator for every decision the simulation makes
+    std::mt19937 mRNG;
+
+    /// FNV-1a hash of the output written so far
+    uint64_t mHash;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SIM_ZONESIMULATION_H
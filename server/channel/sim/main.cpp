@@ -0,0 +1,149 @@
+/**
+ * @file server/channel/sim/main.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Entry point of the headless zone simulation.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ZoneSimulation.h"
+
+// libcomp Includes
+#include <ServerCommandLineParser.h>
+
+// object Includes
+#include <ChannelConfig.h>
+#include <WorldSharedConfig.h>
+
+// Standard C++11 Includes
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// channel Includes
+#include "ChannelServer.h"
+
+/**
+ * Run a headless zone simulation. Every state change is written to
+ * standard output (or the file passed to --output) followed by a hash of
+ * the whole run. The wall clock time taken is written to standard error so
+ * it does not change the output.
+ *
+ * Usage: comp_channel_sim [--seed N] [--ticks N] [--enemies N]
+ *  [--script FILE] [--output FILE]
+ */
+int main(int argc, const char *argv[])
+{
+    uint32_t seed = 1;
+    uint32_t ticks = 600;
+    uint32_t enemies = 200;
+    std::string scriptPath;
+    std::string outputPath;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(0 == strcmp(argv[i], "--seed") && (i + 1) < argc)
+        {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if(0 == strcmp(argv[i], "--ticks") && (i + 1) < argc)
+        {
+            ticks = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if(0 == strcmp(argv[i], "--enemies") && (i + 1) < argc)
+        {
+            enemies = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        }
+        else if(0 == strcmp(argv[i], "--script") && (i + 1) < argc)
+        {
+            scriptPath = argv[++i];
+        }
+        else if(0 == strcmp(argv[i], "--output") && (i + 1) < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--seed N] [--ticks N]"
+                " [--enemies N] [--script FILE] [--output FILE]"
+                << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The server is never initialized so no database or client data is
+    // needed
+    auto config = std::make_shared<objects::ChannelConfig>();
+    config->SetWorldSharedConfig(
+        std::make_shared<objects::WorldSharedConfig>());
+
+    auto server = std::make_shared<channel::ChannelServer>(argv[0], config,
+        std::make_shared<libcomp::ServerCommandLineParser>());
+
+    channel::ZoneSimulation simulation(server, seed, enemies);
+
+    if(!scriptPath.empty())
+    {
+        std::ifstream script(scriptPath.c_str());
+        std::string error;
+        if(!script.good())
+        {
+            error = "Failed to open script file: " + scriptPath;
+        }
+
+        if(!error.empty() || !simulation.LoadScript(script, error))
+        {
+            std::cerr << error << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    if(!outputPath.empty())
+    {
+        std::ofstream out(outputPath.c_str());
+        if(!out.good())
+        {
+            std::cerr << "Failed to open output file: " << outputPath
+                << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        simulation.Run(ticks, out);
+    }
+    else
+    {
+        simulation.Run(ticks, std::cout);
+    }
+
+    std::cerr << "Simulated " << ticks << " tick(s) in " <<
+        std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count() << " us"
+        << std::endl;
+
+    return EXIT_SUCCESS;
+}
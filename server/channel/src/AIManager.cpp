@@ -40,6 +40,7 @@
 #include <ActivatedAbility.h>
 #include <AILogicGroup.h>
 #include <Ally.h>
+#include <ChannelConfig.h>
 #include <MiAIData.h>
 #include <MiAIRelationData.h>
 #include <MiBattleDamageData.h>
@@ -66,6 +67,8 @@
 #include "ChannelServer.h"
 #include "CharacterManager.h"
 #include "EventManager.h"
+#include "RoundRobin.h"
+#include "ServerMetrics.h"
 #include "SkillManager.h"
 #include "TokuseiManager.h"
 #include "ZoneManager.h"
@@ -113,13 +116,23 @@ namespace libcomp
     }
 }
 
-AIManager::AIManager()
+AIManager::AIManager() : mBudgetDeferredCount(0), mWorstTickTime(0),
+    mLODDeferredCount(0)
 {
+    for(auto& count : mLODUpdateCounts)
+    {
+        count = 0;
+    }
 }
 
 AIManager::AIManager(const std::weak_ptr<ChannelServer>& server)
-    : mServer(server)
+    : mBudgetDeferredCount(0), mWorstTickTime(0), mLODDeferredCount(0),
+    mServer(server)
 {
+    for(auto& count : mLODUpdateCounts)
+    {
+        count = 0;
+    }
 }
 
 AIManager::~AIManager()
@@ -250,7 +263,8 @@ bool AIManager::Prepare(const std::shared_ptr<ActiveEntityState>& eState,
                 return false;
             }
 
-            aiEngine = std::make_shared<libcomp::ScriptEngine>();
+            aiEngine = ServerMetrics::CreateScriptEngine(
+                ServerMetrics::ScriptEngineType_t::AI);
             aiEngine->Using<AIManager>();
 
             if(!aiEngine->Eval(script->Source))
@@ -304,17 +318,162 @@ bool AIManager::Prepare(const std::shared_ptr<ActiveEntityState>& eState,
 }
 
 void AIManager::UpdateActiveStates(const std::shared_ptr<Zone>& zone,
-    uint64_t now, bool isNight)
+    uint64_t now, bool isNight, uint64_t deadline)
 {
+    auto server = mServer.lock();
+    auto config = std::dynamic_pointer_cast<objects::ChannelConfig>(
+        server->GetConfig());
+
+    auto entities = zone->GetEnemiesAndAllies();
+
+    // Entities that are not near any player or active combatant are
+    // updated less often. Tiers are recalculated every tick so anything
+    // coming into range promotes the entity immediately.
+    float fullDistance = config->GetAILODFullDistance();
+    float dormantDistance = config->GetAILODDormantDistance();
+    bool lodEnabled = fullDistance > 0.f;
+
+    std::list<Point> interestPoints;
+    if(lodEnabled)
+    {
+        for(auto client : zone->GetConnectionList())
+        {
+            auto state = client->GetClientState();
+
+            std::list<std::shared_ptr<ActiveEntityState>> pStates = {
+                    state->GetCharacterState(), state->GetDemonState()
+                };
+            for(auto pState : pStates)
+            {
+                if(pState && pState->Ready() && pState->GetZone() == zone)
+                {
+                    interestPoints.push_back(Point(pState->GetCurrentX(),
+                        pState->GetCurrentY()));
+                }
+            }
+        }
+
+        for(auto eState : entities)
+        {
+            auto aiState = eState->GetAIState();
+            if(aiState && (aiState->GetStatus() == AIStatus_t::AGGRO ||
+                aiState->GetStatus() == AIStatus_t::COMBAT))
+            {
+                eState->RefreshCurrentPosition(now);
+                interestPoints.push_back(Point(eState->GetCurrentX(),
+                    eState->GetCurrentY()));
+            }
+        }
+    }
+
+    // Reduced tiers are staggered by entity ID so each tick only updates
+    // a slice of them (server ticks are 100ms apart)
+    uint64_t tick = now / 100000ULL;
+
+    std::array<uint32_t, AI_LOD_TIER_COUNT> updateCounts = { { 0, 0, 0 } };
+    uint32_t deferred = 0;
+
+    // Entities engaged in combat are always updated first and regardless
+    // of the time budget. Everything else is updated in round-robin order
+    // starting after the last entity updated when the budget last ran out.
+    std::list<std::pair<std::shared_ptr<ActiveEntityState>, AILODTier_t>>
+        urgent, normal;
+    for(auto eState : entities)
+    {
+        AILODTier_t tier = lodEnabled ? GetLODTier(eState, interestPoints,
+            now, fullDistance, dormantDistance) : AI_LOD_FULL;
+
+        uint64_t interval = 1;
+        switch(tier)
+        {
+        case AI_LOD_REDUCED:
+            interval = (uint64_t)config->GetAILODReducedInterval();
+            break;
+        case AI_LOD_DORMANT:
+            interval = (uint64_t)config->GetAILODDormantInterval();
+            break;
+        default:
+            break;
+        }
+
+        if(interval > 1 &&
+            (tick + (uint64_t)(uint32_t)eState->GetEntityID()) % interval)
+        {
+            mLODDeferredCount++;
+            deferred++;
+            continue;
+        }
+
+        if(IsUrgent(eState))
+        {
+            urgent.push_back(std::make_pair(eState, tier));
+        }
+        else
+        {
+            normal.push_back(std::make_pair(eState, tier));
+        }
+    }
+
+    // Continue after the last entity updated before the budget ran out
+    int32_t resumeID = zone->GetAIResumeEntityID();
+    if(deadline && normal.size() > 1)
+    {
+        OrderRoundRobin(normal, resumeID, [](const std::pair<std::shared_ptr<
+            ActiveEntityState>, AILODTier_t>& pair)
+            {
+                return pair.first->GetEntityID();
+            });
+    }
+
+    uint32_t budgetDeferred = 0;
+    int32_t lastUpdatedID = resumeID;
+
     std::list<std::shared_ptr<ActiveEntityState>> updated;
-    for(auto eState : zone->GetEnemiesAndAllies())
+    for(auto& pair : urgent)
     {
-        if(UpdateState(eState, now, isNight))
+        updateCounts[(size_t)pair.second]++;
+
+        if(UpdateState(pair.first, now, isNight))
+        {
+            updated.push_back(pair.first);
+        }
+    }
+
+    size_t normalLeft = normal.size();
+    for(auto& pair : normal)
+    {
+        if(deadline && ChannelServer::GetServerTime() >= deadline)
+        {
+            budgetDeferred = (uint32_t)normalLeft;
+            break;
+        }
+
+        normalLeft--;
+        updateCounts[(size_t)pair.second]++;
+        lastUpdatedID = pair.first->GetEntityID();
+
+        if(UpdateState(pair.first, now, isNight))
         {
-            updated.push_back(eState);
+            updated.push_back(pair.first);
         }
     }
 
+    for(size_t i = 0; i < (size_t)AI_LOD_TIER_COUNT; i++)
+    {
+        mLODUpdateCounts[i] += (uint64_t)updateCounts[i];
+    }
+
+    // Only continue where this tick left off if it ran out of time
+    zone->SetAIResumeEntityID(budgetDeferred ? lastUpdatedID : 0);
+
+    if(budgetDeferred)
+    {
+        mBudgetDeferredCount += (uint64_t)budgetDeferred;
+        deferred += budgetDeferred;
+    }
+
+    zone->SetAIUpdateCounts(updateCounts, deferred);
+
     // Update enemy states first
     if(updated.size() > 0)
     {
@@ -376,6 +535,34 @@ void AIManager::UpdateActiveStates(const std::shared_ptr<Zone>& zone,
     }
 }
 
+void AIManager::RecordTickTime(uint64_t elapsed)
+{
+    uint64_t worst = mWorstTickTime;
+    while(elapsed > worst &&
+        !mWorstTickTime.compare_exchange_weak(worst, elapsed));
+}
+
+uint64_t AIManager::GetBudgetDeferredCount() const
+{
+    return mBudgetDeferredCount;
+}
+
+uint64_t AIManager::GetLODUpdateCount(AILODTier_t tier) const
+{
+    return tier < AI_LOD_TIER_COUNT ? mLODUpdateCounts[(size_t)tier].load()
+        : 0;
+}
+
+uint64_t AIManager::GetLODDeferredCount() const
+{
+    return mLODDeferredCount;
+}
+
+uint64_t AIManager::GetWorstTickTime(bool reset)
+{
+    return reset ? mWorstTickTime.exchange(0) : mWorstTickTime.load();
+}
+
 void AIManager::CombatSkillHit(
     const std::list<std::shared_ptr<ActiveEntityState>>& entities,
     const std::shared_ptr<ActiveEntityState>& source,
@@ -1036,6 +1223,70 @@ bool AIManager::Circle(const std::shared_ptr<ActiveEntityState>& eState,
     return false;
 }
 
+bool AIManager::IsUrgent(const std::shared_ptr<ActiveEntityState>& eState)
+{
+    auto aiState = eState->GetAIState();
+    if(!aiState)
+    {
+        return false;
+    }
+
+    if(aiState->GetStatus() == AIStatus_t::COMBAT ||
+        eState->GetOpponentIDs().size() > 0)
+    {
+        return true;
+    }
+
+    // Skills being charged or executed need to finish on time
+    auto current = aiState->GetCurrentCommand();
+    return current && current->GetType() == AICommandType_t::USE_SKILL;
+}
+
+AILODTier_t AIManager::GetLODTier(
+    const std::shared_ptr<ActiveEntityState>& eState,
+    const std::list<Point>& interestPoints, uint64_t now, float fullDistance,
+    float dormantDistance)
+{
+    auto aiState = eState->GetAIState();
+    if(!aiState)
+    {
+        // Nothing to throttle
+        return AI_LOD_FULL;
+    }
+
+    // Never throttle anything that is targeting, following, fighting or
+    // waiting to despawn
+    if((!aiState->IsIdle() && !aiState->IsWandering()) ||
+        aiState->GetTargetEntityID() > 0 || aiState->HasFollowTarget() ||
+        aiState->GetDespawnTimeout() || eState->GetOpponentIDs().size() > 0)
+    {
+        return AI_LOD_FULL;
+    }
+
+    eState->RefreshCurrentPosition(now);
+
+    float closest = -1.f;
+    for(auto& point : interestPoints)
+    {
+        float dist = eState->GetDistance(point.x, point.y, true);
+        if(closest < 0.f || dist < closest)
+        {
+            closest = dist;
+        }
+    }
+
+    if(closest >= 0.f && closest <= (fullDistance * fullDistance))
+    {
+        return AI_LOD_FULL;
+    }
+    else if(closest >= 0.f && closest <= (dormantDistance * dormantDistance))
+    {
+        return AI_LOD_REDUCED;
+    }
+
+    return AI_LOD_DORMANT;
+}
+
 bool AIManager::UpdateState(const std::shared_ptr<ActiveEntityState>& eState,
     uint64_t now, bool isNight)
 {
@@ -2147,8 +2398,8 @@ std::shared_ptr<ActiveEntityState> AIManager::Retarget(
         // Currently in combat, only pull from opponents. Use deaggro
         // distance instead of the normal aggro distance since the AI
         // should technically be aggro until no opponents are still around
-        auto inRange = zone->GetActiveEntitiesInRadius(
-            sourceX, sourceY, aiState->GetDeaggroDistance(isNight));
+        auto inRange = zone->GetSnapshotEntitiesInRadius(
+            sourceX, sourceY, aiState->GetDeaggroDistance(isNight), now);
 
         for(auto entity : inRange)
         {
@@ -2192,8 +2443,8 @@ std::shared_ptr<ActiveEntityState> AIManager::Retarget(
         std::list<std::shared_ptr<ActiveEntityState>> inFoV;
         for(auto aggro : { aggroCast, aggroNormal })
         {
-            auto filtered = zone->GetActiveEntitiesInRadius(sourceX,
-                sourceY, (double)aggro.first);
+            auto filtered = zone->GetSnapshotEntitiesInRadius(sourceX,
+                sourceY, (double)aggro.first, now);
 
             // Remove allies, entities not ready yet or in an invalid state
             filtered.remove_if([eState, castingOnly, now](
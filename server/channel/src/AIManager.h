@@ -32,6 +32,10 @@
 #include "AIState.h"
 #include "ClientState.h"
 
+// Standard C++11 includes
+#include <array>
+#include <atomic>
+
 namespace libcomp
 {
 class ScriptEngine;
@@ -95,9 +99,48 @@ public:
      * @param now Current server time
      * @param isNight Specifies that the server time is currently night
      *  which is between 1800 and 0599
+     * @param deadline Server time after which entities not engaged in
+     *  combat are left to be updated on a later tick. If set to 0 all
+     *  entities will be updated.
      */
     void UpdateActiveStates(const std::shared_ptr<Zone>& zone, uint64_t now,
-        bool isNight);
+        bool isNight, uint64_t deadline = 0);
+
+    /**
+     * Record the time spent updating AI controlled entities in all zones
+     * during one server tick
+     * @param elapsed Time spent in microseconds
+     */
+    void RecordTickTime(uint64_t elapsed);
+
+    /**
+     * Get the total number of AI updates deferred to a later tick because
+     * the AI time budget ran out
+     * @return Number of deferred AI updates
+     */
+    uint64_t GetBudgetDeferredCount() const;
+
+    /**
+     * Get the total number of AI updates performed for entities in the
+     * supplied level of detail tier
+     * @param tier Level of detail tier to retrieve the count for
+     * @return Number of AI updates in the tier
+     */
+    uint64_t GetLODUpdateCount(AILODTier_t tier) const;
+
+    /**
+     * Get the total number of AI updates skipped because the entity was
+     * in a reduced or dormant level of detail tier
+     * @return Number of AI updates skipped
+     */
+    uint64_t GetLODDeferredCount() const;
+
+    /**
+     * Get the longest time spent updating AI during a single tick
+     * @param reset If true, the value will be reset once retrieved
+     * @return Longest tick AI time in microseconds
+     */
+    uint64_t GetWorstTickTime(bool reset = false);
 
     /**
      * Handler for any AI controlled entities that get hit by a combat skill
@@ -283,6 +326,30 @@ public:
         float x, float y, bool interrupt = false, float distance = 800.f);
 
 private:
+    /**
+     * Determine if an entity's AI is engaged in combat or using a skill and
+     * must be updated every tick regardless of the AI time budget
+     * @param eState Pointer to the entity state
+     * @return true if the entity must be updated, false if it can wait
+     */
+    bool IsUrgent(const std::shared_ptr<ActiveEntityState>& eState);
+
+    /**
+     * Determine the AI level of detail tier an entity should be updated at
+     * based upon its current state and the distance to the closest point
+     * of interest in the zone
+     * @param eState Pointer to the entity state
+     * @param interestPoints Positions of player entities and AI controlled
+     *  entities actively pursuing or fighting something
+     * @param now Current timestamp of the server
+     * @param fullDistance Distance within which the entity is fully updated
+     * @param dormantDistance Distance past which the entity is dormant
+     * @return Level of detail tier to update the entity at
+     */
+    AILODTier_t GetLODTier(const std::shared_ptr<ActiveEntityState>& eState,
+        const std::list<Point>& interestPoints, uint64_t now,
+        float fullDistance, float dormantDistance);
+
     /**
      * Update the state of an entity, processing AI and performing other
      * related actions.
@@ -497,6 +564,20 @@ private:
     static std::unordered_map<std::string,
         std::shared_ptr<libcomp::ScriptEngine>> sPreparedScripts;
 
+    /// Total number of AI updates deferred because the AI time budget
+    /// ran out
+    std::atomic<uint64_t> mBudgetDeferredCount;
+
+    /// Longest time in microseconds spent updating AI during one tick
+    /// since last reset
+    std::atomic<uint64_t> mWorstTickTime;
+
+    /// Total number of AI updates performed per level of detail tier
+    std::array<std::atomic<uint64_t>, AI_LOD_TIER_COUNT> mLODUpdateCounts;
+
+    /// Total number of AI updates skipped by the level of detail tiers
+    std::atomic<uint64_t> mLODDeferredCount;
+
     /// Pointer to the channel server.
     std::weak_ptr<ChannelServer> mServer;
 };
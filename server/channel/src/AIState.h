@@ -74,6 +74,18 @@ enum AIStatus_t : uint8_t
     COMBAT, //!< Entity is engaged in combat with one or more opponent
 };
 
+/**
+ * Level of detail tiers used to throttle AI updates for entities that
+ * are not close to any player or active combatant.
+ */
+enum AILODTier_t : uint8_t
+{
+    AI_LOD_FULL = 0,    //!< Entity is updated every tick
+    AI_LOD_REDUCED,     //!< Entity is updated on a reduced tick interval
+    AI_LOD_DORMANT,     //!< Entity is updated rarely
+    AI_LOD_TIER_COUNT,  //!< Number of valid tiers
+};
+
 /**
  * Contains the state of an entity's AI information when controlled
  * by the channel.
@@ -1972,29 +1972,31 @@ void AccountManager::WipeMember(tinyxml2::XMLElement *pElement,
     }
 }
 
-libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
+bool AccountManager::DumpAccount(channel::ClientState *state,
+    const std::function<bool(const std::string&)>& write)
 {
     auto db = mServer.lock()->GetWorldDatabase();
 
     if(!state)
     {
-        return {};
+        return false;
     }
 
-    // DOM for the dump XML.
-    tinyxml2::XMLDocument doc;
-
-    tinyxml2::XMLElement *pRoot = doc.NewElement("objects");
-    doc.InsertEndChild(pRoot);
+    // Each object is written out as soon as it is serialized so only one
+    // object is held in the DOM at a time.
+    if(!write("<objects>"))
+    {
+        return false;
+    }
 
     // First load and dump some account information.
     auto account = libcomp::PersistentObject::LoadObjectByUUID<
         objects::Account>(mServer.lock()->GetLobbyDatabase(),
             state->GetAccountUID(), true);
 
-    if(!account || !account->SaveWithUUID(doc, *pRoot))
+    if(!account || !DumpObject(account, write))
     {
-        return {};
+        return false;
     }
 
     for(auto character : account->GetCharacters())
@@ -2011,40 +2013,31 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
 
         if(!InitializeCharacter(character, cstate))
         {
-            return {};
+            return false;
         }
 
-        if(!character->SaveWithUUID(doc, *pRoot))
+        if(!DumpObject(character.Get(), write, { "Clan", "DemonQuest",
+            "CultureData", "PvPData" }))
         {
-            return {};
+            return false;
         }
 
-        auto pCharacterElement = pRoot->LastChildElement();
-
-        WipeMember(pCharacterElement, "Clan");
-        WipeMember(pCharacterElement, "DemonQuest");
-        WipeMember(pCharacterElement, "CultureData");
-        WipeMember(pCharacterElement, "PvPData");
-
-        if(!character->GetCoreStats()->SaveWithUUID(doc, *pRoot))
+        if(!DumpObject(character->GetCoreStats().Get(), write))
         {
-            return {};
+            return false;
         }
 
         if(!character->GetProgress().IsNull() &&
-            !character->GetProgress()->SaveWithUUID(doc, *pRoot))
+            !DumpObject(character->GetProgress().Get(), write))
         {
-            return {};
+            return false;
         }
 
         if(!character->GetFriendSettings().IsNull() &&
-            !character->GetFriendSettings()->SaveWithUUID(doc, *pRoot))
-        {
-            return {};
-        }
-        else if(!character->GetFriendSettings().IsNull())
+            !DumpObject(character->GetFriendSettings().Get(), write,
+                { "Friends" }))
         {
-            WipeMember(pRoot->LastChildElement(), "Friends");
+            return false;
         }
 
         std::list<libcomp::ObjectReference<objects::ItemBox>> allBoxes;
@@ -2056,57 +2049,57 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
                 continue;
             }
 
-            if(!itemBox->SaveWithUUID(doc, *pRoot))
+            if(!DumpObject(itemBox.Get(), write))
             {
-                return {};
+                return false;
             }
 
             for(size_t i = 0; i < 50; i++)
             {
                 auto item = itemBox->GetItems(i);
 
-                if(!item.IsNull() && !item->SaveWithUUID(doc, *pRoot))
+                if(!item.IsNull() && !DumpObject(item.Get(), write))
                 {
-                    return {};
+                    return false;
                 }
             }
         }
 
         for(auto expertise : character->GetExpertises())
         {
-            if(!expertise.IsNull() && !expertise->SaveWithUUID(doc, *pRoot))
+            if(!expertise.IsNull() && !DumpObject(expertise.Get(), write))
             {
-                return {};
+                return false;
             }
         }
 
         auto box = character->GetCOMP();
 
-        if(!box.IsNull() && !box->SaveWithUUID(doc, *pRoot))
+        if(!box.IsNull() && !DumpObject(box.Get(), write))
         {
-            return {};
+            return false;
         }
         else if(!box.IsNull())
         {
             for(auto demon : box->GetDemons())
             {
-                if(!demon.IsNull() && !demon->SaveWithUUID(doc, *pRoot))
+                if(!demon.IsNull() && !DumpObject(demon.Get(), write))
                 {
-                    return {};
+                    return false;
                 }
                 else if(!demon.IsNull())
                 {
-                    if(!demon->GetCoreStats()->SaveWithUUID(doc, *pRoot))
+                    if(!DumpObject(demon->GetCoreStats().Get(), write))
                     {
-                        return {};
+                        return false;
                     }
 
                     for(auto iSkill : demon->GetInheritedSkills())
                     {
                         if(!iSkill.IsNull() &&
-                            !iSkill->SaveWithUUID(doc, *pRoot))
+                            !DumpObject(iSkill.Get(), write))
                         {
-                            return {};
+                            return false;
                         }
                     }
 
@@ -2115,9 +2108,9 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
                         auto equipment = demon->GetEquippedItems(i);
 
                         if(!equipment.IsNull() &&
-                            !equipment->SaveWithUUID(doc, *pRoot))
+                            !DumpObject(equipment.Get(), write))
                         {
-                            return {};
+                            return false;
                         }
                     }
                 }
@@ -2126,9 +2119,9 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
 
         for(auto hotbar : character->GetHotbars())
         {
-            if(!hotbar.IsNull() && !hotbar->SaveWithUUID(doc, *pRoot))
+            if(!hotbar.IsNull() && !DumpObject(hotbar.Get(), write))
             {
-                return {};
+                return false;
             }
         }
 
@@ -2136,9 +2129,9 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
         {
             auto quest = qPair.second;
 
-            if(!quest.IsNull() && !quest->SaveWithUUID(doc, *pRoot))
+            if(!quest.IsNull() && !DumpObject(quest.Get(), write))
             {
-                return {};
+                return false;
             }
         }
 
@@ -2155,49 +2148,49 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
             continue;
         }
 
-        if(!itemBox->SaveWithUUID(doc, *pRoot))
+        if(!DumpObject(itemBox.Get(), write))
         {
-            return {};
+            return false;
         }
 
         for(size_t i = 0; i < 50; i++)
         {
             auto item = itemBox->GetItems(i);
 
-            if(!item.IsNull() && !item->SaveWithUUID(doc, *pRoot))
+            if(!item.IsNull() && !DumpObject(item.Get(), write))
             {
-                return {};
+                return false;
             }
         }
     }
 
     for(auto box : worldData->GetDemonBoxes())
     {
-        if(!box.IsNull() && !box->SaveWithUUID(doc, *pRoot))
+        if(!box.IsNull() && !DumpObject(box.Get(), write))
         {
-            return {};
+            return false;
         }
         else if(!box.IsNull())
         {
             for(auto demon : box->GetDemons())
             {
-                if(!demon.IsNull() && !demon->SaveWithUUID(doc, *pRoot))
+                if(!demon.IsNull() && !DumpObject(demon.Get(), write))
                 {
-                    return {};
+                    return false;
                 }
                 else if(!demon.IsNull())
                 {
-                    if(!demon->GetCoreStats()->SaveWithUUID(doc, *pRoot))
+                    if(!DumpObject(demon->GetCoreStats().Get(), write))
                     {
-                        return {};
+                        return false;
                     }
 
                     for(auto iSkill : demon->GetInheritedSkills())
                     {
                         if(!iSkill.IsNull() &&
-                            !iSkill->SaveWithUUID(doc, *pRoot))
+                            !DumpObject(iSkill.Get(), write))
                         {
-                            return {};
+                            return false;
                         }
                     }
 
@@ -2206,9 +2199,9 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
                         auto equipment = demon->GetEquippedItems(i);
 
                         if(!equipment.IsNull() &&
-                            !equipment->SaveWithUUID(doc, *pRoot))
+                            !DumpObject(equipment.Get(), write))
                         {
-                            return {};
+                            return false;
                         }
                     }
                 }
@@ -2216,8 +2209,48 @@ libcomp::String AccountManager::DumpAccount(channel::ClientState *state)
         }
     }
 
+    return write("\n</objects>\n");
+}
+
+bool AccountManager::DumpObject(
+    const std::shared_ptr<libcomp::PersistentObject>& obj,
+    const std::function<bool(const std::string&)>& write,
+    const std::list<std::string>& wipeMembers)
+{
+    tinyxml2::XMLDocument doc;
+
+    tinyxml2::XMLElement *pRoot = doc.NewElement("objects");
+    doc.InsertEndChild(pRoot);
+
+    if(!obj || !obj->SaveWithUUID(doc, *pRoot))
+    {
+        return false;
+    }
+
+    auto pElement = pRoot->LastChildElement();
+
+    for(auto& field : wipeMembers)
+    {
+        WipeMember(pElement, field);
+    }
+
+    // Print the object inside its own root element so the indentation is
+    // the same as printing the whole dump at once, then strip the root
     tinyxml2::XMLPrinter printer;
     doc.Print(&printer);
 
-    return printer.CStr();
+    static const std::string rootStart("<objects>");
+    static const std::string rootEnd("\n</objects>\n");
+
+    std::string text(printer.CStr());
+    if(text.size() < rootStart.size() + rootEnd.size() ||
+        0 != text.compare(0, rootStart.size(), rootStart) ||
+        0 != text.compare(text.size() - rootEnd.size(), rootEnd.size(),
+            rootEnd))
+    {
+        return false;
+    }
+
+    return write(text.substr(rootStart.size(), text.size() -
+        rootStart.size() - rootEnd.size()));
 }
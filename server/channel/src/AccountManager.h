@@ -30,9 +30,13 @@
 // channel Includes
 #include "ChannelClientConnection.h"
 
+// Standard C++11 includes
+#include <functional>
+
 namespace libcomp
 {
 class Database;
+class PersistentObject;
 }
 
 namespace objects
@@ -193,12 +197,28 @@ public:
         std::list<std::shared_ptr<objects::CharacterLogin>> removes);
 
     /**
-     * Dump the account and return it. This account data can then be
-     * imported into another server.
+     * Dump the account one object at a time. This account data can then
+     * be imported into another server.
      * @param state ClientState object for the account to dump.
-     * @returns Dump of the account or an empty string on error.
+     * @param write Function called with each piece of the dump in order,
+     *  returning false stops the dump.
+     * @returns true if the entire account was dumped, false on error.
+     */
+    bool DumpAccount(channel::ClientState *state,
+        const std::function<bool(const std::string&)>& write);
+
+    /**
+     * Serialize a single object for an account dump and write it out.
+     * Objects written one after another between "<objects>" and
+     * "\n</objects>\n" form the same XML as a dump printed in one DOM.
+     * @param obj Object to serialize.
+     * @param write Function to write the serialized object to.
+     * @param wipeMembers Names of member fields to leave out of the dump.
+     * @returns true if the object was written, false on error.
      */
-    libcomp::String DumpAccount(channel::ClientState *state);
+    bool DumpObject(const std::shared_ptr<libcomp::PersistentObject>& obj,
+        const std::function<bool(const std::string&)>& write,
+        const std::list<std::string>& wipeMembers = {});
 
 private:
     /**
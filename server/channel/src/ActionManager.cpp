@@ -112,6 +112,7 @@
 #include "EventManager.h"
 #include "ManagerConnection.h"
 #include "MatchManager.h"
+#include "ServerMetrics.h"
 #include "TokuseiManager.h"
 #include "ZoneManager.h"
 
@@ -1251,8 +1252,8 @@ bool ActionManager::AddRemoveItems(ActionContext& ctx)
 
             auto lobbyDB = server->GetLobbyDatabase();
 
-            auto postItems = objects::PostItem::LoadPostItemListByAccount(
-                lobbyDB, state->GetAccountUID());
+            // Reload to count items added from other channels
+            auto postItems = state->GetPostItems(lobbyDB, true);
 
             auto dbChanges = libcomp::DatabaseChangeSet::Create();
             for(auto pair : adds)
@@ -1283,6 +1284,8 @@ bool ActionManager::AddRemoveItems(ActionContext& ctx)
 
                 return false;
             }
+
+            state->InvalidatePostItems();
         }
         break;
     case objects::ActionAddRemoveItems::Mode_t::CULTURE_PICKUP:
@@ -2228,7 +2231,7 @@ bool ActionManager::SetNPCState(ActionContext& ctx)
                 p.WriteS32Little(oNPCState->GetEntityID());
                 p.WriteU8(act->GetState());
 
-                ChannelClientConnection::BroadcastPacket(clients, p);
+                zoneManager->BroadcastPacket(clients, p);
             }
         }
     }
@@ -3659,7 +3662,8 @@ bool ActionManager::RunScript(ActionContext& ctx)
     auto script = serverDataManager->GetScript(act->GetScriptID());
     if(script && script->Type.ToLower() == "actioncustom")
     {
-        auto engine = std::make_shared<libcomp::ScriptEngine>();
+        auto engine = ServerMetrics::CreateScriptEngine(
+            ServerMetrics::ScriptEngineType_t::ACTION);
 
         // Bind some defaults
         engine->Using<AllyState>();
@@ -30,6 +30,7 @@
 #include <Constants.h>
 #include <DefinitionManager.h>
 #include <Log.h>
+#include <Packet.h>
 #include <Randomizer.h>
 #include <ServerConstants.h>
 
@@ -117,7 +118,8 @@ namespace libcomp
 }
 
 ActiveEntityState::ActiveEntityState() : mCurrentZone(0),
-    mEffectsActive(false), mAlive(true), mInitialCalc(false),
+    mStatusEffectsVersion(0), mStatusEffectDataVersion(0),
+    mStatusEffectDataTime(0), mEffectsActive(false), mAlive(true), mInitialCalc(false),
     mCloaked(false), mLastRefresh(0), mNextRegenSync(0), mNextUpkeep(0),
     mNextActivatedAbilityID(1)
 {
@@ -838,6 +840,12 @@ const std::unordered_map<uint32_t, std::shared_ptr<objects::StatusEffect>>&
     return mStatusEffects;
 }
 
+size_t ActiveEntityState::GetStatusEffectCount()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mStatusEffects.size();
+}
+
 std::list<std::shared_ptr<objects::StatusEffect>>
     ActiveEntityState::GetStatusEffectsList()
 {
@@ -878,6 +886,7 @@ void ActiveEntityState::SetStatusEffects(
     libcomp::DefinitionManager* definitionManager)
 {
     std::lock_guard<std::mutex> lock(mLock);
+    mStatusEffectsVersion++;
     mStatusEffects.clear();
     mStatusEffectDefs.clear();
     mNRAShields.clear();
@@ -913,6 +922,7 @@ std::set<uint32_t> ActiveEntityState::AddStatusEffects(const StatusEffectChanges
     }
 
     std::lock_guard<std::mutex> lock(mLock);
+    mStatusEffectsVersion++;
     for(auto ePair : effects)
     {
         bool isReplace = ePair.second.IsReplace;
@@ -1335,6 +1345,7 @@ std::set<uint32_t> ActiveEntityState::ExpireStatusEffects(
     const std::set<uint32_t>& effectTypes)
 {
     std::lock_guard<std::mutex> lock(mLock);
+    mStatusEffectsVersion++;
 
     std::set<uint32_t> removeEffects;
     for(uint32_t effectType : effectTypes)
@@ -1438,6 +1449,7 @@ void ActiveEntityState::SetStatusEffectsActive(bool activate,
     }
 
     std::lock_guard<std::mutex> lock(mLock);
+    mStatusEffectsVersion++;
     mEffectsActive = activate;
     if(activate)
     {
@@ -1649,6 +1661,11 @@ uint8_t ActiveEntityState::PopEffectTicks(uint32_t time, int32_t& hpTDamage,
             }
 
             // Remove effects that have ended
+            if(pair.second.size() > 0)
+            {
+                mStatusEffectsVersion++;
+            }
+
             RemoveStatusEffects(pair.second);
             for(auto effectType : pair.second)
             {
@@ -1769,6 +1786,64 @@ std::list<std::pair<std::shared_ptr<objects::StatusEffect>, uint32_t>>
     return result;
 }
 
+void ActiveEntityState::WriteStatusEffectData(libcomp::Packet& p)
+{
+    uint32_t now = (uint32_t)std::time(0);
+
+    // Grab the version before reading the effects so a change made while
+    // building the data cannot be missed
+    uint32_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        version = mStatusEffectsVersion;
+
+        // Effect times are relative to the current time so only empty
+        // data can be used past the second it was built in
+        if(mStatusEffectData.size() > 0 &&
+            mStatusEffectDataVersion == version &&
+            (mStatusEffects.size() == 0 || mStatusEffectDataTime == now))
+        {
+            p.WriteArray(&mStatusEffectData[0],
+                (uint32_t)mStatusEffectData.size());
+
+            return;
+        }
+    }
+
+    auto statusEffects = GetCurrentStatusEffectStates(now);
+
+    libcomp::Packet data;
+    data.WriteU32Little(static_cast<uint32_t>(statusEffects.size()));
+    for(auto ePair : statusEffects)
+    {
+        data.WriteU32Little(ePair.first->GetEffect());
+        data.WriteS32Little((int32_t)ePair.second);
+        data.WriteU8(ePair.first->GetStack());
+    }
+
+    p.WriteArray(data.ConstData(), data.Size());
+
+    std::lock_guard<std::mutex> lock(mLock);
+    mStatusEffectData.assign(data.ConstData(), data.ConstData() +
+        data.Size());
+    mStatusEffectDataVersion = version;
+    mStatusEffectDataTime = now;
+}
+
+int64_t ActiveEntityState::GetStatusEffectDataKey()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    uint32_t time = mStatusEffects.size() > 0 ? (uint32_t)std::time(0) : 0;
+
+    return (int64_t)(((uint64_t)mStatusEffectsVersion << 32) | time);
+}
+
+EntityPacketCache* ActiveEntityState::GetShowPacketCache()
+{
+    return &mShowPacketCache;
+}
+
 std::set<int32_t> ActiveEntityState::GetOpponentIDs() const
 {
     return mOpponentIDs;
@@ -1850,6 +1925,8 @@ bool ActiveEntityState::GetNRAShield(uint8_t nraIdx, CorrectTbl type,
                 uint8_t newStack = (uint8_t)(effect->GetStack() - 1);
                 effect->SetStack(newStack);
                 expire = newStack == 0;
+
+                mStatusEffectsVersion++;
             }
         }
     }
@@ -37,6 +37,9 @@
 #include <StatusEffect.h>
 #include <TokuseiCondition.h>
 
+// channel Includes
+#include "EntityPacketCache.h"
+
 // Standard C++11 includes
 #include <map>
 
@@ -100,6 +103,7 @@ const uint8_t STATUS_IGNORE = 0x80;
 namespace libcomp
 {
 class DefinitionManager;
+class Packet;
 }
 
 namespace objects
@@ -595,6 +599,12 @@ public:
     const std::unordered_map<uint32_t,
         std::shared_ptr<objects::StatusEffect>>& GetStatusEffects() const;
 
+    /**
+     * Get the number of status effects currently on the entity
+     * @return Number of current status effects
+     */
+    size_t GetStatusEffectCount();
+
     /**
      * Get the list of current status effects
      * @return List of status effects
@@ -749,6 +759,30 @@ public:
     std::list<std::pair<std::shared_ptr<objects::StatusEffect>, uint32_t>>
         GetCurrentStatusEffectStates(uint32_t now = 0);
 
+    /**
+     * Write the status effect section of entity data packets (effect count
+     * followed by the type, expiration and stack of each effect) to the
+     * supplied packet. The serialized section is cached and reused until
+     * the status effects change or, if any are active, the current second
+     * ends. Reuse is not counted in the EntityPacketCache statistics
+     * so a show packet built around this section is only counted once.
+     * @param p Packet to write the status effect data to
+     */
+    void WriteStatusEffectData(libcomp::Packet& p);
+
+    /**
+     * Get a key that changes whenever the data written by
+     * @ref WriteStatusEffectData would change.
+     * @return Status effect data key
+     */
+    int64_t GetStatusEffectDataKey();
+
+    /**
+     * Get the cache of the packet used to show the entity to other clients
+     * @return Pointer to the show packet cache
+     */
+    EntityPacketCache* GetShowPacketCache();
+
     /**
      * Get the entity IDs of opponents this entity is in combat against.
      * @return Set of opponent entity IDs
@@ -1086,6 +1120,23 @@ protected:
     std::unordered_map<uint32_t,
         libcomp::EnumMap<CorrectTbl, std::set<uint8_t>>> mNRAShields;
 
+    /// Incremented any time the status effects change so cached status
+    /// effect packet data is known to be out of date
+    uint32_t mStatusEffectsVersion;
+
+    /// Serialized status effect packet data written by
+    /// WriteStatusEffectData
+    std::vector<char> mStatusEffectData;
+
+    /// Status effects version the cached status effect data was built from
+    uint32_t mStatusEffectDataVersion;
+
+    /// System time the cached status effect data was built at
+    uint32_t mStatusEffectDataTime;
+
+    /// Cached packet used to show the entity to other clients
+    EntityPacketCache mShowPacketCache;
+
     /// true if the status effects have been activated for the current zone
     bool mEffectsActive;
 
@@ -0,0 +1,190 @@
+/**
+ * @file server/channel/src/BazaarPriceIndex.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Rolling index of recent bazaar sale prices used for price
+ *  suggestions.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BazaarPriceIndex.h"
+
+// libcomp Includes
+#include <Database.h>
+#include <Log.h>
+#include <ServerDataManager.h>
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <set>
+
+// object Includes
+#include <BazaarData.h>
+#include <BazaarItem.h>
+#include <ChannelConfig.h>
+#include <ServerZone.h>
+
+// channel Includes
+#include "ChannelServer.h"
+
+using namespace channel;
+
+BazaarPriceIndex::BazaarPriceIndex(const std::weak_ptr<ChannelServer>& server)
+    : mServer(server), mWindowSize(0), mMinSamples(0)
+{
+    auto config = std::dynamic_pointer_cast<objects::ChannelConfig>(
+        server.lock()->GetConfig());
+    mWindowSize = (size_t)config->GetBazaarPriceSamples();
+    mMinSamples = std::max(config->GetBazaarPriceMinSamples(), (uint32_t)1);
+}
+
+size_t BazaarPriceIndex::Rebuild()
+{
+    if(!mWindowSize)
+    {
+        return 0;
+    }
+
+    auto server = mServer.lock();
+    auto serverDataManager = server->GetServerDataManager();
+    auto worldDB = server->GetWorldDatabase();
+
+    std::set<uint32_t> zoneIDs;
+    for(auto zonePair : serverDataManager->GetAllZoneIDs())
+    {
+        for(uint32_t dynamicMapID : zonePair.second)
+        {
+            auto zoneData = serverDataManager->GetZoneData(zonePair.first,
+                dynamicMapID);
+            if(zoneData && zoneData->BazaarsCount() > 0)
+            {
+                zoneIDs.insert(zonePair.first);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mWindows.clear();
+    }
+
+    // Sold items stay in their market slot until the seller collects the
+    // macca so they are the most recent sales still on record. Only one
+    // market's items are loaded at a time rather than every bazaar item.
+    size_t count = 0;
+    for(uint32_t zoneID : zoneIDs)
+    {
+        for(auto market : objects::BazaarData::LoadBazaarDataListByZone(
+            worldDB, zoneID))
+        {
+            for(auto& itemRef : market->GetItems())
+            {
+                auto bItem = !itemRef.IsNull() ? itemRef.Get(worldDB)
+                    : nullptr;
+                if(bItem && bItem->GetSold() && bItem->GetStackSize() > 0)
+                {
+                    std::lock_guard<std::mutex> lock(mLock);
+                    AddPrice(bItem->GetType(), bItem->GetCost() /
+                        (int32_t)bItem->GetStackSize());
+                    count++;
+                }
+            }
+        }
+    }
+
+    size_t itemTypes = 0;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        itemTypes = mWindows.size();
+    }
+
+    LogBazaarDebug([&]()
+    {
+        return libcomp::String("Loaded %1 bazaar sale(s) across %2 item"
+            " type(s) into the price index\n").Arg(count).Arg(itemTypes);
+    });
+
+    return count;
+}
+
+void BazaarPriceIndex::RecordSale(const std::shared_ptr<
+    objects::BazaarItem>& bItem)
+{
+    if(!mWindowSize || !bItem || bItem->GetStackSize() == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    AddPrice(bItem->GetType(), bItem->GetCost() /
+        (int32_t)bItem->GetStackSize());
+}
+
+bool BazaarPriceIndex::GetSummary(uint32_t itemType,
+    BazaarPriceSummary& summary)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mWindows.find(itemType);
+    if(it == mWindows.end() || it->second.Summary.Samples < mMinSamples)
+    {
+        return false;
+    }
+
+    summary = it->second.Summary;
+
+    return true;
+}
+
+void BazaarPriceIndex::AddPrice(uint32_t itemType, int32_t price)
+{
+    auto& window = mWindows[itemType];
+    auto& sorted = window.Sorted;
+    if(window.Prices.size() < mWindowSize)
+    {
+        window.Prices.push_back(price);
+    }
+    else
+    {
+        // Drop the oldest price from the sorted copy
+        int32_t oldest = window.Prices[window.Next];
+        sorted.erase(std::lower_bound(sorted.begin(), sorted.end(),
+            oldest));
+
+        window.Prices[window.Next] = price;
+    }
+
+    window.Next = (window.Next + 1) % mWindowSize;
+
+    sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), price),
+        price);
+
+    size_t count = sorted.size();
+
+    auto& summary = window.Summary;
+    summary.Median = (count % 2) ? sorted[count / 2]
+        : (int32_t)(((int64_t)sorted[count / 2 - 1] +
+            (int64_t)sorted[count / 2]) / 2);
+    summary.Low = sorted[(count - 1) / 4];
+    summary.High = sorted[(count - 1) * 3 / 4];
+    summary.Samples = (uint32_t)count;
+    summary.Volume++;
+}
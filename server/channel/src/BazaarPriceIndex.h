@@ -0,0 +1,152 @@
+/**
+ * @file server/channel/src/BazaarPriceIndex.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Rolling index of recent bazaar sale prices used for price
+ *  suggestions.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_BAZAARPRICEINDEX_H
+#define SERVER_CHANNEL_SRC_BAZAARPRICEINDEX_H
+
+// Standard C++11 includes
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace objects
+{
+class BazaarItem;
+}
+
+namespace channel
+{
+
+class ChannelServer;
+
+/**
+ * Summary of recent bazaar sale prices for one item type. All prices are
+ * per single item in the stack.
+ */
+struct BazaarPriceSummary
+{
+    /// Median sale price
+    int32_t Median = 0;
+
+    /// 25th percentile sale price
+    int32_t Low = 0;
+
+    /// 75th percentile sale price
+    int32_t High = 0;
+
+    /// Number of sales the summary was calculated from
+    uint32_t Samples = 0;
+
+    /// Total number of sales recorded for the item type
+    uint64_t Volume = 0;
+};
+
+/**
+ * Per item type window of the most recent bazaar sale prices. Summaries
+ * are updated from a sorted copy of each window whenever a sale is
+ * recorded so price suggestions can be read without sorting anything.
+ */
+class BazaarPriceIndex
+{
+public:
+    /**
+     * Create a new bazaar price index
+     * @param server Pointer back to the channel server this belongs to
+     */
+    BazaarPriceIndex(const std::weak_ptr<ChannelServer>& server);
+
+    /**
+     * Rebuild the index from the sold bazaar items still stored in the
+     * world database. Markets are read one at a time so the whole bazaar
+     * is never held in memory.
+     * @return Number of sales loaded
+     */
+    size_t Rebuild();
+
+    /**
+     * Record a completed bazaar sale
+     * @param bItem Pointer to the bazaar item that was sold
+     */
+    void RecordSale(const std::shared_ptr<objects::BazaarItem>& bItem);
+
+    /**
+     * Get the summary of recent sale prices for an item type
+     * @param itemType Item type to retrieve the summary for
+     * @param summary Output parameter to set the summary on
+     * @return true if enough sales have been recorded to suggest a price
+     */
+    bool GetSummary(uint32_t itemType, BazaarPriceSummary& summary);
+
+private:
+    /**
+     * Recent sale prices of one item type
+     */
+    struct Window
+    {
+        /// Ring buffer of per item sale prices
+        std::vector<int32_t> Prices;
+
+        /// Index in Prices the next sale will be written to
+        size_t Next = 0;
+
+        /// Prices in ascending order, kept sorted as sales are added so
+        /// the summary never needs a full sort
+        std::vector<int32_t> Sorted;
+
+        /// Summary of the current prices
+        BazaarPriceSummary Summary;
+    };
+
+    /**
+     * Add a per item sale price to the window of an item type and
+     * recalculate its summary. The server lock must be held when calling
+     * this.
+     * @param itemType Item type that was sold
+     * @param price Sale price of a single item
+     */
+    void AddPrice(uint32_t itemType, int32_t price);
+
+    /// Pointer to the channel server
+    std::weak_ptr<ChannelServer> mServer;
+
+    /// Price windows by item type
+    std::unordered_map<uint32_t, Window> mWindows;
+
+    /// Number of recent sales to keep per item type, 0 disables the index
+    size_t mWindowSize;
+
+    /// Minimum number of sales required before suggesting a price
+    uint32_t mMinSamples;
+
+    /// Server lock for the price windows
+    std::mutex mLock;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_BAZAARPRICEINDEX_H
@@ -27,13 +27,92 @@
 #include "ChannelClientConnection.h"
 
 #include "ChannelServer.h"
+#include "PacketFanOut.h"
+
+// Standard C++11 Includes
+#include <unordered_map>
 
 using namespace channel;
 
+namespace
+{
+
+/// Number of ClientPacketBatch scopes active on the current thread
+thread_local int gBatchDepth = 0;
+
+/// Connections written to on the current thread since the outermost
+/// ClientPacketBatch started that still need to be flushed
+thread_local std::unordered_map<ChannelClientConnection*,
+    std::shared_ptr<ChannelClientConnection>> gDeferred;
+
+/// Server time the first connection in gDeferred was deferred at or 0 if
+/// no connection is deferred
+thread_local uint64_t gDeferredSince = 0;
+
+/// Queued payload bytes that force a write, 0 disables deferring writes
+std::atomic<uint32_t> gFlushThreshold(0);
+
+/// Maximum time in microseconds a deferred packet may wait to be written
+std::atomic<uint32_t> gFlushMaxDelay(2000);
+
+/// Number of writes made to all clients
+std::atomic<uint64_t> gTotalWriteCount(0);
+
+/// Number of packet payload bytes written to all clients
+std::atomic<uint64_t> gTotalBytesWritten(0);
+
+/// Number of flushes that were folded into a later write
+std::atomic<uint64_t> gDeferredFlushCount(0);
+
+/// Number of packets copied to be sent to more than one client
+std::atomic<uint64_t> gPacketCopyCount(0);
+
+/// Number of packet bytes copied to be sent to more than one client
+std::atomic<uint64_t> gPacketCopyBytes(0);
+
+/// Number of packet copies avoided by the last client taking the packet
+std::atomic<uint64_t> gPacketCopiesAvoided(0);
+
+/// Largest number of clients a single packet has been sent to
+std::atomic<uint64_t> gLargestFanOut(0);
+
+/// Count a packet copy made for another client
+void RecordCopy(const libcomp::Packet& packet)
+{
+    gPacketCopyCount++;
+    gPacketCopyBytes += packet.Size();
+}
+
+/// Count a packet handed to one client of a fan-out, either a copy or
+/// the original packet the last client takes without copying
+void RecordFanOutPacket(const libcomp::Packet& packet, bool copy)
+{
+    if(copy)
+    {
+        RecordCopy(packet);
+    }
+    else
+    {
+        gPacketCopiesAvoided++;
+    }
+}
+
+/// Raise the largest fan-out if a packet is being sent to more clients
+void RecordFanOut(size_t clientCount)
+{
+    uint64_t count = (uint64_t)clientCount;
+    uint64_t largest = gLargestFanOut;
+    while(count > largest &&
+        !gLargestFanOut.compare_exchange_weak(largest, count));
+}
+
+} // namespace
+
 ChannelClientConnection::ChannelClientConnection(asio::ip::tcp::socket& socket,
     const std::shared_ptr<libcomp::Crypto::DiffieHellman>& diffieHellman) :
     ChannelConnection(socket, diffieHellman), mClientState(
-        std::shared_ptr<ClientState>(new ClientState)), mTimeout(0)
+        std::shared_ptr<ClientState>(new ClientState)), mTimeout(0),
+    mQueuedBytes(0), mDeferredSince(0), mWriteCount(0), mBytesWritten(0)
 {
 }
 
@@ -62,9 +141,107 @@ void ChannelClientConnection::Kill()
     Close();
 }
 
+void ChannelClientConnection::SendPacket(libcomp::Packet& packet,
+    bool closeConnection)
+{
+    QueuePacket(packet);
+
+    if(closeConnection || !DeferFlush())
+    {
+        Flush(closeConnection);
+    }
+}
+
+void ChannelClientConnection::SendPacketCopy(libcomp::Packet& packet,
+    bool closeConnection)
+{
+    QueuePacketCopy(packet);
+
+    if(closeConnection || !DeferFlush())
+    {
+        Flush(closeConnection);
+    }
+}
+
+void ChannelClientConnection::QueuePacket(libcomp::Packet& packet)
+{
+    // Count the packet first in case queueing takes its data
+    Queued(packet);
+    libcomp::ChannelConnection::QueuePacket(packet);
+}
+
+void ChannelClientConnection::QueuePacketCopy(libcomp::Packet& packet)
+{
+    RecordCopy(packet);
+    Queued(packet);
+    libcomp::ChannelConnection::QueuePacketCopy(packet);
+}
+
+void ChannelClientConnection::FlushOutgoing(bool closeConnection)
+{
+    if(closeConnection || !DeferFlush())
+    {
+        Flush(closeConnection);
+    }
+}
+
+uint64_t ChannelClientConnection::GetWriteCount() const
+{
+    return mWriteCount;
+}
+
+uint64_t ChannelClientConnection::GetBytesWritten() const
+{
+    return mBytesWritten;
+}
+
+void ChannelClientConnection::SetFlushPolicy(uint32_t threshold,
+    uint32_t maxDelay)
+{
+    gFlushThreshold = threshold;
+    gFlushMaxDelay = maxDelay;
+}
+
+uint64_t ChannelClientConnection::GetTotalWriteCount()
+{
+    return gTotalWriteCount;
+}
+
+uint64_t ChannelClientConnection::GetTotalBytesWritten()
+{
+    return gTotalBytesWritten;
+}
+
+uint64_t ChannelClientConnection::GetDeferredFlushCount()
+{
+    return gDeferredFlushCount;
+}
+
+uint64_t ChannelClientConnection::GetPacketCopyCount()
+{
+    return gPacketCopyCount;
+}
+
+uint64_t ChannelClientConnection::GetPacketCopyBytes()
+{
+    return gPacketCopyBytes;
+}
+
+uint64_t ChannelClientConnection::GetPacketCopiesAvoided()
+{
+    return gPacketCopiesAvoided;
+}
+
+uint64_t ChannelClientConnection::GetLargestFanOut()
+{
+    return gLargestFanOut;
+}
+
 void ChannelClientConnection::BroadcastPacket(const std::list<std::shared_ptr<
     ChannelClientConnection>>& clients, libcomp::Packet& packet, bool queue)
 {
+    RecordFanOut(clients.size());
+
     if(queue)
     {
         for(auto client : clients)
@@ -74,19 +251,34 @@ void ChannelClientConnection::BroadcastPacket(const std::list<std::shared_ptr<
     }
     else
     {
-        std::list<std::shared_ptr<libcomp::TcpConnection>> connections;
+        // Send through each connection so the writes join any active batch
+        // and count toward the flush policy
         for(auto client : clients)
         {
-            connections.push_back(client);
+            client->SendPacketCopy(packet);
         }
-
-        libcomp::TcpConnection::BroadcastPacket(connections, packet);
     }
 }
 
+void ChannelClientConnection::QueuePacketToAll(const std::list<
+    std::shared_ptr<ChannelClientConnection>>& clients,
+    libcomp::Packet& packet)
+{
+    RecordFanOut(clients.size());
+
+    FanOutPacket(clients, packet, [](const std::shared_ptr<
+        ChannelClientConnection>& client, libcomp::Packet& p, bool copy)
+    {
+        RecordFanOutPacket(p, copy);
+        client->QueuePacket(p);
+    });
+}
+
 void ChannelClientConnection::BroadcastPackets(const std::list<std::shared_ptr<
     ChannelClientConnection>>& clients, std::list<libcomp::Packet>& packets)
 {
+    RecordFanOut(clients.size());
+
     for(auto client : clients)
     {
         for(auto& packet : packets)
@@ -112,24 +304,140 @@ void ChannelClientConnection::SendRelativeTimePacket(
     libcomp::Packet& packet, const RelativeTimeMap& timeMap,
     bool queue)
 {
-    for(auto client : clients)
+    RecordFanOut(clients.size());
+
+    // Copies are made before the times are written so every client
+    // starts from the original packet
+    FanOutPacket(clients, packet, [&timeMap, queue](const std::shared_ptr<
+        ChannelClientConnection>& client, libcomp::Packet& p, bool copy)
     {
-        libcomp::Packet pCopy(packet);
+        RecordFanOutPacket(p, copy);
 
         auto state = client->GetClientState();
         for(auto tPair : timeMap)
         {
-            pCopy.Seek(tPair.first);
-            pCopy.WriteFloat(state->ToClientTime(tPair.second));
+            p.Seek(tPair.first);
+            p.WriteFloat(state->ToClientTime(tPair.second));
         }
 
         if(queue)
         {
-            client->QueuePacket(pCopy);
+            client->QueuePacket(p);
         }
         else
         {
-            client->SendPacket(pCopy);
+            client->SendPacket(p);
         }
+    });
+}
+
+void ChannelClientConnection::Queued(const libcomp::Packet& packet)
+{
+    mQueuedBytes += packet.Size();
+}
+
+bool ChannelClientConnection::DeferFlush()
+{
+    uint32_t threshold = gFlushThreshold;
+    if(!threshold || !ClientPacketBatch::IsActive() ||
+        mQueuedBytes >= threshold)
+    {
+        return false;
+    }
+
+    // Write anything on the thread that has waited too long, even for
+    // clients that have not been sent anything since
+    ClientPacketBatch::FlushOverdue();
+
+    uint64_t now = ChannelServer::GetServerTime();
+    uint64_t since = mDeferredSince;
+    if(!since)
+    {
+        mDeferredSince = now;
+    }
+    else if(now - since >= (uint64_t)gFlushMaxDelay)
+    {
+        return false;
+    }
+
+    ClientPacketBatch::Defer(std::dynamic_pointer_cast<
+        ChannelClientConnection>(shared_from_this()));
+    gDeferredFlushCount++;
+
+    return true;
+}
+
+void ChannelClientConnection::Flush(bool closeConnection)
+{
+    mDeferredSince = 0;
+
+    uint32_t bytes = mQueuedBytes.exchange(0);
+    if(bytes)
+    {
+        mWriteCount++;
+        mBytesWritten += bytes;
+        gTotalWriteCount++;
+        gTotalBytesWritten += bytes;
+    }
+
+    libcomp::ChannelConnection::FlushOutgoing(closeConnection);
+}
+
+ClientPacketBatch::ClientPacketBatch()
+{
+    gBatchDepth++;
+}
+
+ClientPacketBatch::~ClientPacketBatch()
+{
+    if(--gBatchDepth > 0)
+    {
+        return;
+    }
+
+    FlushAll();
+}
+
+bool ClientPacketBatch::IsActive()
+{
+    return gBatchDepth > 0;
+}
+
+void ClientPacketBatch::FlushOverdue()
+{
+    uint64_t since = gDeferredSince;
+    if(since && ChannelServer::GetServerTime() - since >=
+        (uint64_t)gFlushMaxDelay)
+    {
+        FlushAll();
+    }
+}
+
+void ClientPacketBatch::Defer(const std::shared_ptr<
+    ChannelClientConnection>& client)
+{
+    if(client)
+    {
+        if(gDeferred.empty())
+        {
+            gDeferredSince = ChannelServer::GetServerTime();
+        }
+
+        gDeferred[client.get()] = client;
+    }
+}
+
+void ClientPacketBatch::FlushAll()
+{
+    // Flushing can not defer again but swap the set out first so nothing
+    // is added while iterating
+    std::unordered_map<ChannelClientConnection*,
+        std::shared_ptr<ChannelClientConnection>> deferred;
+    deferred.swap(gDeferred);
+    gDeferredSince = 0;
+
+    for(auto& pair : deferred)
+    {
+        pair.second->Flush();
     }
 }
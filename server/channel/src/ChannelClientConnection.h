@@ -33,13 +33,24 @@
 // libcomp Includes
 #include <ChannelConnection.h>
 
+// Standard C++11 includes
+#include <atomic>
+
 namespace channel
 {
 
 typedef std::unordered_map<uint32_t, uint64_t> RelativeTimeMap;
 
 /**
- * Represents a connection to the game client.
+ * Represents a connection to the game client. The send, queue and flush
+ * functions below hide the libcomp::TcpConnection versions rather than
+ * overriding them, so only calls made through a ChannelClientConnection
+ * pointer count toward the flush policy or join a @ref ClientPacketBatch.
+ * Calls made through a libcomp::TcpConnection pointer still write
+ * immediately (along with everything queued so far, so packet order is
+ * kept), so packet parsers cast the connection they are given before
+ * sending and broadcasts to clients go through the static functions of
+ * this class rather than libcomp::TcpConnection::BroadcastPacket.
  */
 class ChannelClientConnection : public libcomp::ChannelConnection
 {
@@ -84,6 +95,114 @@ public:
      */
     void Kill();
 
+    /**
+     * Send a packet to the client. While a @ref ClientPacketBatch is
+     * active on the calling thread the packet is only queued and written
+     * along with everything else queued for the client when the batch ends.
+     * @param packet Packet to send
+     * @param closeConnection true if the connection should be closed once
+     *  the packet is sent, which always writes immediately
+     */
+    void SendPacket(libcomp::Packet& packet, bool closeConnection = false);
+
+    /**
+     * Send a copy of a packet to the client, deferring the write like
+     * @ref SendPacket.
+     * @param packet Packet to copy and send
+     * @param closeConnection true if the connection should be closed once
+     *  the packet is sent, which always writes immediately
+     */
+    void SendPacketCopy(libcomp::Packet& packet, bool closeConnection = false);
+
+    /**
+     * Queue a packet to be written on the next flush.
+     * @param packet Packet to queue
+     */
+    void QueuePacket(libcomp::Packet& packet);
+
+    /**
+     * Queue a copy of a packet to be written on the next flush.
+     * @param packet Packet to copy and queue
+     */
+    void QueuePacketCopy(libcomp::Packet& packet);
+
+    /**
+     * Write all queued packets to the client. While a
+     * @ref ClientPacketBatch is active on the calling thread the write is
+     * deferred until the batch ends unless the queued packets have reached
+     * the configured flush threshold or have waited longer than the
+     * configured maximum delay.
+     * @param closeConnection true if the connection should be closed once
+     *  the packets are sent, which always writes immediately
+     */
+    void FlushOutgoing(bool closeConnection = false);
+
+    /**
+     * Get the number of writes made to the client.
+     * @return Number of writes made to the client
+     */
+    uint64_t GetWriteCount() const;
+
+    /**
+     * Get the number of packet payload bytes written to the client.
+     * @return Number of packet payload bytes written to the client
+     */
+    uint64_t GetBytesWritten() const;
+
+    /**
+     * Set how long writes may be deferred by a @ref ClientPacketBatch.
+     * @param threshold Number of queued payload bytes that forces a write,
+     *  0 disables deferring writes entirely
+     * @param maxDelay Maximum time in microseconds the first deferred
+     *  packet may wait before forcing a write
+     */
+    static void SetFlushPolicy(uint32_t threshold, uint32_t maxDelay);
+
+    /**
+     * Get the number of writes made to all clients.
+     * @return Number of writes made to all clients
+     */
+    static uint64_t GetTotalWriteCount();
+
+    /**
+     * Get the number of packet payload bytes written to all clients.
+     * @return Number of packet payload bytes written to all clients
+     */
+    static uint64_t GetTotalBytesWritten();
+
+    /**
+     * Get the number of flushes that were folded into a later write.
+     * @return Number of flushes that were deferred
+     */
+    static uint64_t GetDeferredFlushCount();
+
+    /**
+     * Get the number of packets copied to be sent to more than one client.
+     * @return Number of packet copies made
+     */
+    static uint64_t GetPacketCopyCount();
+
+    /**
+     * Get the number of packet bytes copied to be sent to more than one
+     * client.
+     * @return Number of packet bytes copied
+     */
+    static uint64_t GetPacketCopyBytes();
+
+    /**
+     * Get the number of packet copies avoided by the last client of a
+     * @ref QueuePacketToAll or @ref SendRelativeTimePacket call taking
+     * the packet itself.
+     * @return Number of packet copies avoided
+     */
+    static uint64_t GetPacketCopiesAvoided();
+
+    /**
+     * Get the largest number of clients a single packet has been sent to.
+     * @return Highest number of clients sent one packet
+     */
+    static uint64_t GetLargestFanOut();
+
     /**
      * Broadcast the supplied packet to each client connection in the list.
      * @param clients List of client connections to send the packet to
@@ -95,6 +214,16 @@ public:
         ChannelClientConnection>>& clients, libcomp::Packet& packet,
         bool queue = false);
 
+    /**
+     * Queue a packet for each client connection in the list. Each client
+     * but the last queues a copy and the last takes the packet data
+     * itself, so the packet must not be used once this returns.
+     * @param clients List of client connections to queue the packet for
+     * @param packet Packet to queue for the supplied clients
+     */
+    static void QueuePacketToAll(const std::list<std::shared_ptr<
+        ChannelClientConnection>>& clients, libcomp::Packet& packet);
+
     /**
      * Broadcast the supplied list of packets to each client connection in the list.
      * @param clients List of client connections to send the packet to
@@ -113,6 +242,9 @@ public:
     /**
      * Send (or queue) a packet to a list of client connections. Server
      * tick times are converted to relative client times before sending.
+     * Each client but the last is sent a copy and the last takes the
+     * packet data itself, so the packet must not be used once this
+     * returns.
      * @param clients List of client connections to send the packet to
      * @param packet Packet to send to the supplied clients
      * @param timeMap Map of packet positions to server times to transform
@@ -125,12 +257,96 @@ public:
         bool queue = false);
 
 private:
+    friend class ClientPacketBatch;
+
+    /**
+     * Count a packet that was just queued for the client.
+     * @param packet Packet that was queued
+     */
+    void Queued(const libcomp::Packet& packet);
+
+    /**
+     * Defer writing the queued packets until the active batch ends.
+     * @return true if the write was deferred, false if it must happen now
+     */
+    bool DeferFlush();
+
+    /**
+     * Write all queued packets to the client immediately.
+     * @param closeConnection true if the connection should be closed once
+     *  the packets are sent
+     */
+    void Flush(bool closeConnection = false);
+
     /// State of the client
     std::shared_ptr<ClientState> mClientState;
 
     /// Server timestamp used to disconnect the client should it pass
     /// without refreshing beforehand.
     uint64_t mTimeout;
+
+    /// Payload bytes queued since the last write
+    std::atomic<uint32_t> mQueuedBytes;
+
+    /// Server time the first deferred packet was queued at or 0 if the
+    /// queued packets have not been deferred
+    std::atomic<uint64_t> mDeferredSince;
+
+    /// Number of writes made to the client
+    std::atomic<uint64_t> mWriteCount;
+
+    /// Number of packet payload bytes written to the client
+    std::atomic<uint64_t> mBytesWritten;
+};
+
+/**
+ * Scope during which writes to client connections made on the current
+ * thread are coalesced. Handlers and the server tick often send several
+ * packets to the same client in a row; each connection touched inside the
+ * scope is written to once when the outermost scope ends instead of once
+ * per packet. Scopes may be nested.
+ */
+class ClientPacketBatch
+{
+public:
+    /**
+     * Start a batch on the current thread.
+     */
+    ClientPacketBatch();
+
+    /**
+     * End the batch, writing to every deferred connection if this was the
+     * outermost batch on the current thread.
+     */
+    ~ClientPacketBatch();
+
+    /**
+     * Check if a batch is active on the current thread.
+     * @return true if a batch is active
+     */
+    static bool IsActive();
+
+    /**
+     * Write to every connection deferred on the current thread if the
+     * first of them has waited longer than the configured maximum delay.
+     * This is also checked each time a write is deferred, so long running
+     * work that sends nothing should call this between steps.
+     */
+    static void FlushOverdue();
+
+private:
+    friend class ChannelClientConnection;
+
+    /**
+     * Write to a connection when the outermost batch ends.
+     * @param client Pointer to the connection to write to
+     */
+    static void Defer(const std::shared_ptr<ChannelClientConnection>& client);
+
+    /**
+     * Write to every connection deferred on the current thread.
+     */
+    static void FlushAll();
 };
 
 static inline ClientState* state(
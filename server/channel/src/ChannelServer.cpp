@@ -45,10 +45,12 @@
 #include "AccountManager.h"
 #include "ActionManager.h"
 #include "AIManager.h"
+#include "BazaarPriceIndex.h"
 #include "ChannelClientConnection.h"
 #include "ChannelSyncManager.h"
 #include "CharacterManager.h"
 #include "ChatManager.h"
+#include "EntityPacketCache.h"
 #include "EventManager.h"
 #include "FusionManager.h"
 #include "ManagerClientPacket.h"
@@ -56,12 +58,41 @@
 #include "Packets.h"
 #include "PerformanceTimer.h"
 #include "MatchManager.h"
+#include "ServerDataStamp.h"
+#include "ServerMetrics.h"
 #include "SkillManager.h"
+#include "StartupLoader.h"
 #include "TokuseiManager.h"
 #include "ZoneManager.h"
 
+// Standard C++11 Includes
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif // __linux__
+
 using namespace channel;
 
+/**
+ * Get the resident memory used by the process.
+ * @return Resident memory in bytes or 0 if it is not available
+ */
+static uint64_t GetResidentMemory()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+
+    uint64_t size = 0, resident = 0;
+    if(statm >> size >> resident)
+    {
+        return resident * (uint64_t)sysconf(_SC_PAGESIZE);
+    }
+#endif // __linux__
+
+    return 0;
+}
+
 namespace libcomp
 {
     template<>
@@ -104,8 +135,8 @@ ChannelServer::ChannelServer(const char *szProgram,
     mActionManager(0), mAIManager(0), mCharacterManager(0), mChatManager(0),
     mEventManager(0), mFusionManager(0), mMatchManager(0), mSkillManager(0),
     mZoneManager(0), mDefinitionManager(0), mServerDataManager(0),
-    mRecalcTimeDependents(false), mMaxEntityID(0), mMaxObjectID(0),
-    mTicksPending(0), mTickRunning(true)
+    mBazaarPriceIndex(0), mServerMetrics(0), mRecalcTimeDependents(false),
+    mMaxEntityID(0), mMaxObjectID(0), mTicksPending(0), mTickRunning(true)
 {
 }
 
@@ -118,39 +149,145 @@ bool ChannelServer::Initialize()
         return false;
     }
 
-    // Load newcharacter.xml for use when initializing new characters
-    std::string newCharacterPath = GetConfigPath() + "newcharacter.xml";
-    if(!LoadDataFromFile(newCharacterPath, mDefaultCharacterObjectMap, true,
-        std::set<std::string>{ "Character", "CharacterProgress", "Demon",
-            "EntityStats", "Expertise", "Hotbar", "Item" }))
+    auto conf = std::dynamic_pointer_cast<objects::ChannelConfig>(mConfig);
+
+    ChannelClientConnection::SetFlushPolicy(conf->GetClientFlushThreshold(),
+        conf->GetClientFlushMaxDelay());
+
+    ServerTime loadStart = GetServerTimeSteady();
+    uint64_t memoryStart = GetResidentMemory();
+
+    mDefinitionManager = new libcomp::DefinitionManager();
+    mServerDataManager = new libcomp::ServerDataManager();
+
+    // Load everything that does not depend on each other at the same time
+    StartupLoader loader;
+
+    loader.AddTask("DefaultCharacter", [this]()
+    {
+        // Load newcharacter.xml for use when initializing new characters
+        std::string newCharacterPath = GetConfigPath() + "newcharacter.xml";
+        if(!LoadDataFromFile(newCharacterPath, mDefaultCharacterObjectMap,
+            true, std::set<std::string>{ "Character", "CharacterProgress",
+                "Demon", "EntityStats", "Expertise", "Hotbar", "Item" }))
+        {
+            LogGeneralInfoMsg("No default character file loaded. New"
+                " characters will start with nothing but chosen equipment"
+                " and base expertise skills.\n");
+        }
+
+        return true;
+    });
+
+    // Definitions wait for the default character so the startup log is
+    // written in the same order every time
+    loader.AddTask("Definitions", [this]()
+    {
+        return mDefinitionManager->LoadAllData(GetDataStore());
+    }, { "DefaultCharacter" });
+
+    loader.AddTask("ServerData", [this]()
     {
-        LogGeneralInfoMsg("No default character file loaded. New characters"
-            " will start with nothing but chosen equipment and base"
-            " expertise skills.\n");
+        return mServerDataManager->LoadData(GetDataStore(),
+            mDefinitionManager);
+    }, { "Definitions" });
+
+    // Data that was verified before and has not changed since then
+    // does not need to be verified again
+    ServerDataStamp stamp(conf->GetVerifiedDataStamp());
+    bool stampMatches = false;
+
+    if(conf->GetVerifyServerData())
+    {
+        loader.AddTask("VerifiedDataStamp", [&]()
+        {
+            stampMatches = !conf->GetVerifiedDataStamp().IsEmpty() &&
+                stamp.Calculate(GetDataStore()) && stamp.Matches();
+
+            return true;
+        });
+
+        loader.AddTask("VerifyServerData", [&]()
+        {
+            if(stampMatches)
+            {
+                // Report both costs so a checksum slower than the
+                // verification it replaces is noticed
+                LogGeneralInfo([&]()
+                {
+                    return libcomp::String("Server data matches verified"
+                        " stamp %1 (%2 file(s)), skipping verification."
+                        " Checksum took %3 ms, verification took %4 ms"
+                        " when the stamp was written.\n")
+                        .Arg(stamp.GetChecksum()).Arg(stamp.GetFileCount())
+                        .Arg(stamp.GetCalculateTime() / 1000)
+                        .Arg(stamp.GetVerifyTime() / 1000);
+                });
+
+                return true;
+            }
+
+            LogGeneralDebugMsg("Verifying server data integrity...\n");
+
+            uint64_t verifyStart = GetServerTimeSteady();
+            if(!mServerDataManager->VerifyDataIntegrity(mDefinitionManager))
+            {
+                return false;
+            }
+
+            uint64_t verifyTime = GetServerTimeSteady() - verifyStart;
+
+            if(!stamp.GetChecksum().IsEmpty())
+            {
+                LogGeneralInfo([&]()
+                {
+                    return libcomp::String("Server data verified in %1 ms,"
+                        " checksum of %2 file(s) took %3 ms.\n")
+                        .Arg(verifyTime / 1000).Arg(stamp.GetFileCount())
+                        .Arg(stamp.GetCalculateTime() / 1000);
+                });
+            }
+
+            if(!stamp.GetChecksum().IsEmpty() && !stamp.Save(verifyTime))
+            {
+                LogGeneralWarning([&]()
+                {
+                    return libcomp::String("Failed to write verified server"
+                        " data stamp: %1\n").Arg(conf->GetVerifiedDataStamp());
+                });
+            }
+
+            return true;
+        }, { "ServerData", "VerifiedDataStamp" });
     }
 
-    auto conf = std::dynamic_pointer_cast<objects::ChannelConfig>(mConfig);
+    bool loaded = loader.Run();
 
-    mDefinitionManager = new libcomp::DefinitionManager();
-    if(!mDefinitionManager->LoadAllData(GetDataStore()))
+    for(auto& timing : loader.GetTimings())
     {
-        return false;
+        LogGeneralDebug([&]()
+        {
+            return libcomp::String("Startup task %1 took %2 ms.\n")
+                .Arg(timing.first).Arg(timing.second / 1000);
+        });
     }
 
-    mServerDataManager = new libcomp::ServerDataManager();
-    if(!mServerDataManager->LoadData(GetDataStore(), mDefinitionManager))
+    if(!loaded)
     {
+        // Each task logs its own errors the same as loading one at a time
         return false;
     }
 
-    if(conf->GetVerifyServerData())
+    LogGeneralInfo([&]()
     {
-        LogGeneralDebugMsg("Verifying server data integrity...\n");
-        if(!mServerDataManager->VerifyDataIntegrity(mDefinitionManager))
-        {
-            return false;
-        }
-    }
+        uint64_t memory = GetResidentMemory();
+
+        return libcomp::String("Server data loaded in %1 ms using %2 MiB"
+            " (%3 MiB resident).\n")
+            .Arg((GetServerTimeSteady() - loadStart) / 1000)
+            .Arg(memory > memoryStart ? (memory - memoryStart) / 1048576 : 0)
+            .Arg(memory / 1048576);
+    });
 
     mManagerConnection = std::make_shared<ManagerConnection>(self);
 
@@ -738,6 +875,8 @@ bool ChannelServer::Initialize()
     }
 
     mZoneManager = new ZoneManager(channelPtr);
+    mBazaarPriceIndex = new BazaarPriceIndex(channelPtr);
+    mServerMetrics = new ServerMetrics(channelPtr);
 
     // Now connect to the world server.
     auto worldConnection = std::make_shared<
@@ -800,6 +939,8 @@ ChannelServer::~ChannelServer()
     delete mSyncManager;
 	delete mTokuseiManager;
     delete mZoneManager;
+    delete mBazaarPriceIndex;
+    delete mServerMetrics;
     delete mDefinitionManager;
     delete mServerDataManager;
 }
@@ -809,6 +950,20 @@ ServerTime ChannelServer::GetServerTime()
     return sGetServerTime();
 }
 
+void ChannelServer::SetServerTimeFunction(GET_SERVER_TIME func)
+{
+    if(func)
+    {
+        sGetServerTime = func;
+    }
+    else
+    {
+        sGetServerTime = std::chrono::high_resolution_clock::is_steady
+            ? &ChannelServer::GetServerTimeHighResolution
+            : &ChannelServer::GetServerTimeSteady;
+    }
+}
+
 int32_t ChannelServer::GetExpirationInSeconds(uint32_t fixedTime, uint32_t relativeTo)
 {
     if(fixedTime == 0)
@@ -1057,6 +1212,22 @@ TokuseiManager* ChannelServer::GetTokuseiManager() const
     return mTokuseiManager;
 }
 
+BazaarPriceIndex* ChannelServer::GetBazaarPriceIndex() const
+{
+    return mBazaarPriceIndex;
+}
+
+ServerMetrics* ChannelServer::GetServerMetrics() const
+{
+    return mServerMetrics;
+}
+
+uint8_t ChannelServer::GetPendingTickCount()
+{
+    std::lock_guard<std::mutex> lock(mTickLock);
+    return mTicksPending;
+}
+
 std::shared_ptr<objects::WorldSharedConfig>
     ChannelServer::GetWorldSharedConfig() const
 {
@@ -1092,19 +1263,37 @@ void ChannelServer::Tick()
     // Performance timer for a tick task.
     PerformanceTimer perf(this);
 
+    // Write to each client once for everything sent during the tick
+    ClientPacketBatch batch;
+
     // Update the active zone states
     perf.Start();
     mZoneManager->UpdateActiveZoneStates();
     perf.Stop("UpdateActiveZoneStates");
 
+    // Stream the rest of any zone entry snapshots
+    perf.Start();
+    mZoneManager->StreamPendingZoneInData();
+    perf.Stop("StreamPendingZoneInData");
+
+    // Database work can take a while so write anything that has already
+    // waited past the flush delay first
+    ClientPacketBatch::FlushOverdue();
+
     // Process queued world database changes
     perf.Start();
+    ServerTime flushStart = GetServerTime();
     auto worldFailures = mWorldDatabase->ProcessTransactionQueue();
+    mServerMetrics->RecordDatabaseFlush(true, GetServerTime() - flushStart);
     perf.Stop("WorldDatabaseTransactions");
 
+    ClientPacketBatch::FlushOverdue();
+
     // Process queued lobby database changes
     perf.Start();
+    flushStart = GetServerTime();
     auto lobbyFailures = mLobbyDatabase->ProcessTransactionQueue();
+    mServerMetrics->RecordDatabaseFlush(false, GetServerTime() - flushStart);
     perf.Stop("LobbyDatabaseTransactions");
 
     if(worldFailures.size() > 0 || lobbyFailures.size() > 0)
@@ -1177,6 +1366,8 @@ void ChannelServer::Tick()
     }
     perf.Stop("ScheduleWork");
 
+    mServerMetrics->RecordTick(GetServerTime() - tickTime);
+
     tickPerf.Stop("Tick");
 }
 
@@ -1215,6 +1406,7 @@ void ChannelServer::StartGameTick()
                     else
                     {
                         ticksMissed++;
+                        mServerMetrics->RecordMissedTick();
                     }
                 }
 
@@ -1229,6 +1421,97 @@ void ChannelServer::StartGameTick()
                         });
                     }
 
+                    LogGeneralDebug([&]()
+                    {
+                        return libcomp::String("Entity packet cache: %1 "
+                            "hit(s), %2 miss(es), %3 byte(s) reused.\n")
+                            .Arg(EntityPacketCache::GetHitCount())
+                            .Arg(EntityPacketCache::GetMissCount())
+                            .Arg(EntityPacketCache::GetBytesSaved());
+                    });
+
+                    auto profileCache = GetChannelSyncManager()
+                        ->GetProfileCache();
+                    LogGeneralDebug([&]()
+                    {
+                        return libcomp::String("Profile cache: %1 hit(s), "
+                            "%2 miss(es).\n")
+                            .Arg(profileCache->GetHitCount())
+                            .Arg(profileCache->GetMissCount());
+                    });
+
+                    auto conf = std::dynamic_pointer_cast<
+                        objects::ChannelConfig>(mConfig);
+                    auto aiManager = GetAIManager();
+                    LogGeneralDebug([&]()
+                    {
+                        return libcomp::String("AI: %1 update(s) deferred "
+                            "by the tick budget, longest tick %2 us.\n")
+                            .Arg(aiManager->GetBudgetDeferredCount())
+                            .Arg(aiManager->GetWorstTickTime(true));
+                    });
+
+                    if(conf->GetPerfMonitorEnabled())
+                    {
+                        LogGeneralDebug([&]()
+                        {
+                            return libcomp::String("PERF: AI updates: %1 "
+                                "full, %2 reduced, %3 dormant, %4 skipped.\n")
+                                .Arg(aiManager->GetLODUpdateCount(
+                                    AI_LOD_FULL))
+                                .Arg(aiManager->GetLODUpdateCount(
+                                    AI_LOD_REDUCED))
+                                .Arg(aiManager->GetLODUpdateCount(
+                                    AI_LOD_DORMANT))
+                                .Arg(aiManager->GetLODDeferredCount());
+                        });
+                    }
+
+                    auto tokuseiManager = GetTokuseiManager();
+                    LogGeneralDebug([&]()
+                    {
+                        return libcomp::String("Tokusei: %1 condition(s) "
+                            "evaluated, %2 reused.\n")
+                            .Arg(tokuseiManager->GetConditionEvaluationCount())
+                            .Arg(tokuseiManager->GetConditionReuseCount());
+                    });
+
+                    LogGeneralDebug([&]()
+                    {
+                        uint64_t writes = ChannelClientConnection::
+                            GetTotalWriteCount();
+                        uint64_t bytes = ChannelClientConnection::
+                            GetTotalBytesWritten();
+
+                        return libcomp::String("Client writes: %1 write(s), "
+                            "%2 byte(s) per write, %3 flush(es) deferred.\n")
+                            .Arg(writes)
+                            .Arg(writes ? bytes / writes : 0)
+                            .Arg(ChannelClientConnection::
+                                GetDeferredFlushCount());
+                    });
+
+                    LogGeneralDebug([&]()
+                    {
+                        return libcomp::String("Packet fan-out: %1 cop(ies)"
+                            " of %2 byte(s), %3 cop(ies) avoided, at most %4"
+                            " client(s).\n")
+                            .Arg(ChannelClientConnection::GetPacketCopyCount())
+                            .Arg(ChannelClientConnection::GetPacketCopyBytes())
+                            .Arg(ChannelClientConnection::
+                                GetPacketCopiesAvoided())
+                            .Arg(ChannelClientConnection::GetLargestFanOut());
+                    });
+
+                    auto syncManager = GetChannelSyncManager();
+                    LogGeneralDebug([&]()
+                    {
+                        return libcomp::String("World sync: %1 packet(s),"
+                            " %2 byte(s) received.\n")
+                            .Arg(syncManager->GetIncomingPacketCount())
+                            .Arg(syncManager->GetIncomingByteCount());
+                    });
+
                     ticksMissed = 0;
                     tickCounter = 0;
                 }
@@ -61,12 +61,14 @@ typedef ServerTime (*GET_SERVER_TIME)();
 class AccountManager;
 class ActionManager;
 class AIManager;
+class BazaarPriceIndex;
 class ChannelSyncManager;
 class CharacterManager;
 class ChatManager;
 class EventManager;
 class FusionManager;
 class MatchManager;
+class ServerMetrics;
 class SkillManager;
 class TokuseiManager;
 class ZoneManager;
@@ -120,6 +122,15 @@ public:
      */
     static ServerTime GetServerTime();
 
+    /**
+     * Replace the function used to get the current time relative to the
+     * server. This is only meant for tools that drive the server code with
+     * a simulated clock and must be called before anything reads the time.
+     * @param func Function to get the time from or null to restore the
+     *  default clock
+     */
+    static void SetServerTimeFunction(GET_SERVER_TIME func);
+
     /**
      * Get the amount of time left in an expiration relative to the server,
      * in seconds.
@@ -302,6 +313,24 @@ public:
      */
     TokuseiManager* GetTokuseiManager() const;
 
+    /**
+     * Get a pointer to the bazaar price index.
+     * @return Pointer to the BazaarPriceIndex
+     */
+    BazaarPriceIndex* GetBazaarPriceIndex() const;
+
+    /**
+     * Get a pointer to the server metrics.
+     * @return Pointer to the ServerMetrics
+     */
+    ServerMetrics* GetServerMetrics() const;
+
+    /**
+     * Get the number of server ticks queued but not yet processed.
+     * @return Number of pending server ticks
+     */
+    uint8_t GetPendingTickCount();
+
     /**
      * Get the world server supplied shared config settings.
      * @return Pointer to the world shared config
@@ -543,6 +572,12 @@ protected:
     /// Tokusei manager for the server.
     TokuseiManager* mTokuseiManager;
 
+    /// Index of recent bazaar sale prices for the server.
+    BazaarPriceIndex* mBazaarPriceIndex;
+
+    /// Counters reported by the metrics endpoint.
+    ServerMetrics* mServerMetrics;
+
     /// Server world clock
     WorldClock mWorldClock;
 
@@ -35,6 +35,7 @@
 
 // object Includes
 #include <Account.h>
+#include <ChannelConfig.h>
 #include <CharacterLogin.h>
 #include <EventCounter.h>
 #include <InstanceAccess.h>
@@ -89,7 +90,8 @@ namespace libcomp
 }
 
 ChannelSyncManager::ChannelSyncManager(const std::weak_ptr<
-    ChannelServer>& server) : mServer(server)
+    ChannelServer>& server) : mProfileCache(std::make_shared<ProfileCache>(
+    server)), mIncomingPackets(0), mIncomingBytes(0), mServer(server)
 {
 }
 
@@ -186,6 +188,11 @@ bool ChannelSyncManager::Initialize()
 
     mRegisteredTypes["UBTournament"] = cfg;
 
+    auto conf = std::dynamic_pointer_cast<objects::ChannelConfig>(
+        server->GetConfig());
+    mProfileCache->SetLimits((size_t)conf->GetProfileCacheSize(),
+        conf->GetProfileCacheTTL());
+
     // Load all current group counters
     for(auto c : objects::EventCounter::LoadEventCounterListByGroupCounter(
         worldDB, true))
@@ -243,6 +250,27 @@ std::shared_ptr<objects::EventCounter>
     return it != mEventCounters.end() ? it->second : nullptr;
 }
 
+std::shared_ptr<ProfileCache> ChannelSyncManager::GetProfileCache() const
+{
+    return mProfileCache;
+}
+
+void ChannelSyncManager::RecordIncoming(uint32_t size)
+{
+    mIncomingPackets++;
+    mIncomingBytes += (uint64_t)size;
+}
+
+uint64_t ChannelSyncManager::GetIncomingPacketCount() const
+{
+    return mIncomingPackets;
+}
+
+uint64_t ChannelSyncManager::GetIncomingByteCount() const
+{
+    return mIncomingBytes;
+}
+
 namespace channel
 {
 template<>
@@ -257,6 +285,10 @@ int8_t ChannelSyncManager::Update<objects::SearchEntry>(const libcomp::String& t
 
     auto entry = std::dynamic_pointer_cast<objects::SearchEntry>(obj);
 
+    // Make sure the character or clan is shown as it is now the next time
+    // the entry is viewed
+    mProfileCache->Invalidate(entry->GetRelatedTo());
+
     auto& entryList = mSearchEntries[entry->GetType()];
 
     auto it = entryList.begin();
@@ -431,6 +463,11 @@ void ChannelSyncManager::SyncComplete<objects::CharacterLogin>(
     {
         auto record = std::dynamic_pointer_cast<objects::CharacterLogin>(
             objPair.first);
+
+        // Level and name changes are saved by the time a character
+        // changes channels or logs out
+        mProfileCache->Invalidate(record->GetCharacter().GetUUID());
+
         if(objPair.second)
         {
             removes.push_back(record);
@@ -35,6 +35,12 @@
 // object Includes
 #include <SearchEntry.h>
 
+// channel Includes
+#include "ProfileCache.h"
+
+// Standard C++11 includes
+#include <atomic>
+
 namespace objects
 {
 class EventCounter;
@@ -91,6 +97,13 @@ public:
      */
     std::shared_ptr<objects::EventCounter> GetWorldEventCounter(int32_t type);
 
+    /**
+     * Get the cache of character and clan profiles displayed by the search
+     * board and bazaars, kept coherent with world server syncs
+     * @return Pointer to the profile cache
+     */
+    std::shared_ptr<ProfileCache> GetProfileCache() const;
+
     /**
      * Server specific handler for explicit types of non-persistent records
      * being updated.
@@ -117,6 +130,24 @@ public:
         const std::list<std::pair<std::shared_ptr<libcomp::Object>, bool>>& objs,
         const libcomp::String& source);
 
+    /**
+     * Count a sync packet received from the world server.
+     * @param size Size of the packet in bytes
+     */
+    void RecordIncoming(uint32_t size);
+
+    /**
+     * Get the number of sync packets received from the world server.
+     * @return Number of sync packets received
+     */
+    uint64_t GetIncomingPacketCount() const;
+
+    /**
+     * Get the number of sync packet bytes received from the world server.
+     * @return Number of sync packet bytes received
+     */
+    uint64_t GetIncomingByteCount() const;
+
 private:
     /// Map of all search entries on the world server by type
     libcomp::EnumMap<objects::SearchEntry::Type_t,
@@ -126,6 +157,15 @@ private:
     std::unordered_map<int32_t,
         std::shared_ptr<objects::EventCounter>> mEventCounters;
 
+    /// Cache of character and clan profiles loaded from the world database
+    std::shared_ptr<ProfileCache> mProfileCache;
+
+    /// Number of sync packets received from the world server
+    std::atomic<uint64_t> mIncomingPackets;
+
+    /// Number of sync packet bytes received from the world server
+    std::atomic<uint64_t> mIncomingBytes;
+
     /// Pointer to the channel server.
     std::weak_ptr<ChannelServer> mServer;
 };
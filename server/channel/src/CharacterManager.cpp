@@ -196,15 +196,7 @@ void CharacterManager::SendCharacterData(const std::shared_ptr<
     reply.WriteS16(-5600); // Unknown
     reply.WriteS16(5600); // Unknown
 
-    auto statusEffects = cState->GetCurrentStatusEffectStates();
-
-    reply.WriteU32Little(static_cast<uint32_t>(statusEffects.size()));
-    for(auto ePair : statusEffects)
-    {
-        reply.WriteU32Little(ePair.first->GetEffect());
-        reply.WriteS32Little((int32_t)ePair.second);
-        reply.WriteU8(ePair.first->GetStack());
-    }
+    cState->WriteStatusEffectData(reply);
 
     auto skills = cState->GetCurrentSkills();
     reply.WriteU32(static_cast<uint32_t>(skills.size()));
@@ -360,15 +352,7 @@ void CharacterManager::SendOtherCharacterData(const std::list<std::shared_ptr<
     reply.WriteS8(cs->GetLevel());
     reply.WriteS16Little(c->GetLNC());
 
-    auto statusEffects = cState->GetCurrentStatusEffectStates();
-
-    reply.WriteU32Little(static_cast<uint32_t>(statusEffects.size()));
-    for(auto ePair : statusEffects)
-    {
-        reply.WriteU32Little(ePair.first->GetEffect());
-        reply.WriteS32Little((int32_t)ePair.second);
-        reply.WriteU8(ePair.first->GetStack());
-    }
+    cState->WriteStatusEffectData(reply);
 
     // Unknown
     reply.WriteS64Little(-1);
@@ -613,15 +597,7 @@ void CharacterManager::SendOtherPartnerData(const std::list<std::shared_ptr<
     reply.WriteS16Little((int16_t)ds->GetHP());
     reply.WriteS8(ds->GetLevel());
 
-    auto statusEffects = dState->GetCurrentStatusEffectStates();
-
-    reply.WriteU32Little(static_cast<uint32_t>(statusEffects.size()));
-    for(auto ePair : statusEffects)
-    {
-        reply.WriteU32Little(ePair.first->GetEffect());
-        reply.WriteS32Little((int32_t)ePair.second);
-        reply.WriteU8(ePair.first->GetStack());
-    }
+    dState->WriteStatusEffectData(reply);
 
     // Unknown
     reply.WriteS64Little(-1);
@@ -5119,6 +5095,12 @@ bool CharacterManager::UpdateExperience(const std::shared_ptr<
 
             dbChanges->Update(character);
 
+            // Drop the old level from any cached profiles
+            auto profileCache = server->GetChannelSyncManager()
+                ->GetProfileCache();
+            profileCache->Invalidate(character->GetUUID());
+            profileCache->Invalidate(character->GetClan().GetUUID());
+
             LogCharacterManagerDebug([cState, startingLevel, level]()
             {
                 return libcomp::String("Character %1 has leveled up from"
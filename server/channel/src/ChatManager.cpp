@@ -31,6 +31,7 @@
 #include <Git.h>
 #include <Log.h>
 #include <PacketCodes.h>
+#include <Randomizer.h>
 #include <ServerConstants.h>
 #include <ServerDataManager.h>
 
@@ -2136,9 +2137,12 @@ bool ChatManager::GMCommand_Help(const std::shared_ptr<
             "Updates the player's partner to have PTS SP.",
         } },
         { "spawn", {
-            "@spawn",
+            "@spawn [ID|NAME COUNT [RADIUS [AI]]]",
             "Spawn the max number of enemies in each spawn group",
-            "in the current zone.",
+            "in the current zone. If ID or NAME and COUNT are",
+            "specified, COUNT enemies of that type are spawned",
+            "within RADIUS (default 2000) of the character instead,",
+            "using AI type AI if specified.",
         } },
         { "speed", {
             "@speed MULTIPLIER [DEMON]",
@@ -2974,6 +2978,12 @@ bool ChatManager::GMCommand_Post(const std::shared_ptr<
 
     postItem->Insert(lobbyDB);
 
+    auto state = client->GetClientState();
+    if(targetAccount == state->GetAccountUID())
+    {
+        state->InvalidatePostItems();
+    }
+
     return true;
 }
 
@@ -3508,14 +3518,93 @@ bool ChatManager::GMCommand_Spawn(const std::shared_ptr<
         return true;
     }
 
-    (void)args;
+    std::list<libcomp::String> argsCopy = args;
 
     auto server = mServer.lock();
     auto zoneManager = server->GetZoneManager();
     auto zone = zoneManager->GetCurrentZone(client);
 
-    zoneManager->UpdateSpawnGroups(zone, true);
-    return true;
+    if(argsCopy.empty())
+    {
+        zoneManager->UpdateSpawnGroups(zone, true);
+        return true;
+    }
+
+    // Valid params: enemy+count, enemy+count+radius, enemy+count+radius+AI
+    if(argsCopy.size() < 2 || argsCopy.size() > 4)
+    {
+        return SendChatMessage(client, ChatType_t::CHAT_SELF,
+            "@spawn requires zero or two to four args");
+    }
+
+    auto definitionManager = server->GetDefinitionManager();
+
+    uint32_t demonID;
+    if(!GetIntegerArg<uint32_t>(demonID, argsCopy))
+    {
+        libcomp::String name;
+        if(!GetStringArg(name, argsCopy))
+        {
+            return false;
+        }
+
+        auto devilData = definitionManager->GetDevilData(name);
+        if(devilData == nullptr)
+        {
+            return false;
+        }
+
+        demonID = devilData->GetBasic()->GetID();
+    }
+
+    if(!definitionManager->GetDevilData(demonID))
+    {
+        return false;
+    }
+
+    uint32_t count;
+    if(!GetIntegerArg<uint32_t>(count, argsCopy) || count == 0 ||
+        count > 10000)
+    {
+        return SendChatMessage(client, ChatType_t::CHAT_SELF,
+            "@spawn COUNT must be between 1 and 10000");
+    }
+
+    float radius = 2000.f;
+    libcomp::String aiType = "";
+    if(!argsCopy.empty())
+    {
+        if(!GetDecimalArg<float>(radius, argsCopy) || radius < 0.f)
+        {
+            return false;
+        }
+
+        GetStringArg(aiType, argsCopy);
+    }
+
+    auto cState = client->GetClientState()->GetCharacterState();
+    cState->RefreshCurrentPosition(ChannelServer::GetServerTime());
+
+    float x = cState->GetCurrentX();
+    float y = cState->GetCurrentY();
+
+    // Scatter the enemies around the character, mostly useful for load
+    // testing AI updates
+    uint32_t spawned = 0;
+    for(uint32_t i = 0; i < count; i++)
+    {
+        float rot = RNG_DEC(float, -3.14f, 3.14f, 2);
+        if(zoneManager->SpawnEnemy(zone, demonID,
+            x + RNG_DEC(float, -radius, radius, 2),
+            y + RNG_DEC(float, -radius, radius, 2), rot, aiType))
+        {
+            spawned++;
+        }
+    }
+
+    return SendChatMessage(client, ChatType_t::CHAT_SELF,
+        libcomp::String("Spawned %1 enem%2.").Arg(spawned)
+        .Arg(spawned != 1 ? "ies" : "y"));
 }
 
 bool ChatManager::GMCommand_Speed(const std::shared_ptr<
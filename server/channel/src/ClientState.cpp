@@ -27,6 +27,7 @@
 #include "ClientState.h"
 
 // Standard C++11 Includes
+#include <algorithm>
 #include <ctime>
 
 // libcomp Includes
@@ -43,6 +44,7 @@
 #include <EventInstance.h>
 #include <EventOpenMenu.h>
 #include <EventState.h>
+#include <PostItem.h>
 
 // channel Includes
 #include "ChannelServer.h"
@@ -54,9 +56,24 @@ std::unordered_map<bool,
     std::unordered_map<int32_t, ClientState*>> ClientState::sEntityClients;
 std::mutex ClientState::sLock;
 
+bool PostSortKey::operator<(const PostSortKey& other) const
+{
+    if(Timestamp != other.Timestamp)
+    {
+        return Timestamp < other.Timestamp;
+    }
+    else if(Type != other.Type)
+    {
+        return Type < other.Type;
+    }
+
+    return UUID < other.UUID;
+}
+
 ClientState::ClientState() : objects::ClientStateObject(),
     mCharacterState(std::shared_ptr<CharacterState>(new CharacterState)),
     mDemonState(std::shared_ptr<DemonState>(new DemonState)),
+    mPostCursorIndex(-1), mPostItemsLoaded(false), mPostItemsVersion(0),
     mStartTime(ChannelServer::GetServerTime()), mNextLocalObjectID(1)
 {
 }
@@ -507,3 +524,144 @@ std::list<std::shared_ptr<objects::ClientCostAdjustment>>
     return it != mCostAdjustments.end() ? it->second
         : std::list<std::shared_ptr<objects::ClientCostAdjustment>>();
 }
+
+std::list<std::shared_ptr<objects::PostItem>> ClientState::GetPostItems(
+    const std::shared_ptr<libcomp::Database>& lobbyDB, bool reload)
+{
+    LoadPostItems(lobbyDB, reload);
+
+    std::list<std::shared_ptr<objects::PostItem>> items;
+
+    std::lock_guard<std::mutex> lock(mLock);
+    for(auto& pair : mPostItems)
+    {
+        items.push_back(pair.second);
+    }
+
+    return items;
+}
+
+std::list<std::shared_ptr<objects::PostItem>> ClientState::GetPostItemPage(
+    const std::shared_ptr<libcomp::Database>& lobbyDB, int32_t index,
+    int32_t count, size_t& total)
+{
+    LoadPostItems(lobbyDB);
+
+    std::list<std::shared_ptr<objects::PostItem>> items;
+
+    std::lock_guard<std::mutex> lock(mLock);
+    total = mPostItems.size();
+    if(index < 0 || count <= 0)
+    {
+        return items;
+    }
+
+    auto it = mPostItems.end();
+    if(index > 0 && index == mPostCursorIndex)
+    {
+        // Continue from the last item sent
+        it = std::upper_bound(mPostItems.begin(), mPostItems.end(),
+            mPostCursor, [](const PostSortKey& key,
+                const std::pair<PostSortKey,
+                std::shared_ptr<objects::PostItem>>& pair)
+            {
+                return key < pair.first;
+            });
+    }
+    else if((size_t)index < mPostItems.size())
+    {
+        it = mPostItems.begin() + index;
+    }
+
+    for(; it != mPostItems.end() && (int32_t)items.size() < count; it++)
+    {
+        items.push_back(it->second);
+        mPostCursor = it->first;
+    }
+
+    mPostCursorIndex = items.size() > 0
+        ? (int32_t)(index + (int32_t)items.size()) : -1;
+
+    return items;
+}
+
+std::shared_ptr<objects::PostItem> ClientState::GetCachedPostItem(
+    const libobjgen::UUID& uuid)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = mPostItemsByUUID.find(uuid.ToString());
+    return it != mPostItemsByUUID.end() ? it->second : nullptr;
+}
+
+void ClientState::InvalidatePostItems()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mPostItems.clear();
+    mPostItemsByUUID.clear();
+    mPostItemsLoaded = false;
+    mPostItemsVersion++;
+}
+
+void ClientState::SetQuestKillRequirements(std::unordered_map<uint32_t,
+    std::list<QuestKillRequirement>> requirements)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mQuestKillRequirements.swap(requirements);
+}
+
+std::list<QuestKillRequirement> ClientState::GetQuestKillRequirements(
+    uint32_t enemyType)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = mQuestKillRequirements.find(enemyType);
+    return it != mQuestKillRequirements.end()
+        ? it->second : std::list<QuestKillRequirement>();
+}
+
+void ClientState::LoadPostItems(
+    const std::shared_ptr<libcomp::Database>& lobbyDB, bool reload)
+{
+    uint32_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        if(mPostItemsLoaded && !reload)
+        {
+            return;
+        }
+
+        version = mPostItemsVersion;
+    }
+
+    // Load outside of the lock so other accessors do not wait on the
+    // lobby database
+    std::vector<std::pair<PostSortKey,
+        std::shared_ptr<objects::PostItem>>> postItems;
+    std::unordered_map<std::string,
+        std::shared_ptr<objects::PostItem>> postItemsByUUID;
+    for(auto item : objects::PostItem::LoadPostItemListByAccount(lobbyDB,
+        GetAccountUID()))
+    {
+        PostSortKey key;
+        key.Timestamp = item->GetTimestamp();
+        key.Type = item->GetType();
+        key.UUID = item->GetUUID().ToString();
+
+        postItems.push_back(std::make_pair(key, item));
+        postItemsByUUID[key.UUID] = item;
+    }
+
+    std::sort(postItems.begin(), postItems.end(), [](
+        const std::pair<PostSortKey, std::shared_ptr<objects::PostItem>>& a,
+        const std::pair<PostSortKey, std::shared_ptr<objects::PostItem>>& b)
+        {
+            return a.first < b.first;
+        });
+
+    std::lock_guard<std::mutex> lock(mLock);
+    mPostItems.swap(postItems);
+    mPostItemsByUUID.swap(postItemsByUUID);
+
+    // If the post changed during the load it may already be out of date
+    // so load it again on next use
+    mPostItemsLoaded = version == mPostItemsVersion;
+}
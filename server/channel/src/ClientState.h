@@ -38,14 +38,19 @@
 #include <Demon.h>
 #include <PartyCharacter.h>
 
+// Standard C++11 includes
+#include <vector>
+
 namespace libcomp
 {
+class Database;
 class Packet;
 }
 
 namespace objects
 {
 class ClientCostAdjustment;
+class PostItem;
 }
 
 namespace channel
@@ -57,6 +62,45 @@ class Zone;
 typedef float ClientTime;
 typedef uint64_t ServerTime;
 
+/**
+ * Precomputed sort key of a post item. Post items are listed by timestamp,
+ * then type, then UUID so the order never changes between pages.
+ */
+struct PostSortKey
+{
+    /// Timestamp the post item was added
+    uint32_t Timestamp = 0;
+
+    /// Shop product ID of the post item
+    uint32_t Type = 0;
+
+    /// UUID string of the post item
+    std::string UUID;
+
+    /**
+     * Compare the key to another key
+     * @param other Key to compare to
+     * @return true if this key sorts first
+     */
+    bool operator<(const PostSortKey& other) const;
+};
+
+/**
+ * Kill requirement of an active quest phase, indexed by the enemy type
+ * that counts towards it.
+ */
+struct QuestKillRequirement
+{
+    /// ID of the quest
+    int16_t QuestID = 0;
+
+    /// Phase of the quest the requirement belongs to
+    int8_t Phase = 0;
+
+    /// Index of the requirement in the phase and the quest's custom data
+    uint8_t Index = 0;
+};
+
 /**
  * Contains the state of a game client currently connected to the
  * channel.
@@ -328,7 +372,79 @@ public:
     std::list<std::shared_ptr<objects::ClientCostAdjustment>>
         GetCostAdjustments(int32_t entityID);
 
+    /**
+     * Get all post items belonging to the client's account in listing
+     * order, loading them from the lobby database if they are not cached
+     * @param lobbyDB Pointer to the lobby database
+     * @param reload true if the cached post items should be reloaded
+     * @return List of all post items in listing order
+     */
+    std::list<std::shared_ptr<objects::PostItem>> GetPostItems(
+        const std::shared_ptr<libcomp::Database>& lobbyDB,
+        bool reload = false);
+
+    /**
+     * Get one page of post items belonging to the client's account. If
+     * the page directly follows the last page retrieved, it starts after
+     * the last item on that page rather than at the index so items
+     * removed from earlier pages do not shift unseen items out of view.
+     * @param lobbyDB Pointer to the lobby database
+     * @param index Listing index of the first item to retrieve
+     * @param count Maximum number of items to retrieve
+     * @param total Output parameter set to the total number of post items
+     * @return List of post items on the page in listing order
+     */
+    std::list<std::shared_ptr<objects::PostItem>> GetPostItemPage(
+        const std::shared_ptr<libcomp::Database>& lobbyDB, int32_t index,
+        int32_t count, size_t& total);
+
+    /**
+     * Get a cached post item belonging to the client's account
+     * @param uuid UUID of the post item
+     * @return Pointer to the post item or null if it is not cached
+     */
+    std::shared_ptr<objects::PostItem> GetCachedPostItem(
+        const libobjgen::UUID& uuid);
+
+    /**
+     * Clear the cached post items so they are loaded from the lobby
+     * database again on next use. This should be called any time a post
+     * item is added to or removed from the client's account by this
+     * client. Items added from elsewhere are only seen once the post is
+     * reloaded so capacity checks must reload first.
+     */
+    void InvalidatePostItems();
+
+    /**
+     * Replace the index of active quest phase kill requirements
+     * @param requirements Map of enemy types to the kill requirements
+     *  they count towards
+     */
+    void SetQuestKillRequirements(std::unordered_map<uint32_t,
+        std::list<QuestKillRequirement>> requirements);
+
+    /**
+     * Get the active quest phase kill requirements an enemy type counts
+     * towards
+     * @param enemyType Demon type of the killed enemy
+     * @return List of kill requirements for the enemy type
+     */
+    std::list<QuestKillRequirement> GetQuestKillRequirements(
+        uint32_t enemyType);
+
 private:
+    /**
+     * Load the post items into the cache if they are not already loaded.
+     * The items are loaded without holding the server lock and swapped
+     * in once loaded so the server lock must not be held when calling
+     * this.
+     * @param lobbyDB Pointer to the lobby database
+     * @param reload true if the post items should be loaded even if they
+     *  are already cached
+     */
+    void LoadPostItems(const std::shared_ptr<libcomp::Database>& lobbyDB,
+        bool reload = false);
+
     /// Static registry of all client states sorted as world (true) or
     /// local entity IDs (false) and their respective IDs
     static std::unordered_map<bool,
@@ -362,6 +478,32 @@ private:
     std::unordered_map<int32_t, std::list<
         std::shared_ptr<objects::ClientCostAdjustment>>> mCostAdjustments;
 
+    /// Cached post items of the client's account in listing order
+    std::vector<std::pair<PostSortKey,
+        std::shared_ptr<objects::PostItem>>> mPostItems;
+
+    /// Cached post items of the client's account by UUID string
+    std::unordered_map<std::string,
+        std::shared_ptr<objects::PostItem>> mPostItemsByUUID;
+
+    /// Active quest phase kill requirements by enemy type
+    std::unordered_map<uint32_t,
+        std::list<QuestKillRequirement>> mQuestKillRequirements;
+
+    /// Sort key of the last post item sent on the last post list page
+    PostSortKey mPostCursor;
+
+    /// Listing index directly following the last post list page or -1
+    /// if no page has been retrieved
+    int32_t mPostCursorIndex;
+
+    /// Indicates that mPostItems is loaded
+    bool mPostItemsLoaded;
+
+    /// Incremented every time the cached post items are invalidated so a
+    /// load that overlaps an invalidation is not marked as loaded
+    uint32_t mPostItemsVersion;
+
     /// Current time of the server set upon creating the client
     /// state.
     ServerTime mStartTime;
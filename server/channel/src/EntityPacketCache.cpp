@@ -0,0 +1,99 @@
+/**
+ * @file server/channel/src/EntityPacketCache.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Cache of a serialized packet used to show an entity.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityPacketCache.h"
+
+// libcomp Includes
+#include <Packet.h>
+
+// Standard C Includes
+#include <cstring>
+
+using namespace channel;
+
+std::atomic<uint64_t> EntityPacketCache::sHitCount(0);
+std::atomic<uint64_t> EntityPacketCache::sMissCount(0);
+std::atomic<uint64_t> EntityPacketCache::sBytesSaved(0);
+
+EntityPacketCache::EntityPacketCache()
+{
+}
+
+bool EntityPacketCache::Load(const Key_t& key, libcomp::Packet& p)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if(mData.empty() || mKey != key)
+    {
+        RecordMiss();
+        return false;
+    }
+
+    p.WriteArray(&mData[0], (uint32_t)mData.size());
+    RecordHit(mData.size());
+
+    return true;
+}
+
+void EntityPacketCache::Store(const Key_t& key, const libcomp::Packet& p)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mKey = key;
+    mData.assign(p.ConstData(), p.ConstData() + p.Size());
+}
+
+int64_t EntityPacketCache::FloatKey(float value)
+{
+    int32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    return (int64_t)bits;
+}
+
+void EntityPacketCache::RecordHit(size_t bytes)
+{
+    sHitCount++;
+    sBytesSaved += (uint64_t)bytes;
+}
+
+void EntityPacketCache::RecordMiss()
+{
+    sMissCount++;
+}
+
+uint64_t EntityPacketCache::GetHitCount()
+{
+    return sHitCount;
+}
+
+uint64_t EntityPacketCache::GetMissCount()
+{
+    return sMissCount;
+}
+
+uint64_t EntityPacketCache::GetBytesSaved()
+{
+    return sBytesSaved;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file server/channel/src/EntityPacketCache.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Cache of a serialized packet used to show an entity.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_ENTITYPACKETCACHE_H
+#define SERVER_CHANNEL_SRC_ENTITYPACKETCACHE_H
+
+// Standard C++11 Includes
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace libcomp
+{
+class Packet;
+}
+
+namespace channel
+{
+
+/**
+ * Cache of the serialized packet used to show an entity to a client. The
+ * packet is reused for as long as the key built from the values in it that
+ * can change stays the same, so every recipient and zone entry shares the
+ * same bytes instead of rebuilding them from the entity.
+ */
+class EntityPacketCache
+{
+public:
+    /// Values a cached packet was built from
+    typedef std::vector<int64_t> Key_t;
+
+    /**
+     * Create a new empty cache.
+     */
+    EntityPacketCache();
+
+    /**
+     * Write the cached packet to the supplied empty packet if it was built
+     * from the same key.
+     * @param key Key built from the current entity values
+     * @param p Packet to write the cached data to
+     * @return true if the cached packet was written, false if it needs
+     *  to be built again
+     */
+    bool Load(const Key_t& key, libcomp::Packet& p);
+
+    /**
+     * Store a newly built packet in the cache.
+     * @param key Key built from the entity values the packet contains
+     * @param p Packet to cache
+     */
+    void Store(const Key_t& key, const libcomp::Packet& p);
+
+    /**
+     * Convert a float value to a key value without losing precision.
+     * @param value Float value to convert
+     * @return Key value representing the float
+     */
+    static int64_t FloatKey(float value);
+
+    /**
+     * Get the number of times cached packet data was reused.
+     * @return Cache hit count
+     */
+    static uint64_t GetHitCount();
+
+    /**
+     * Get the number of times packet data had to be built.
+     * @return Cache miss count
+     */
+    static uint64_t GetMissCount();
+
+    /**
+     * Get the total number of bytes reused from the caches.
+     * @return Number of bytes that did not need to be built
+     */
+    static uint64_t GetBytesSaved();
+
+private:
+    /**
+     * Count a reuse of cached packet data across all caches.
+     * @param bytes Number of bytes that did not need to be built
+     */
+    static void RecordHit(size_t bytes);
+
+    /**
+     * Count packet data that had to be built across all caches.
+     */
+    static void RecordMiss();
+
+    /// Key the cached data was built from
+    Key_t mKey;
+
+    /// Serialized packet data, empty if nothing is cached
+    std::vector<char> mData;
+
+    /// Server lock for the cached data
+    std::mutex mLock;
+
+    /// Number of times cached packet data was reused
+    static std::atomic<uint64_t> sHitCount;
+
+    /// Number of times packet data had to be built
+    static std::atomic<uint64_t> sMissCount;
+
+    /// Total number of bytes reused from the caches
+    static std::atomic<uint64_t> sBytesSaved;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_ENTITYPACKETCACHE_H
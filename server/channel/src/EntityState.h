@@ -30,6 +30,9 @@
 // objects Includes
 #include <EntityStateObject.h>
 
+// channel Includes
+#include "EntityPacketCache.h"
+
 namespace channel
 {
 
@@ -61,8 +64,20 @@ public:
         return mEntity;
     }
 
+    /**
+     * Get the cache of the packet used to show the entity to clients
+     * @return Pointer to the show packet cache
+     */
+    EntityPacketCache* GetShowPacketCache()
+    {
+        return &mShowPacketCache;
+    }
+
 private:
     std::shared_ptr<T> mEntity;
+
+    /// Cached packet used to show the entity to clients
+    EntityPacketCache mShowPacketCache;
 };
 
 } // namespace channel
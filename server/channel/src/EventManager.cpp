@@ -113,6 +113,7 @@
 #include "FusionTables.h"
 #include "ManagerConnection.h"
 #include "MatchManager.h"
+#include "ServerMetrics.h"
 #include "TokuseiManager.h"
 #include "ZoneInstance.h"
 #include "ZoneManager.h"
@@ -792,45 +793,37 @@ void EventManager::UpdateQuestKillCount(const std::shared_ptr<ChannelClientConne
     auto cState = state->GetCharacterState();
     auto character = cState->GetEntity();
 
+    // Only the quests with a kill requirement for one of the enemy types
+    // killed can be affected
     std::set<int16_t> countUpdates;
-    for(auto qPair : character->GetQuests())
+    for(auto& kPair : kills)
     {
-        auto quest = qPair.second.Get();
-        auto questData = definitionManager->GetQuestData((uint32_t)qPair.first);
-        int8_t currentPhase = quest ? quest->GetPhase() : -1;
-        if(currentPhase < 0 || (int8_t)questData->GetPhaseCount() < currentPhase)
+        for(auto& killReq : state->GetQuestKillRequirements(kPair.first))
         {
-            continue;
-        }
+            auto quest = character->GetQuests(killReq.QuestID).Get();
+            auto questData = definitionManager->GetQuestData(
+                (uint32_t)killReq.QuestID);
+            if(!quest || !questData || quest->GetPhase() != killReq.Phase)
+            {
+                // Quest was completed or removed since the index was built
+                continue;
+            }
 
-        auto phaseData = questData->GetPhases((size_t)currentPhase);
-        for(uint32_t i = 0; i < phaseData->GetRequirementCount(); i++)
-        {
-            auto req = phaseData->GetRequirements((size_t)i);
+            auto phaseData = questData->GetPhases((size_t)killReq.Phase);
+            auto req = phaseData->GetRequirements((size_t)killReq.Index);
 
-            auto it = kills.find(req->GetObjectID());
-            if((req->GetType() == objects::QuestPhaseRequirement::Type_t::KILL ||
-                req->GetType() == objects::QuestPhaseRequirement::Type_t::KILL_HIDDEN) &&
-                it != kills.end())
+            int32_t customData = quest->GetCustomData((size_t)killReq.Index);
+            if(customData < (int32_t)req->GetObjectCount())
             {
-                int32_t customData = quest->GetCustomData((size_t)i);
-                if(customData < (int32_t)req->GetObjectCount())
+                customData = (int32_t)(customData + kPair.second);
+                if(customData > (int32_t)req->GetObjectCount())
                 {
-                    customData = (int32_t)(customData + it->second);
-                    if(customData > (int32_t)req->GetObjectCount())
-                    {
-                        customData = (int32_t)req->GetObjectCount();
-                    }
-
-                    countUpdates.insert(qPair.first);
-                    quest->SetCustomData((size_t)i, customData);
+                    customData = (int32_t)req->GetObjectCount();
                 }
-            }
-        }
 
-        if(countUpdates.size() > 0)
-        {
-            server->GetWorldDatabase()->QueueUpdate(quest, state->GetAccountUID());
+                countUpdates.insert(killReq.QuestID);
+                quest->SetCustomData((size_t)killReq.Index, customData);
+            }
         }
     }
 
@@ -841,6 +834,9 @@ void EventManager::UpdateQuestKillCount(const std::shared_ptr<ChannelClientConne
             auto quest = character->GetQuests(questID).Get();
             auto customData = quest->GetCustomData();
 
+            server->GetWorldDatabase()->QueueUpdate(quest,
+                state->GetAccountUID());
+
             libcomp::Packet p;
             p.WritePacketCode(
                 ChannelToClientPacketCode_t::PACKET_QUEST_KILL_COUNT_UPDATE);
@@ -950,7 +946,8 @@ bool EventManager::EvaluateEventCondition(EventContext& ctx, const std::shared_p
             }
             else if(script && script->Type.ToLower() == "eventcondition")
             {
-                auto engine = std::make_shared<libcomp::ScriptEngine>();
+                auto engine = ServerMetrics::CreateScriptEngine(
+                    ServerMetrics::ScriptEngineType_t::EVENT);
                 engine->Using<CharacterState>();
                 engine->Using<DemonState>();
                 engine->Using<Zone>();
@@ -2784,7 +2781,9 @@ void EventManager::UpdateQuestTargetEnemies(
     // Clear existing
     state->ClearQuestTargetEnemies();
 
-    // Re-calculate targets
+    // Re-calculate targets and index the kill requirements they count
+    // towards so kills do not need to check every active quest
+    std::unordered_map<uint32_t, std::list<QuestKillRequirement>> killReqs;
     for(auto qPair : character->GetQuests())
     {
         auto quest = qPair.second.Get();
@@ -2803,10 +2802,19 @@ void EventManager::UpdateQuestTargetEnemies(
                 req->GetType() == objects::QuestPhaseRequirement::Type_t::KILL)
             {
                 state->InsertQuestTargetEnemies(req->GetObjectID());
+
+                QuestKillRequirement killReq;
+                killReq.QuestID = qPair.first;
+                killReq.Phase = currentPhase;
+                killReq.Index = (uint8_t)i;
+
+                killReqs[req->GetObjectID()].push_back(killReq);
             }
         }
     }
 
+    state->SetQuestKillRequirements(killReqs);
+
     // Add demon quest type
     auto dQuest = character->GetDemonQuest().Get();
     if(dQuest)
@@ -4298,7 +4306,8 @@ void EventManager::HandleNext(EventContext& ctx)
                     nextEventID = iState->GetNext();
                 }
 
-                auto engine = std::make_shared<libcomp::ScriptEngine>();
+                auto engine = ServerMetrics::CreateScriptEngine(
+                    ServerMetrics::ScriptEngineType_t::EVENT);
                 engine->Using<CharacterState>();
                 engine->Using<DemonState>();
                 engine->Using<Zone>();
@@ -222,7 +222,8 @@ public:
 
     /**
      * Update the registered set of enemy types that need to be killed to
-     * complete the current quests for the supplied client
+     * complete the current quests for the supplied client along with the
+     * index of quest phase kill requirements each enemy type counts towards
      * @param client Pointer to the client to update
      */
     void UpdateQuestTargetEnemies(
@@ -44,6 +44,14 @@ ManagerClientPacket::~ManagerClientPacket()
 {
 }
 
+bool ManagerClientPacket::ProcessMessage(
+    const libcomp::Message::Message *pMessage)
+{
+    ClientPacketBatch batch;
+
+    return libcomp::ManagerPacket::ProcessMessage(pMessage);
+}
+
 bool ManagerClientPacket::ValidateConnectionState(const std::shared_ptr<
     libcomp::TcpConnection>& connection, libcomp::CommandCode_t commandCode) const
 {
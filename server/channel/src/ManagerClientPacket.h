@@ -50,6 +50,14 @@ public:
      */
     virtual ~ManagerClientPacket();
 
+    /**
+     * Process a client packet message. Every packet sent to clients while
+     * the message is handled is written once the handler returns.
+     * @param pMessage Message to process
+     * @return true if the message was handled, false otherwise
+     */
+    virtual bool ProcessMessage(const libcomp::Message::Message *pMessage);
+
 protected:
     virtual bool ValidateConnectionState(const std::shared_ptr<
         libcomp::TcpConnection>& connection, libcomp::CommandCode_t commandCode) const;
@@ -0,0 +1,86 @@
+/**
+ * @file server/channel/src/MetricsHandler.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Web handler that serves the server metrics.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricsHandler.h"
+
+// libcomp Includes
+#include <CString.h>
+
+// channel Includes
+#include "ChannelServer.h"
+#include "ServerMetrics.h"
+
+using namespace channel;
+
+MetricsHandler::MetricsHandler(const std::shared_ptr<ChannelServer>& server)
+    : mServer(server)
+{
+}
+
+MetricsHandler::~MetricsHandler()
+{
+}
+
+bool MetricsHandler::handleGet(CivetServer *pServer,
+    struct mg_connection *pConnection)
+{
+    (void)pServer;
+
+    const mg_request_info *pRequestInfo = mg_get_request_info(pConnection);
+
+    if(nullptr == pRequestInfo)
+    {
+        return false;
+    }
+
+    libcomp::String requestURI(pRequestInfo->request_uri);
+
+    if("/metrics" != requestURI)
+    {
+        return false;
+    }
+
+    auto server = mServer.lock();
+
+    if(!server)
+    {
+        mg_printf(pConnection, "HTTP/1.1 503 Service Unavailable\r\n"
+            "Connection: close\r\n\r\n");
+
+        return true;
+    }
+
+    std::string text = server->GetServerMetrics()->Render();
+
+    mg_printf(pConnection, "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: close\r\n"
+        "\r\n", (uint32_t)text.size());
+    mg_write(pConnection, text.c_str(), text.size());
+
+    return true;
+}
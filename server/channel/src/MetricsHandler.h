@@ -0,0 +1,75 @@
+/**
+ * @file server/channel/src/MetricsHandler.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Web handler that serves the server metrics.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_METRICSHANDLER_H
+#define SERVER_CHANNEL_SRC_METRICSHANDLER_H
+
+// Civet Includes
+#include <CivetServer.h>
+
+// Standard C++11 includes
+#include <memory>
+
+namespace channel
+{
+
+class ChannelServer;
+
+/**
+ * Serves the channel server metrics at /metrics in the Prometheus text
+ * format.
+ */
+class MetricsHandler : public CivetHandler
+{
+public:
+    /**
+     * Create a new metrics handler
+     * @param server Pointer to the channel server to report on
+     */
+    MetricsHandler(const std::shared_ptr<ChannelServer>& server);
+
+    /**
+     * Clean up the handler
+     */
+    virtual ~MetricsHandler();
+
+    /**
+     * Write the current metrics in response to a GET request
+     * @param pServer Pointer to the web server handling the request
+     * @param pConnection Pointer to the requesting connection
+     * @return true if the request was handled
+     */
+    virtual bool handleGet(CivetServer *pServer,
+        struct mg_connection *pConnection);
+
+private:
+    /// Pointer to the channel server
+    std::weak_ptr<ChannelServer> mServer;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_METRICSHANDLER_H
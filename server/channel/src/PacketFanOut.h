@@ -0,0 +1,72 @@
+/**
+ * @file server/channel/src/PacketFanOut.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Helper to hand one packet to several clients.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_PACKETFANOUT_H
+#define SERVER_CHANNEL_SRC_PACKETFANOUT_H
+
+// libcomp Includes
+#include <Packet.h>
+
+// Standard C++11 Includes
+#include <list>
+
+namespace channel
+{
+
+/**
+ * Hand a packet to every client in a list. Each client but the last is
+ * handed its own copy, made from the untouched packet, and the last is
+ * handed the packet itself so it can take the packet data without
+ * another copy. A client may change or take the packet it is handed
+ * without affecting what any other client receives.
+ * @param clients List of clients to hand the packet to
+ * @param packet Packet to hand out which must not be used once this
+ *  returns
+ * @param send Function called with each client, the packet to hand to
+ *  it and true if that packet is a copy
+ */
+template<typename T, typename Send>
+void FanOutPacket(const std::list<T>& clients, libcomp::Packet& packet,
+    Send send)
+{
+    size_t remaining = clients.size();
+    for(auto& client : clients)
+    {
+        if(--remaining)
+        {
+            libcomp::Packet pCopy(packet);
+            send(client, pCopy, true);
+        }
+        else
+        {
+            send(client, packet, false);
+        }
+    }
+}
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_PACKETFANOUT_H
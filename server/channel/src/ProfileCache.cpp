@@ -0,0 +1,301 @@
+/**
+ * @file server/channel/src/ProfileCache.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Read-through cache of character and clan profiles shown by the
+ *  search board and bazaars.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProfileCache.h"
+
+// libcomp Includes
+#include <Database.h>
+
+// object Includes
+#include <Character.h>
+#include <Clan.h>
+#include <ClanMember.h>
+#include <EntityStats.h>
+
+// channel Includes
+#include "ChannelServer.h"
+
+using namespace channel;
+
+ProfileCache::ProfileCache(const std::weak_ptr<ChannelServer>& server)
+    : mServer(server), mMaxSize(0), mTTL(0), mHitCount(0), mMissCount(0)
+{
+}
+
+void ProfileCache::SetLimits(size_t maxSize, uint32_t ttl)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mMaxSize = maxSize;
+    mTTL = (uint64_t)ttl * 1000000ULL;
+
+    while(mEntries.size() > mMaxSize)
+    {
+        mEntries.erase(mUsed.back());
+        mUsed.pop_back();
+    }
+}
+
+std::shared_ptr<CharacterProfile> ProfileCache::GetCharacterProfile(
+    const libobjgen::UUID& uuid)
+{
+    if(uuid.IsNull())
+    {
+        return nullptr;
+    }
+
+    std::string key = uuid.ToString();
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        auto entry = Find(key);
+        if(entry && entry->Character)
+        {
+            mHitCount++;
+            return entry->Character;
+        }
+
+        generation = BeginLoad(key);
+    }
+
+    mMissCount++;
+
+    // Load outside of the lock so slow queries do not block other lookups
+    auto worldDB = mServer.lock()->GetWorldDatabase();
+    auto character = libcomp::PersistentObject::LoadObjectByUUID<
+        objects::Character>(worldDB, uuid);
+    if(!character)
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        FinishLoad(key, generation);
+
+        return nullptr;
+    }
+
+    auto stats = libcomp::PersistentObject::LoadObjectByUUID<
+        objects::EntityStats>(worldDB, character->GetCoreStats().GetUUID());
+
+    auto profile = std::make_shared<CharacterProfile>();
+    profile->Name = character->GetName();
+    profile->Level = stats ? stats->GetLevel() : 0;
+
+    Entry entry;
+    entry.Character = profile;
+    Store(key, generation, entry);
+
+    return profile;
+}
+
+std::shared_ptr<ClanProfile> ProfileCache::GetClanProfile(
+    const libobjgen::UUID& uuid)
+{
+    if(uuid.IsNull())
+    {
+        return nullptr;
+    }
+
+    std::string key = uuid.ToString();
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        auto entry = Find(key);
+        if(entry && entry->Clan)
+        {
+            mHitCount++;
+            return entry->Clan;
+        }
+
+        generation = BeginLoad(key);
+    }
+
+    mMissCount++;
+
+    auto worldDB = mServer.lock()->GetWorldDatabase();
+    auto clan = libcomp::PersistentObject::LoadObjectByUUID<
+        objects::Clan>(worldDB, uuid);
+    if(!clan)
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        FinishLoad(key, generation);
+
+        return nullptr;
+    }
+
+    auto profile = std::make_shared<ClanProfile>();
+    profile->Clan = clan;
+
+    uint8_t memberCount = 0;
+    uint16_t levelSum = 0;
+    for(auto member : objects::ClanMember::LoadClanMemberListByClan(worldDB,
+        clan->GetUUID()))
+    {
+        auto stats = objects::EntityStats::LoadEntityStatsByEntity(worldDB,
+            member->GetCharacter());
+        if(stats)
+        {
+            memberCount++;
+            levelSum = (uint16_t)(levelSum + stats->GetLevel());
+        }
+
+        if(member->GetMemberType() ==
+            objects::ClanMember::MemberType_t::MASTER)
+        {
+            auto master = libcomp::PersistentObject::LoadObjectByUUID<
+                objects::Character>(worldDB, member->GetCharacter());
+
+            profile->MasterUUID = member->GetCharacter();
+            profile->MasterName = master ? master->GetName() : "";
+            profile->MasterLevel = stats ? stats->GetLevel() : 0;
+        }
+    }
+
+    if(memberCount)
+    {
+        profile->AverageLevel = (int8_t)((levelSum * 1.f) /
+            (memberCount * 1.f));
+    }
+
+    Entry entry;
+    entry.Clan = profile;
+    Store(key, generation, entry);
+
+    return profile;
+}
+
+void ProfileCache::Invalidate(const libobjgen::UUID& uuid)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = mEntries.find(uuid.ToString());
+    if(it != mEntries.end())
+    {
+        mUsed.erase(it->second.Used);
+        mEntries.erase(it);
+    }
+
+    // Anything still loading may have read the old values
+    auto pIter = mPending.find(uuid.ToString());
+    if(pIter != mPending.end())
+    {
+        pIter->second.Generation++;
+    }
+}
+
+void ProfileCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mEntries.clear();
+    mUsed.clear();
+
+    for(auto& pair : mPending)
+    {
+        pair.second.Generation++;
+    }
+}
+
+uint64_t ProfileCache::GetHitCount() const
+{
+    return mHitCount;
+}
+
+uint64_t ProfileCache::GetMissCount() const
+{
+    return mMissCount;
+}
+
+ProfileCache::Entry* ProfileCache::Find(const std::string& key)
+{
+    auto it = mEntries.find(key);
+    if(it == mEntries.end())
+    {
+        return nullptr;
+    }
+
+    if(it->second.Expiration <= ChannelServer::GetServerTime())
+    {
+        mUsed.erase(it->second.Used);
+        mEntries.erase(it);
+        return nullptr;
+    }
+
+    // Move to the front of the recently used list
+    mUsed.splice(mUsed.begin(), mUsed, it->second.Used);
+
+    return &it->second;
+}
+
+uint64_t ProfileCache::BeginLoad(const std::string& key)
+{
+    auto& pending = mPending[key];
+    pending.Count++;
+
+    return pending.Generation;
+}
+
+bool ProfileCache::FinishLoad(const std::string& key, uint64_t generation)
+{
+    auto it = mPending.find(key);
+    if(it == mPending.end())
+    {
+        return false;
+    }
+
+    bool current = it->second.Generation == generation;
+    if(--it->second.Count == 0)
+    {
+        mPending.erase(it);
+    }
+
+    return current;
+}
+
+void ProfileCache::Store(const std::string& key, uint64_t generation,
+    Entry entry)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if(!FinishLoad(key, generation) || !mMaxSize)
+    {
+        return;
+    }
+
+    entry.Expiration = ChannelServer::GetServerTime() + mTTL;
+
+    auto it = mEntries.find(key);
+    if(it != mEntries.end())
+    {
+        mUsed.erase(it->second.Used);
+        mEntries.erase(it);
+    }
+
+    mUsed.push_front(key);
+    entry.Used = mUsed.begin();
+    mEntries[key] = entry;
+
+    while(mEntries.size() > mMaxSize)
+    {
+        mEntries.erase(mUsed.back());
+        mUsed.pop_back();
+    }
+}
@@ -0,0 +1,250 @@
+/**
+ * @file server/channel/src/ProfileCache.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Read-through cache of character and clan profiles shown by the
+ *  search board and bazaars.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_PROFILECACHE_H
+#define SERVER_CHANNEL_SRC_PROFILECACHE_H
+
+// libcomp Includes
+#include <CString.h>
+
+// libobjgen Includes
+#include <UUID.h>
+
+// Standard C++11 includes
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace objects
+{
+class Clan;
+}
+
+namespace channel
+{
+
+class ChannelServer;
+
+/**
+ * Summary of a character displayed to other players.
+ */
+struct CharacterProfile
+{
+    /// Name of the character
+    libcomp::String Name;
+
+    /// Current level of the character
+    int8_t Level = 0;
+};
+
+/**
+ * Summary of a clan displayed to other players.
+ */
+struct ClanProfile
+{
+    /// Pointer to the clan
+    std::shared_ptr<objects::Clan> Clan;
+
+    /// UUID of the clan master character
+    libobjgen::UUID MasterUUID;
+
+    /// Name of the clan master character
+    libcomp::String MasterName;
+
+    /// Current level of the clan master character
+    int8_t MasterLevel = 0;
+
+    /// Average level of all clan members
+    int8_t AverageLevel = 0;
+};
+
+/**
+ * Size bounded read-through cache of character and clan profiles loaded
+ * from the world database. Entries expire after a set time and are
+ * invalidated when the world server syncs changes to the search entries
+ * or character logins that refer to them.
+ */
+class ProfileCache
+{
+public:
+    /**
+     * Create a new profile cache
+     * @param server Pointer back to the channel server this belongs to
+     */
+    ProfileCache(const std::weak_ptr<ChannelServer>& server);
+
+    /**
+     * Set the size and lifetime of cached profiles. Nothing is cached
+     * until this is called with a non-zero size.
+     * @param maxSize Maximum number of profiles to cache, 0 disables
+     *  the cache
+     * @param ttl Time in seconds a profile stays cached
+     */
+    void SetLimits(size_t maxSize, uint32_t ttl);
+
+    /**
+     * Get the profile of a character, loading it from the world database
+     * if it is not cached
+     * @param uuid UUID of the character
+     * @return Pointer to the character profile or null if the character
+     *  does not exist
+     */
+    std::shared_ptr<CharacterProfile> GetCharacterProfile(
+        const libobjgen::UUID& uuid);
+
+    /**
+     * Get the profile of a clan, loading it and its members from the
+     * world database if it is not cached
+     * @param uuid UUID of the clan
+     * @return Pointer to the clan profile or null if the clan does not
+     *  exist
+     */
+    std::shared_ptr<ClanProfile> GetClanProfile(const libobjgen::UUID& uuid);
+
+    /**
+     * Remove any profile cached for the supplied UUID
+     * @param uuid UUID of the character or clan
+     */
+    void Invalidate(const libobjgen::UUID& uuid);
+
+    /**
+     * Remove all cached profiles
+     */
+    void Clear();
+
+    /**
+     * Get the number of profiles served from the cache
+     * @return Cache hit count
+     */
+    uint64_t GetHitCount() const;
+
+    /**
+     * Get the number of profiles loaded from the world database
+     * @return Cache miss count
+     */
+    uint64_t GetMissCount() const;
+
+private:
+    /**
+     * Cached profile of either type along with the time it expires
+     */
+    struct Entry
+    {
+        /// Character profile if the entry belongs to a character
+        std::shared_ptr<CharacterProfile> Character;
+
+        /// Clan profile if the entry belongs to a clan
+        std::shared_ptr<ClanProfile> Clan;
+
+        /// Server time the entry expires at
+        uint64_t Expiration;
+
+        /// Position of the entry in the recently used list
+        std::list<std::string>::iterator Used;
+    };
+
+    /**
+     * Loads from the world database in progress for one UUID
+     */
+    struct PendingLoad
+    {
+        /// Number of loads in progress
+        uint32_t Count = 0;
+
+        /// Incremented every time the UUID is invalidated during a load
+        uint64_t Generation = 0;
+    };
+
+    /**
+     * Find an unexpired entry and mark it as recently used. The server
+     * lock must be held when calling this.
+     * @param key UUID string of the entry
+     * @return Pointer to the entry or null if it is not cached
+     */
+    Entry* Find(const std::string& key);
+
+    /**
+     * Mark the start of a load from the world database. The server lock
+     * must be held when calling this.
+     * @param key UUID string of the entry being loaded
+     * @return Generation of the UUID to pass to @ref FinishLoad
+     */
+    uint64_t BeginLoad(const std::string& key);
+
+    /**
+     * Mark the end of a load started by @ref BeginLoad. The server lock
+     * must be held when calling this.
+     * @param key UUID string of the entry that was loaded
+     * @param generation Generation returned by @ref BeginLoad
+     * @return true if the UUID was not invalidated during the load
+     */
+    bool FinishLoad(const std::string& key, uint64_t generation);
+
+    /**
+     * Store a newly loaded profile, evicting the least recently used
+     * entries past the size limit. The profile is dropped instead if the
+     * UUID was invalidated while it was being loaded as it may already be
+     * out of date.
+     * @param key UUID string of the entry
+     * @param generation Generation returned by @ref BeginLoad
+     * @param entry Entry to store
+     */
+    void Store(const std::string& key, uint64_t generation, Entry entry);
+
+    /// Pointer to the channel server
+    std::weak_ptr<ChannelServer> mServer;
+
+    /// Cached profiles by UUID string
+    std::unordered_map<std::string, Entry> mEntries;
+
+    /// UUID strings of cached profiles, most recently used first
+    std::list<std::string> mUsed;
+
+    /// Loads in progress by UUID string
+    std::unordered_map<std::string, PendingLoad> mPending;
+
+    /// Maximum number of profiles to cache, 0 disables the cache
+    size_t mMaxSize;
+
+    /// Time in microseconds a profile stays cached
+    uint64_t mTTL;
+
+    /// Number of profiles served from the cache
+    std::atomic<uint64_t> mHitCount;
+
+    /// Number of profiles loaded from the world database
+    std::atomic<uint64_t> mMissCount;
+
+    /// Server lock for the cached profiles
+    std::mutex mLock;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_PROFILECACHE_H
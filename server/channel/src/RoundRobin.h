@@ -0,0 +1,71 @@
+/**
+ * @file server/channel/src/RoundRobin.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Helper to order entities for round-robin updates.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_ROUNDROBIN_H
+#define SERVER_CHANNEL_SRC_ROUNDROBIN_H
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <cstdint>
+#include <list>
+
+namespace channel
+{
+
+/**
+ * Order a list of entries for the next pass of a round-robin update.
+ * Entries are sorted by entity ID and rotated so the pass starts with
+ * the first entity ID after the one the last pass stopped at. If that
+ * entity no longer exists the pass still starts with the next highest
+ * entity ID so a removal never sends the rotation back to the start.
+ * @param entries List of entries to order
+ * @param resumeID Entity ID the last pass stopped at or 0 to start at
+ *  the lowest entity ID
+ * @param getID Function returning the entity ID of an entry
+ */
+template<typename T, typename GetID>
+void OrderRoundRobin(std::list<T>& entries, int32_t resumeID, GetID getID)
+{
+    entries.sort([&getID](const T& a, const T& b)
+        {
+            return getID(a) < getID(b);
+        });
+
+    if(resumeID)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(),
+            [&getID, resumeID](const T& entry)
+            {
+                return getID(entry) > resumeID;
+            });
+
+        entries.splice(entries.end(), entries, entries.begin(), it);
+    }
+}
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_ROUNDROBIN_H
@@ -0,0 +1,196 @@
+/**
+ * @file server/channel/src/ServerDataStamp.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Fingerprint of the data store used to skip verifying server
+ *  data that has not changed.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ServerDataStamp.h"
+
+// libcomp Includes
+#include <DataStore.h>
+#include <Git.h>
+
+// Standard C++11 Includes
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <list>
+
+// OpenSSL Includes
+#include <openssl/evp.h>
+
+using namespace channel;
+
+// Bump this when the way the checksum is calculated changes
+#define SERVER_DATA_STAMP_VERSION "2"
+
+namespace
+{
+
+/**
+ * Get the first line of the stamp file. This includes the server version
+ * as well as the stamp format so a new build verifies the data again.
+ * @return First line of the stamp file
+ */
+std::string GetStampHeader()
+{
+    return libcomp::String("%1 %2.%3.%4").Arg(SERVER_DATA_STAMP_VERSION)
+        .Arg(VERSION_MAJOR).Arg(VERSION_MINOR).Arg(VERSION_PATCH).ToUtf8();
+}
+
+} // namespace
+
+ServerDataStamp::ServerDataStamp(const libcomp::String& path) :
+    mPath(path), mFileCount(0), mCalculateTime(0), mVerifyTime(0)
+{
+}
+
+bool ServerDataStamp::Calculate(libcomp::DataStore *pDataStore)
+{
+    mChecksum = libcomp::String();
+    mFileCount = 0;
+    mCalculateTime = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::list<libcomp::String> files;
+    std::list<libcomp::String> dirs;
+    std::list<libcomp::String> symLinks;
+
+    if(!pDataStore || !pDataStore->GetListing("/", files, dirs, symLinks,
+        true, true))
+    {
+        return false;
+    }
+
+    // Sort so the checksum does not depend on the listing order
+    files.sort();
+
+    EVP_MD_CTX *pHash = EVP_MD_CTX_create();
+    EVP_DigestInit_ex(pHash, EVP_sha1(), nullptr);
+
+    for(auto& file : files)
+    {
+        auto data = pDataStore->ReadFile(file);
+
+        // Hash the path and size as well so a file being renamed or
+        // moved between files is noticed
+        libcomp::String header = libcomp::String("%1:%2\n").Arg(file)
+            .Arg(data.size());
+        auto headerData = header.ToUtf8();
+
+        EVP_DigestUpdate(pHash, headerData.c_str(), headerData.size());
+
+        if(!data.empty())
+        {
+            EVP_DigestUpdate(pHash, &data[0], data.size());
+        }
+
+        mFileCount++;
+    }
+
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestSize = 0;
+
+    EVP_DigestFinal_ex(pHash, digest, &digestSize);
+    EVP_MD_CTX_destroy(pHash);
+
+    char szHash[EVP_MAX_MD_SIZE * 2 + 1] = { 0 };
+
+    for(unsigned int i = 0; i < digestSize; i++)
+    {
+        std::snprintf(&szHash[i * 2], 3, "%02x", digest[i]);
+    }
+
+    mChecksum = szHash;
+    mCalculateTime = (uint64_t)std::chrono::duration_cast<
+        std::chrono::microseconds>(std::chrono::steady_clock::now() -
+        start).count();
+
+    return true;
+}
+
+bool ServerDataStamp::Matches() const
+{
+    mVerifyTime = 0;
+
+    if(mChecksum.IsEmpty() || mPath.IsEmpty())
+    {
+        return false;
+    }
+
+    std::ifstream file(mPath.C());
+
+    std::string header, checksum;
+    uint64_t verifyTime = 0;
+    if(!std::getline(file, header) || !std::getline(file, checksum) ||
+        !(file >> verifyTime))
+    {
+        return false;
+    }
+
+    if(header != GetStampHeader() || checksum != mChecksum.ToUtf8())
+    {
+        return false;
+    }
+
+    mVerifyTime = verifyTime;
+
+    return true;
+}
+
+bool ServerDataStamp::Save(uint64_t verifyTime) const
+{
+    if(mChecksum.IsEmpty() || mPath.IsEmpty())
+    {
+        return false;
+    }
+
+    std::ofstream file(mPath.C(), std::ios::out | std::ios::trunc);
+    file << GetStampHeader() << std::endl
+        << mChecksum.ToUtf8() << std::endl
+        << verifyTime << std::endl;
+
+    return file.good();
+}
+
+libcomp::String ServerDataStamp::GetChecksum() const
+{
+    return mChecksum;
+}
+
+size_t ServerDataStamp::GetFileCount() const
+{
+    return mFileCount;
+}
+
+uint64_t ServerDataStamp::GetCalculateTime() const
+{
+    return mCalculateTime;
+}
+
+uint64_t ServerDataStamp::GetVerifyTime() const
+{
+    return mVerifyTime;
+}
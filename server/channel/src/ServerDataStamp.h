@@ -0,0 +1,131 @@
+/**
+ * @file server/channel/src/ServerDataStamp.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Fingerprint of the data store used to skip verifying server
+ *  data that has not changed.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_SERVERDATASTAMP_H
+#define SERVER_CHANNEL_SRC_SERVERDATASTAMP_H
+
+// libcomp Includes
+#include <CString.h>
+
+// Standard C++11 Includes
+#include <stdint.h>
+
+namespace libcomp
+{
+class DataStore;
+}
+
+namespace channel
+{
+
+/**
+ * Checksum of every file in the data store that is written once the
+ * server data has been verified. Later starts calculate the checksum
+ * again and only verify the server data when it no longer matches or the
+ * stamp was written by a different server version. The time the last
+ * verification took is kept with it so the cost of calculating the
+ * checksum can be compared against it.
+ */
+class ServerDataStamp
+{
+public:
+    /**
+     * Create a new server data stamp
+     * @param path Path to the stamp file
+     */
+    ServerDataStamp(const libcomp::String& path);
+
+    /**
+     * Calculate the checksum of every file in the data store
+     * @param pDataStore Pointer to the data store
+     * @return true if the checksum was calculated, false if the data
+     *  store could not be read
+     */
+    bool Calculate(libcomp::DataStore *pDataStore);
+
+    /**
+     * Check if the stamp file was written for the calculated checksum
+     * @return true if the data has already been verified
+     */
+    bool Matches() const;
+
+    /**
+     * Write the calculated checksum to the stamp file
+     * @param verifyTime Time in microseconds the verification of the
+     *  server data took
+     * @return true if the stamp file was written
+     */
+    bool Save(uint64_t verifyTime) const;
+
+    /**
+     * Get the calculated checksum
+     * @return Hex string of the checksum or an empty string if it has not
+     *  been calculated
+     */
+    libcomp::String GetChecksum() const;
+
+    /**
+     * Get the number of files included in the checksum
+     * @return Number of files included in the checksum
+     */
+    size_t GetFileCount() const;
+
+    /**
+     * Get the time the checksum took to calculate
+     * @return Time in microseconds the checksum took to calculate
+     */
+    uint64_t GetCalculateTime() const;
+
+    /**
+     * Get the time the verification the matching stamp file was written
+     * for took
+     * @return Time in microseconds the verification took or 0 if the
+     *  stamp file does not match
+     */
+    uint64_t GetVerifyTime() const;
+
+private:
+    /// Path to the stamp file
+    libcomp::String mPath;
+
+    /// Hex string of the calculated checksum
+    libcomp::String mChecksum;
+
+    /// Number of files included in the checksum
+    size_t mFileCount;
+
+    /// Time in microseconds the checksum took to calculate
+    uint64_t mCalculateTime;
+
+    /// Time in microseconds the verification the stamp file was written
+    /// for took, set by @ref Matches
+    mutable uint64_t mVerifyTime;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_SERVERDATASTAMP_H
@@ -0,0 +1,293 @@
+/**
+ * @file server/channel/src/ServerMetrics.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Counters reported by the channel metrics endpoint.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ServerMetrics.h"
+
+// libcomp Includes
+#include <ScriptEngine.h>
+
+// channel Includes
+#include "AIManager.h"
+#include "ChannelClientConnection.h"
+#include "ChannelServer.h"
+#include "ChannelSyncManager.h"
+#include "EntityPacketCache.h"
+#include "ManagerConnection.h"
+#include "ProfileCache.h"
+#include "TokuseiManager.h"
+#include "Zone.h"
+#include "ZoneManager.h"
+
+using namespace channel;
+
+std::atomic<int64_t> ServerMetrics::sScriptEngines[
+    (size_t)ScriptEngineType_t::COUNT];
+
+namespace
+{
+
+/// Write the help and type lines that precede a metric
+void WriteHeader(std::ostream& out, const std::string& name,
+    const std::string& type, const std::string& help)
+{
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+/// Write a metric with a single unlabeled sample
+template<typename T>
+void WriteValue(std::ostream& out, const std::string& name,
+    const std::string& type, const std::string& help, T value)
+{
+    WriteHeader(out, name, type, help);
+    out << name << " " << value << "\n";
+}
+
+} // namespace
+
+MetricsHistogram::MetricsHistogram(std::initializer_list<uint64_t> bounds)
+    : mBounds(bounds), mCounts(new std::atomic<uint64_t>[bounds.size() + 1]),
+    mSum(0)
+{
+    for(size_t i = 0; i <= mBounds.size(); i++)
+    {
+        mCounts[i] = 0;
+    }
+}
+
+void MetricsHistogram::Observe(uint64_t value)
+{
+    size_t i = 0;
+    while(i < mBounds.size() && value > mBounds[i])
+    {
+        i++;
+    }
+
+    mCounts[i]++;
+    mSum += value;
+}
+
+void MetricsHistogram::Write(std::ostream& out, const std::string& name,
+    const std::string& labels) const
+{
+    std::string prefix = labels.empty() ? "{" : ("{" + labels + ",");
+
+    // Buckets are cumulative in the text format
+    uint64_t total = 0;
+    for(size_t i = 0; i < mBounds.size(); i++)
+    {
+        total += mCounts[i];
+        out << name << "_bucket" << prefix << "le=\"" << mBounds[i]
+            << "\"} " << total << "\n";
+    }
+
+    total += mCounts[mBounds.size()];
+    out << name << "_bucket" << prefix << "le=\"+Inf\"} " << total << "\n";
+
+    std::string suffix = labels.empty() ? "" : ("{" + labels + "}");
+    out << name << "_sum" << suffix << " " << mSum << "\n";
+    out << name << "_count" << suffix << " " << total << "\n";
+}
+
+ServerMetrics::ServerMetrics(const std::weak_ptr<ChannelServer>& server)
+    : mServer(server),
+    mTickDuration({ 1000, 5000, 10000, 25000, 50000, 100000, 250000,
+        500000, 1000000 }),
+    mWorldFlushDuration({ 100, 500, 1000, 5000, 10000, 50000, 100000,
+        500000 }),
+    mLobbyFlushDuration({ 100, 500, 1000, 5000, 10000, 50000, 100000,
+        500000 }),
+    mTicksMissed(0)
+{
+}
+
+void ServerMetrics::RecordTick(uint64_t duration)
+{
+    mTickDuration.Observe(duration);
+}
+
+void ServerMetrics::RecordMissedTick()
+{
+    mTicksMissed++;
+}
+
+void ServerMetrics::RecordDatabaseFlush(bool world, uint64_t duration)
+{
+    if(world)
+    {
+        mWorldFlushDuration.Observe(duration);
+    }
+    else
+    {
+        mLobbyFlushDuration.Observe(duration);
+    }
+}
+
+std::string ServerMetrics::Render()
+{
+    std::ostringstream out;
+
+    auto server = mServer.lock();
+    if(!server)
+    {
+        return out.str();
+    }
+
+    WriteHeader(out, "comp_channel_tick_duration_microseconds", "histogram",
+        "Time taken to process each server tick.");
+    mTickDuration.Write(out, "comp_channel_tick_duration_microseconds");
+
+    WriteValue(out, "comp_channel_ticks_missed_total", "counter",
+        "Server ticks not queued because earlier ticks were still pending.",
+        (uint64_t)mTicksMissed);
+
+    WriteValue(out, "comp_channel_tick_queue_depth", "gauge",
+        "Server ticks queued and not yet processed.",
+        (uint32_t)server->GetPendingTickCount());
+
+    WriteHeader(out, "comp_channel_db_flush_duration_microseconds",
+        "histogram", "Time taken to process a database transaction queue.");
+    mWorldFlushDuration.Write(out,
+        "comp_channel_db_flush_duration_microseconds", "database=\"world\"");
+    mLobbyFlushDuration.Write(out,
+        "comp_channel_db_flush_duration_microseconds", "database=\"lobby\"");
+
+    WriteValue(out, "comp_channel_clients", "gauge",
+        "Client connections with a logged in account.",
+        server->GetManagerConnection()->GetAllConnections().size());
+
+    // Zone states are only read here so the tick is not slowed down
+    auto zoneManager = server->GetZoneManager();
+    auto zones = zoneManager->GetActiveZones();
+
+    WriteValue(out, "comp_channel_active_zones", "gauge",
+        "Zones currently being updated.", zones.size());
+
+    WriteValue(out, "comp_channel_instances", "gauge",
+        "Zone instances that currently exist.",
+        zoneManager->GetInstanceCount());
+
+    WriteHeader(out, "comp_channel_zone_clients", "gauge",
+        "Clients in each active zone.");
+    for(auto& zone : zones)
+    {
+        out << "comp_channel_zone_clients{zone=\"" << zone->GetDefinitionID()
+            << "\",id=\"" << zone->GetID() << "\",instance=\""
+            << zone->GetInstanceID() << "\"} "
+            << zone->GetConnectionList().size() << "\n";
+    }
+
+    auto syncManager = server->GetChannelSyncManager();
+    WriteValue(out, "comp_channel_sync_received_packets_total", "counter",
+        "Sync packets received from the world.",
+        syncManager->GetIncomingPacketCount());
+    WriteValue(out, "comp_channel_sync_received_bytes_total", "counter",
+        "Sync packet bytes received from the world.",
+        syncManager->GetIncomingByteCount());
+
+    WriteValue(out, "comp_channel_client_writes_total", "counter",
+        "Writes made to client connections.",
+        ChannelClientConnection::GetTotalWriteCount());
+    WriteValue(out, "comp_channel_client_written_bytes_total", "counter",
+        "Bytes written to client connections.",
+        ChannelClientConnection::GetTotalBytesWritten());
+    WriteValue(out, "comp_channel_client_deferred_flushes_total", "counter",
+        "Client writes deferred to be batched with later packets.",
+        ChannelClientConnection::GetDeferredFlushCount());
+
+    WriteValue(out, "comp_channel_packet_copies_total", "counter",
+        "Packets copied to be sent to more than one client.",
+        ChannelClientConnection::GetPacketCopyCount());
+    WriteValue(out, "comp_channel_packet_copied_bytes_total", "counter",
+        "Packet bytes copied to be sent to more than one client.",
+        ChannelClientConnection::GetPacketCopyBytes());
+    WriteValue(out, "comp_channel_packet_copies_avoided_total", "counter",
+        "Packet copies avoided by the last client taking the packet.",
+        ChannelClientConnection::GetPacketCopiesAvoided());
+    WriteValue(out, "comp_channel_packet_fan_out_max", "gauge",
+        "Largest number of clients a single packet has been sent to.",
+        ChannelClientConnection::GetLargestFanOut());
+
+    auto aiManager = server->GetAIManager();
+    WriteValue(out, "comp_channel_ai_deferred_updates_total", "counter",
+        "AI updates deferred by the tick budget.",
+        aiManager->GetBudgetDeferredCount());
+    WriteValue(out, "comp_channel_ai_worst_tick_microseconds", "gauge",
+        "Longest time spent updating AI during a single tick.",
+        aiManager->GetWorstTickTime());
+
+    WriteValue(out, "comp_channel_entity_packet_cache_hits_total", "counter",
+        "Entity packets reused from the cache.",
+        EntityPacketCache::GetHitCount());
+    WriteValue(out, "comp_channel_entity_packet_cache_misses_total",
+        "counter", "Entity packets built because none were cached.",
+        EntityPacketCache::GetMissCount());
+
+    auto profileCache = syncManager->GetProfileCache();
+    WriteValue(out, "comp_channel_profile_cache_hits_total", "counter",
+        "Profiles read from the cache.", profileCache->GetHitCount());
+    WriteValue(out, "comp_channel_profile_cache_misses_total", "counter",
+        "Profiles loaded because none were cached.",
+        profileCache->GetMissCount());
+
+    auto tokuseiManager = server->GetTokuseiManager();
+    WriteValue(out, "comp_channel_tokusei_conditions_evaluated_total",
+        "counter", "Tokusei conditions evaluated.",
+        tokuseiManager->GetConditionEvaluationCount());
+    WriteValue(out, "comp_channel_tokusei_conditions_reused_total",
+        "counter", "Tokusei condition results reused.",
+        tokuseiManager->GetConditionReuseCount());
+
+    WriteHeader(out, "comp_channel_script_engines", "gauge",
+        "Script engines that currently exist.");
+    const char* types[] = { "ai", "event", "action", "skill" };
+    for(size_t i = 0; i < (size_t)ScriptEngineType_t::COUNT; i++)
+    {
+        out << "comp_channel_script_engines{type=\"" << types[i] << "\"} "
+            << GetScriptEngineCount((ScriptEngineType_t)i) << "\n";
+    }
+
+    return out.str();
+}
+
+std::shared_ptr<libcomp::ScriptEngine> ServerMetrics::CreateScriptEngine(
+    ScriptEngineType_t type)
+{
+    auto& count = sScriptEngines[(size_t)type];
+    count++;
+
+    return std::shared_ptr<libcomp::ScriptEngine>(new libcomp::ScriptEngine,
+        [&count](libcomp::ScriptEngine* engine)
+        {
+            count--;
+            delete engine;
+        });
+}
+
+int64_t ServerMetrics::GetScriptEngineCount(ScriptEngineType_t type)
+{
+    return sScriptEngines[(size_t)type];
+}
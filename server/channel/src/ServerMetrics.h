@@ -0,0 +1,179 @@
+/**
+ * @file server/channel/src/ServerMetrics.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Counters reported by the channel metrics endpoint.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_SERVERMETRICS_H
+#define SERVER_CHANNEL_SRC_SERVERMETRICS_H
+
+// Standard C++11 includes
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace libcomp
+{
+class ScriptEngine;
+}
+
+namespace channel
+{
+
+class ChannelServer;
+
+/**
+ * Histogram with fixed bucket bounds that can be updated from any thread
+ * without locking.
+ */
+class MetricsHistogram
+{
+public:
+    /**
+     * Create a new histogram
+     * @param bounds Inclusive upper bound of each bucket in ascending order
+     */
+    MetricsHistogram(std::initializer_list<uint64_t> bounds);
+
+    /**
+     * Record a value in the histogram
+     * @param value Value to record
+     */
+    void Observe(uint64_t value);
+
+    /**
+     * Write the histogram in the Prometheus text format
+     * @param out Stream to write to
+     * @param name Name of the metric
+     * @param labels Labels to add to every sample, formatted as
+     *  name="value" pairs separated by commas
+     */
+    void Write(std::ostream& out, const std::string& name,
+        const std::string& labels = "") const;
+
+private:
+    /// Inclusive upper bound of each bucket
+    std::vector<uint64_t> mBounds;
+
+    /// Number of values recorded in each bucket with one more for values
+    /// above the last bound
+    std::unique_ptr<std::atomic<uint64_t>[]> mCounts;
+
+    /// Sum of all values recorded
+    std::atomic<uint64_t> mSum;
+};
+
+/**
+ * Channel server counters exposed by the metrics endpoint. Counters are
+ * atomics updated as work happens and everything else is read from the
+ * server only when the metrics are requested.
+ */
+class ServerMetrics
+{
+public:
+    /**
+     * Purpose a script engine is created for
+     */
+    enum class ScriptEngineType_t : uint8_t
+    {
+        AI = 0,    //!< AI script
+        EVENT,     //!< Event script
+        ACTION,    //!< Action script
+        SKILL,     //!< Skill logic script
+        COUNT,     //!< Number of script engine types
+    };
+
+    /**
+     * Create a new server metrics tracker
+     * @param server Pointer back to the channel server this belongs to
+     */
+    ServerMetrics(const std::weak_ptr<ChannelServer>& server);
+
+    /**
+     * Record the time taken to process a server tick
+     * @param duration Time taken in microseconds
+     */
+    void RecordTick(uint64_t duration);
+
+    /**
+     * Record a server tick that was not queued because the previous ticks
+     * have not been processed yet
+     */
+    void RecordMissedTick();
+
+    /**
+     * Record the time taken to process a database transaction queue
+     * @param world true if the world database was flushed, false if the
+     *  lobby database was flushed
+     * @param duration Time taken in microseconds
+     */
+    void RecordDatabaseFlush(bool world, uint64_t duration);
+
+    /**
+     * Get every metric in the Prometheus text format
+     * @return Metrics text
+     */
+    std::string Render();
+
+    /**
+     * Create a new script engine that is counted until it is destroyed
+     * @param type Purpose the engine is being created for
+     * @return Pointer to the new script engine
+     */
+    static std::shared_ptr<libcomp::ScriptEngine> CreateScriptEngine(
+        ScriptEngineType_t type);
+
+    /**
+     * Get the number of script engines that currently exist
+     * @param type Purpose the engines were created for
+     * @return Number of script engines
+     */
+    static int64_t GetScriptEngineCount(ScriptEngineType_t type);
+
+private:
+    /// Pointer to the channel server
+    std::weak_ptr<ChannelServer> mServer;
+
+    /// Time taken to process each server tick
+    MetricsHistogram mTickDuration;
+
+    /// Time taken to process the world database transaction queue
+    MetricsHistogram mWorldFlushDuration;
+
+    /// Time taken to process the lobby database transaction queue
+    MetricsHistogram mLobbyFlushDuration;
+
+    /// Number of server ticks missed
+    std::atomic<uint64_t> mTicksMissed;
+
+    /// Number of script engines that exist by ScriptEngineType_t
+    static std::atomic<int64_t> sScriptEngines[
+        (size_t)ScriptEngineType_t::COUNT];
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_SERVERMETRICS_H
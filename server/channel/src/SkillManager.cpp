@@ -138,6 +138,7 @@
 #include "EventManager.h"
 #include "ManagerConnection.h"
 #include "MatchManager.h"
+#include "ServerMetrics.h"
 #include "TokuseiManager.h"
 #include "Zone.h"
 #include "ZoneInstance.h"
@@ -416,7 +417,8 @@ void SkillManager::LoadScripts()
     // Prepare scripts and load settings
     for(auto def : scriptDefs)
     {
-        auto script = std::make_shared<libcomp::ScriptEngine>();
+        auto script = ServerMetrics::CreateScriptEngine(
+            ServerMetrics::ScriptEngineType_t::SKILL);
 
         if(!script->Eval(def->Source))
         {
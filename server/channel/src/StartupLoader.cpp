@@ -0,0 +1,203 @@
+/**
+ * @file server/channel/src/StartupLoader.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Runs channel startup load tasks in dependency order on a
+ *  pool of threads.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace channel;
+
+StartupLoader::StartupLoader() : mRunning(0), mFailed(false), mTotalTime(0)
+{
+}
+
+bool StartupLoader::AddTask(const libcomp::String& name,
+    const std::function<bool()>& task,
+    const std::list<libcomp::String>& dependencies)
+{
+    Task t;
+    t.Name = name;
+    t.Function = task;
+
+    size_t idx = mTasks.size();
+    for(auto& dependency : dependencies)
+    {
+        auto it = std::find_if(mTasks.begin(), mTasks.end(),
+            [dependency](const Task& other)
+            {
+                return other.Name == dependency;
+            });
+
+        if(it == mTasks.end())
+        {
+            return false;
+        }
+
+        it->Dependents.push_back(idx);
+        t.Waiting++;
+    }
+
+    mTasks.push_back(t);
+
+    return true;
+}
+
+bool StartupLoader::Run(size_t threadCount)
+{
+    if(!threadCount)
+    {
+        threadCount = (size_t)std::max(std::thread::hardware_concurrency(),
+            1U);
+    }
+
+    threadCount = std::min(threadCount, mTasks.size());
+
+    for(size_t i = 0; i < mTasks.size(); i++)
+    {
+        if(!mTasks[i].Waiting)
+        {
+            mReady.push_back(i);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // The calling thread works as well so only start the extra threads
+    std::list<std::thread> threads;
+    for(size_t i = 1; i < threadCount; i++)
+    {
+        threads.push_back(std::thread([this]()
+        {
+            Work();
+        }));
+    }
+
+    Work();
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    mTotalTime = (uint64_t)std::chrono::duration_cast<
+        std::chrono::microseconds>(std::chrono::steady_clock::now() -
+            start).count();
+
+    return GetFailedTask().IsEmpty();
+}
+
+libcomp::String StartupLoader::GetFailedTask() const
+{
+    for(auto& task : mTasks)
+    {
+        if(!task.Succeeded)
+        {
+            return task.Name;
+        }
+    }
+
+    return libcomp::String();
+}
+
+std::list<std::pair<libcomp::String, uint64_t>>
+    StartupLoader::GetTimings() const
+{
+    std::list<std::pair<libcomp::String, uint64_t>> timings;
+    for(auto& task : mTasks)
+    {
+        if(task.Ran)
+        {
+            timings.push_back(std::make_pair(task.Name, task.Time));
+        }
+    }
+
+    return timings;
+}
+
+uint64_t StartupLoader::GetTotalTime() const
+{
+    return mTotalTime;
+}
+
+void StartupLoader::Work()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while(true)
+    {
+        mCondition.wait(lock, [this]()
+        {
+            return mFailed || !mReady.empty() || !mRunning;
+        });
+
+        // Stop once a task has failed or nothing is left that could
+        // become ready
+        if(mFailed || mReady.empty())
+        {
+            break;
+        }
+
+        size_t idx = mReady.front();
+        mReady.pop_front();
+        mRunning++;
+
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        bool success = mTasks[idx].Function();
+        uint64_t time = (uint64_t)std::chrono::duration_cast<
+            std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                start).count();
+
+        lock.lock();
+
+        auto& task = mTasks[idx];
+        task.Ran = true;
+        task.Succeeded = success;
+        task.Time = time;
+        mRunning--;
+
+        if(success)
+        {
+            for(size_t dependent : task.Dependents)
+            {
+                if(!--mTasks[dependent].Waiting)
+                {
+                    mReady.push_back(dependent);
+                }
+            }
+        }
+        else
+        {
+            mFailed = true;
+        }
+
+        mCondition.notify_all();
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file server/channel/src/StartupLoader.h
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Runs channel startup load tasks in dependency order on a
+ *  pool of threads.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_CHANNEL_SRC_STARTUPLOADER_H
+#define SERVER_CHANNEL_SRC_STARTUPLOADER_H
+
+// libcomp Includes
+#include <CString.h>
+
+// Standard C++11 includes
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace channel
+{
+
+/**
+ * Runs a set of named load tasks on a pool of threads. Each task starts
+ * as soon as every task it depends on has finished successfully so
+ * independent data is loaded at the same time. Once a task fails no new
+ * tasks are started and the failure reported is always the first failed
+ * task in the order they were added, regardless of which finished first.
+ */
+class StartupLoader
+{
+public:
+    /**
+     * Create a new startup loader
+     */
+    StartupLoader();
+
+    /**
+     * Add a task to run
+     * @param name Name of the task used for timings and errors
+     * @param task Function to run that returns false on failure
+     * @param dependencies Names of previously added tasks that must
+     *  finish before this task can start
+     * @return false if a dependency has not been added
+     */
+    bool AddTask(const libcomp::String& name,
+        const std::function<bool()>& task,
+        const std::list<libcomp::String>& dependencies = {});
+
+    /**
+     * Run all tasks and wait for them to finish
+     * @param threadCount Maximum number of tasks to run at once, 0 uses
+     *  one thread per core
+     * @return true if every task succeeded
+     */
+    bool Run(size_t threadCount = 0);
+
+    /**
+     * Get the name of the first task that failed
+     * @return Name of the first task in the order added that failed or
+     *  did not run because a dependency failed, empty if all succeeded
+     */
+    libcomp::String GetFailedTask() const;
+
+    /**
+     * Get the time each task took to run in the order they were added.
+     * Tasks that did not run are not included.
+     * @return List of task names and run times in microseconds
+     */
+    std::list<std::pair<libcomp::String, uint64_t>> GetTimings() const;
+
+    /**
+     * Get the time all tasks took to run
+     * @return Time from the first task starting to the last task
+     *  finishing in microseconds
+     */
+    uint64_t GetTotalTime() const;
+
+private:
+    /**
+     * State of one task
+     */
+    struct Task
+    {
+        /// Name of the task
+        libcomp::String Name;
+
+        /// Function to run
+        std::function<bool()> Function;
+
+        /// Indexes of the tasks that depend on this one
+        std::list<size_t> Dependents;
+
+        /// Number of dependencies that have not finished yet
+        size_t Waiting = 0;
+
+        /// true once the task has run
+        bool Ran = false;
+
+        /// true if the task ran and succeeded
+        bool Succeeded = false;
+
+        /// Time in microseconds the task took to run
+        uint64_t Time = 0;
+    };
+
+    /**
+     * Run tasks from the ready list until none are left to run
+     */
+    void Work();
+
+    /// All tasks in the order they were added
+    std::vector<Task> mTasks;
+
+    /// Indexes of tasks whose dependencies have all finished
+    std::list<size_t> mReady;
+
+    /// Number of tasks currently running
+    size_t mRunning;
+
+    /// true once a task has failed
+    bool mFailed;
+
+    /// Time all tasks took to run in microseconds
+    uint64_t mTotalTime;
+
+    /// Lock for the task states
+    std::mutex mLock;
+
+    /// Signalled when a task finishes
+    std::condition_variable mCondition;
+};
+
+} // namespace channel
+
+#endif // SERVER_CHANNEL_SRC_STARTUPLOADER_H
@@ -77,7 +77,8 @@
 using namespace channel;
 
 TokuseiManager::TokuseiManager(const std::weak_ptr<
-    ChannelServer>& server) : mServer(server)
+    ChannelServer>& server) : mConditionEvaluationCount(0),
+    mConditionReuseCount(0), mServer(server)
 {
 }
 
@@ -98,6 +99,14 @@ bool TokuseiManager::Initialize()
         // 1) Conditional
         // 2) Inherited from secondary sources
         // 3) Chaining other skill granting effects
+        // Keep track of which inputs the conditions depend upon so targeted
+        // recalculations only need to evaluate the affected tokusei
+        for(auto condition : tPair.second->GetConditions())
+        {
+            mConditionDependencies[tPair.first].insert(
+                (int8_t)condition->GetType());
+        }
+
         std::set<uint32_t> skillIDs;
         for(auto aspect : tPair.second->GetAspects())
         {
@@ -636,7 +645,7 @@ std::unordered_map<int32_t, bool> TokuseiManager::Recalculate(const std::shared_
 
     if(doRecalc)
     {
-        return Recalculate(eState, true);
+        return Recalculate(GetAllTokuseiEntities(eState), true, {}, changes);
     }
 
     return std::unordered_map<int32_t, bool>();
@@ -650,7 +659,8 @@ std::unordered_map<int32_t, bool> TokuseiManager::Recalculate(const std::shared_
 }
 
 std::unordered_map<int32_t, bool> TokuseiManager::Recalculate(const std::list<std::shared_ptr<
-    ActiveEntityState>>& entities, bool recalcStats, std::set<int32_t> ignoreStatRecalc)
+    ActiveEntityState>>& entities, bool recalcStats, std::set<int32_t> ignoreStatRecalc,
+    std::set<TokuseiConditionType> changes)
 {
     std::unordered_map<int32_t, bool> result;
 
@@ -689,6 +699,12 @@ std::unordered_map<int32_t, bool> TokuseiManager::Recalculate(const std::list<st
 
         std::set<int8_t> triggers;
 
+        // If the changes are known, previous condition results can be
+        // reused for any tokusei that does not depend upon them
+        auto calcState = eState->GetCalculatedState();
+        bool ready = eState->Ready(true);
+        bool targeted = ready && changes.size() > 0;
+
         std::unordered_map<int32_t, bool> evaluated;
         for(auto tokusei : GetDirectTokusei(eState))
         {
@@ -701,7 +717,19 @@ std::unordered_map<int32_t, bool> TokuseiManager::Recalculate(const std::list<st
             }
             else
             {
-                add = EvaluateTokuseiConditions(eState, tokusei);
+                if(targeted &&
+                    calcState->TokuseiConditionResultsKeyExists(tokuseiID) &&
+                    !ConditionsDependOn(tokuseiID, changes))
+                {
+                    add = calcState->GetTokuseiConditionResults(tokuseiID);
+                    mConditionReuseCount++;
+                }
+                else
+                {
+                    add = EvaluateTokuseiConditions(eState, tokusei);
+                    mConditionEvaluationCount++;
+                }
+
                 evaluated[tokuseiID] = add;
 
                 if(worldCID &&
@@ -775,7 +803,11 @@ std::unordered_map<int32_t, bool> TokuseiManager::Recalculate(const std::list<st
             }
         }
 
-        eState->GetCalculatedState()->SetActiveTokuseiTriggers(triggers);
+        calcState->SetActiveTokuseiTriggers(triggers);
+
+        // Results are only reliable once the entity is ready
+        calcState->SetTokuseiConditionResults(ready ? evaluated
+            : std::unordered_map<int32_t, bool>());
     }
 
     // Set or clear all timed tokusei for player entities
@@ -2165,11 +2197,24 @@ void TokuseiManager::RecalcTimedTokusei(WorldClock& clock)
         auto state = ClientState::GetEntityClientState(worldCID, true);
         if(state)
         {
-            Recalculate(state->GetCharacterState(), true);
+            // Only time restricted conditions need to be evaluated again
+            Recalculate(GetAllTokuseiEntities(state->GetCharacterState()),
+                true, {}, { TokuseiConditionType::GAME_TIME,
+                    TokuseiConditionType::MOON_PHASE });
         }
     }
 }
 
+uint64_t TokuseiManager::GetConditionEvaluationCount() const
+{
+    return mConditionEvaluationCount;
+}
+
+uint64_t TokuseiManager::GetConditionReuseCount() const
+{
+    return mConditionReuseCount;
+}
+
 void TokuseiManager::RemoveTrackingEntities(int32_t worldCID)
 {
     std::lock_guard<std::mutex> lock(mTimeLock);
@@ -2253,7 +2298,8 @@ void TokuseiManager::UpdateDiasporaMinibossCount(
 
     if(entities.size() > 0)
     {
-        Recalculate(entities, true);
+        Recalculate(entities, true, {},
+            { TokuseiConditionType::DIASPORA_MINIBOSS_COUNT });
     }
 }
 
@@ -2506,6 +2552,24 @@ bool TokuseiManager::BuildWorldClockTime(std::shared_ptr<
     }
 }
 
+bool TokuseiManager::ConditionsDependOn(int32_t tokuseiID,
+    const std::set<TokuseiConditionType>& changes) const
+{
+    auto it = mConditionDependencies.find(tokuseiID);
+    if(it != mConditionDependencies.end())
+    {
+        for(auto change : changes)
+        {
+            if(it->second.find((int8_t)change) != it->second.end())
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 bool TokuseiManager::Compare(int32_t value, std::shared_ptr<
     objects::TokuseiCondition> condition, bool numericCompare) const
 {
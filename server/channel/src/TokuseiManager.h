@@ -33,6 +33,9 @@
 #include <TokuseiCondition.h>
 #include <TokuseiSkillCondition.h>
 
+// Standard C++11 Includes
+#include <atomic>
+
 // channel Includes
 #include "ActiveEntityState.h"
 
@@ -83,7 +86,8 @@ public:
 
     /**
      * Recalculate the tokusei effects on the supplied entity and any related entities
-     * if any of the specified changes are triggers on the entity.
+     * if any of the specified changes are triggers on the entity. Only tokusei with
+     * conditions on the specified changes are evaluated again.
      * @param eState Pointer to the entity that has changed
      * @param changes Changes that could trigger a tokusei recalculation
      * @return Map of entity IDs to a true value if they have had their stats recalculated
@@ -110,11 +114,15 @@ public:
      * @param recalcStats false if the effect tokusei should be determined but the entities
      *  should not have their stats recalculated, true if both should occur
      * @param ignoreStateRecalc Set of entity IDs to ignore when recalculating stats
+     * @param changes Optional set of changes that caused the recalculation. If supplied,
+     *  only tokusei with conditions on these changes are evaluated again and the rest
+     *  reuse their last result. If empty, every condition is evaluated.
      * @return Map of entity IDs to a true value if they have had their stats recalculated
      *  or false if only their tokusei sets and triggers were updated
      */
     std::unordered_map<int32_t, bool> Recalculate(const std::list<std::shared_ptr<
-        ActiveEntityState>>& entities, bool recalcStats = false, std::set<int32_t> ignoreStatRecalc = {});
+        ActiveEntityState>>& entities, bool recalcStats = false, std::set<int32_t> ignoreStatRecalc = {},
+        std::set<TokuseiConditionType> changes = {});
 
     /**
      * Recalculate the tokusei effects for all entities in a party on the channel.
@@ -237,6 +245,20 @@ public:
      */
     void RecalcTimedTokusei(WorldClock& clock);
 
+    /**
+     * Get the number of times tokusei conditions have been evaluated
+     * during recalculation.
+     * @return Condition evaluation count
+     */
+    uint64_t GetConditionEvaluationCount() const;
+
+    /**
+     * Get the number of times a previous tokusei condition result was
+     * reused because none of its inputs changed.
+     * @return Condition result reuse count
+     */
+    uint64_t GetConditionReuseCount() const;
+
     /**
      * Unregister the world CID of a character that may have had time restricted
      * tokusei associated to one or more entity. Call this any time a player
@@ -318,6 +340,15 @@ private:
     bool BuildWorldClockTime(std::shared_ptr<objects::TokuseiCondition> condition,
         WorldClockTime& time);
 
+    /**
+     * Check if any conditions on a tokusei depend upon the supplied changes.
+     * @param tokuseiID ID of the tokusei to check
+     * @param changes Set of changes to check for
+     * @return true if the tokusei conditions need to be evaluated again
+     */
+    bool ConditionsDependOn(int32_t tokuseiID,
+        const std::set<TokuseiConditionType>& changes) const;
+
     /**
      * Compare the supplied value and condition value.
      * @param value LHS value to compare
@@ -363,6 +394,16 @@ private:
     /// Set of all tokusei with at least one movement decay aspect
     std::set<int32_t> mMoveDecayTokusei;
 
+    /// Map of tokusei IDs with conditions to the condition types they
+    /// depend upon
+    std::unordered_map<int32_t, std::set<int8_t>> mConditionDependencies;
+
+    /// Number of times tokusei conditions have been evaluated
+    std::atomic<uint64_t> mConditionEvaluationCount;
+
+    /// Number of times previous tokusei condition results were reused
+    std::atomic<uint64_t> mConditionReuseCount;
+
     /// Server lock for time calculation
     std::mutex mTimeLock;
 
@@ -61,6 +61,9 @@
 
 using namespace channel;
 
+// Oldest a position snapshot can be and still be used, two server ticks
+#define POSITION_SNAPSHOT_MAX_AGE 200000ULL
+
 namespace libcomp
 {
     template<>
@@ -130,9 +133,14 @@ namespace libcomp
 }
 
 Zone::Zone(uint32_t id, const std::shared_ptr<objects::ServerZone>& definition)
-    : mNextRentalExpiration(0), mNextEncounterID(1),
-    mDiasporaMiniBossUpdated(false)
+    : mNextRentalExpiration(0), mNextEncounterID(1), mAIDeferredCount(0),
+    mAIResumeEntityID(0), mDiasporaMiniBossUpdated(false)
 {
+    for(auto& count : mAIUpdateCounts)
+    {
+        count = 0;
+    }
+
     SetDefinition(definition);
     SetID(id);
 
@@ -688,6 +696,124 @@ const std::list<std::shared_ptr<ActiveEntityState>>
     return results;
 }
 
+const std::list<std::shared_ptr<ActiveEntityState>>
+    Zone::GetSnapshotEntitiesInRadius(float x, float y, double radius,
+        uint64_t now, bool useHitbox)
+{
+    auto snapshot = GetPositionSnapshot(now);
+    if(!snapshot)
+    {
+        return GetActiveEntitiesInRadius(x, y, radius, useHitbox);
+    }
+
+    std::list<std::shared_ptr<ActiveEntityState>> results;
+
+    float rSquared = (float)std::pow(radius, 2);
+
+    size_t count = snapshot->EntityIDs.size();
+    for(size_t i = 0; i < count; i++)
+    {
+        float xDiff = snapshot->X[i] - x;
+        float yDiff = snapshot->Y[i] - y;
+        float sqDist = xDiff * xDiff + yDiff * yDiff;
+
+        // Same hitbox overlap check as the exact position version
+        if(rSquared >= sqDist || (useHitbox &&
+            sqDist - snapshot->Hitbox[i] * snapshot->Hitbox[i] <= radius))
+        {
+            // Make sure the entity has not left since the snapshot
+            auto active = snapshot->Entities[i].lock();
+            if(active && active->GetZone().get() == this)
+            {
+                results.push_back(active);
+            }
+        }
+    }
+
+    return results;
+}
+
+void Zone::UpdatePositionSnapshot(uint64_t now)
+{
+    auto snapshot = std::make_shared<ZonePositionSnapshot>();
+    snapshot->Time = now;
+
+    auto entities = GetActiveEntities();
+
+    size_t count = entities.size();
+    snapshot->Entities.reserve(count);
+    snapshot->EntityIDs.reserve(count);
+    snapshot->X.reserve(count);
+    snapshot->Y.reserve(count);
+    snapshot->Rotation.reserve(count);
+    snapshot->Hitbox.reserve(count);
+    snapshot->Flags.reserve(count);
+    snapshot->Indexes.reserve(count);
+
+    for(auto active : entities)
+    {
+        // Refreshing here means anything else refreshing for the same
+        // tick does not have to interpolate again
+        active->RefreshCurrentPosition(now);
+
+        uint8_t flags = 0;
+        if(active->GetDestinationTicks() > now)
+        {
+            if(active->GetCurrentX() != active->GetDestinationX() ||
+                active->GetCurrentY() != active->GetDestinationY())
+            {
+                flags |= POSITION_SNAPSHOT_MOVING;
+            }
+
+            if(active->GetCurrentRotation() !=
+                active->GetDestinationRotation())
+            {
+                flags |= POSITION_SNAPSHOT_ROTATING;
+            }
+        }
+
+        snapshot->Indexes[active->GetEntityID()] = snapshot->EntityIDs.size();
+        snapshot->Entities.push_back(active);
+        snapshot->EntityIDs.push_back(active->GetEntityID());
+        snapshot->X.push_back(active->GetCurrentX());
+        snapshot->Y.push_back(active->GetCurrentY());
+        snapshot->Rotation.push_back(active->GetCurrentRotation());
+        snapshot->Hitbox.push_back((float)active->GetHitboxSize() * 10.f);
+        snapshot->Flags.push_back(flags);
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    mPositionSnapshot = snapshot;
+}
+
+std::shared_ptr<const ZonePositionSnapshot> Zone::GetPositionSnapshot(
+    uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if(mPositionSnapshot && (now < mPositionSnapshot->Time ||
+        (now - mPositionSnapshot->Time) <= POSITION_SNAPSHOT_MAX_AGE))
+    {
+        return mPositionSnapshot;
+    }
+
+    return nullptr;
+}
+
+bool ZonePositionSnapshot::GetPosition(int32_t entityID, float& x,
+    float& y) const
+{
+    auto it = Indexes.find(entityID);
+    if(it == Indexes.end())
+    {
+        return false;
+    }
+
+    x = X[it->second];
+    y = Y[it->second];
+
+    return true;
+}
+
 std::shared_ptr<AllyState> Zone::GetAlly(int32_t id)
 {
     return std::dynamic_pointer_cast<AllyState>(GetEntity(id));
@@ -1721,6 +1847,38 @@ uint32_t Zone::SetNextRentalExpiration()
     return mNextRentalExpiration;
 }
 
+uint32_t Zone::GetAIUpdateCount(AILODTier_t tier) const
+{
+    return tier < AI_LOD_TIER_COUNT ? mAIUpdateCounts[(size_t)tier].load()
+        : 0;
+}
+
+uint32_t Zone::GetAIDeferredCount() const
+{
+    return mAIDeferredCount;
+}
+
+void Zone::SetAIUpdateCounts(const std::array<uint32_t,
+    AI_LOD_TIER_COUNT>& updated, uint32_t deferred)
+{
+    for(size_t i = 0; i < (size_t)AI_LOD_TIER_COUNT; i++)
+    {
+        mAIUpdateCounts[i] = updated[i];
+    }
+
+    mAIDeferredCount = deferred;
+}
+
+int32_t Zone::GetAIResumeEntityID() const
+{
+    return mAIResumeEntityID;
+}
+
+void Zone::SetAIResumeEntityID(int32_t entityID)
+{
+    mAIResumeEntityID = entityID;
+}
+
 bool Zone::Collides(const Line& path, Point& point,
     Line& surface, std::shared_ptr<ZoneShape>& shape) const
 {
@@ -29,6 +29,7 @@
 
 // channel Includes
 #include "ActiveEntityState.h"
+#include "AIState.h"
 #include "AllyState.h"
 #include "BazaarState.h"
 #include "ChannelClientConnection.h"
@@ -41,7 +42,11 @@
 #include <ZoneObject.h>
 
 // Standard C++11 includes
+#include <array>
+#include <atomic>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace objects
 {
@@ -75,6 +80,59 @@ typedef EntityState<objects::ServerObject> ServerObjectState;
 
 typedef objects::ServerZoneInstanceVariant::InstanceType_t InstanceType_t;
 
+/// Position snapshot flag set when the entity is moving
+const uint8_t POSITION_SNAPSHOT_MOVING = 0x01;
+
+/// Position snapshot flag set when the entity is rotating
+const uint8_t POSITION_SNAPSHOT_ROTATING = 0x02;
+
+/**
+ * Immutable snapshot of every active entity's position in a zone taken
+ * once per server tick. Values are stored in parallel arrays so range
+ * checks only touch the data they need. Positions are only as precise as
+ * the tick they were taken on so anything needing sub-tick precision must
+ * refresh the entity's current position instead.
+ */
+struct ZonePositionSnapshot
+{
+    /// Server time the snapshot was taken at
+    uint64_t Time = 0;
+
+    /// Active entities in the order they were recorded. These are weak so
+    /// an entity removed from the zone is not kept alive by the snapshot.
+    std::vector<std::weak_ptr<ActiveEntityState>> Entities;
+
+    /// Entity IDs of the recorded entities
+    std::vector<int32_t> EntityIDs;
+
+    /// X coordinates of the recorded entities
+    std::vector<float> X;
+
+    /// Y coordinates of the recorded entities
+    std::vector<float> Y;
+
+    /// Rotations of the recorded entities
+    std::vector<float> Rotation;
+
+    /// Hitbox sizes of the recorded entities in world units
+    std::vector<float> Hitbox;
+
+    /// POSITION_SNAPSHOT flags of the recorded entities
+    std::vector<uint8_t> Flags;
+
+    /// Indexes into the arrays by entity ID
+    std::unordered_map<int32_t, size_t> Indexes;
+
+    /**
+     * Get the recorded position of an entity
+     * @param entityID ID of the entity
+     * @param x Output parameter to set the X coordinate on
+     * @param y Output parameter to set the Y coordinate on
+     * @return true if the entity was recorded in the snapshot
+     */
+    bool GetPosition(int32_t entityID, float& x, float& y) const;
+};
+
 /**
  * Represents a server zone containing client connections, objects,
  * enemies, etc.
@@ -295,6 +353,39 @@ public:
         GetActiveEntitiesInRadius(float x, float y, double radius,
             bool useHitbox = false);
 
+    /**
+     * Get all active entities in the zone within a supplied radius using
+     * the positions recorded in the current position snapshot. If there is
+     * no current snapshot the exact positions are used instead.
+     * @param x X coordinate of the center of the radius
+     * @param y Y coordinate of the center of the radius
+     * @param radius Radius to check for entities
+     * @param now Current server time
+     * @param useHitbox If true, the entities' hitboxes will be used to
+     *  determine if they are in the radius, even if the center point is not
+     * @return List of pointers to active entities in the radius
+     */
+    const std::list<std::shared_ptr<ActiveEntityState>>
+        GetSnapshotEntitiesInRadius(float x, float y, double radius,
+            uint64_t now, bool useHitbox = false);
+
+    /**
+     * Refresh the current position of every active entity in the zone and
+     * record them in a new position snapshot. This should be called once
+     * per server tick.
+     * @param now Current server time
+     */
+    void UpdatePositionSnapshot(uint64_t now);
+
+    /**
+     * Get the position snapshot taken on the current server tick
+     * @param now Current server time
+     * @return Pointer to the snapshot or null if the zone has not recorded
+     *  one recently enough to be used
+     */
+    std::shared_ptr<const ZonePositionSnapshot> GetPositionSnapshot(
+        uint64_t now);
+
     /**
      * Get an entity instance by it's ID.
      * @param id Instance ID of the entity.
@@ -739,6 +830,45 @@ public:
      */
     uint32_t SetNextRentalExpiration();
 
+    /**
+     * Get the number of AI controlled entities updated during the last
+     * zone tick at the specified level of detail tier
+     * @param tier AI level of detail tier
+     * @return Number of entities updated at the tier
+     */
+    uint32_t GetAIUpdateCount(AILODTier_t tier) const;
+
+    /**
+     * Get the number of AI controlled entities whose update was deferred
+     * to a later tick during the last zone tick
+     * @return Number of entities not updated
+     */
+    uint32_t GetAIDeferredCount() const;
+
+    /**
+     * Set the number of AI controlled entities updated and deferred during
+     * the current zone tick
+     * @param updated Number of entities updated per level of detail tier
+     * @param deferred Number of entities not updated
+     */
+    void SetAIUpdateCounts(const std::array<uint32_t,
+        AI_LOD_TIER_COUNT>& updated, uint32_t deferred);
+
+    /**
+     * Get the entity ID of the last AI controlled entity updated before
+     * the AI time budget ran out during a zone tick
+     * @return Entity ID to resume AI updates after or 0 if the last tick
+     *  did not run out of time
+     */
+    int32_t GetAIResumeEntityID() const;
+
+    /**
+     * Set the entity ID of the last AI controlled entity updated before
+     * the AI time budget ran out during a zone tick
+     * @param entityID Entity ID to resume AI updates after
+     */
+    void SetAIResumeEntityID(int32_t entityID);
+
     /**
      * Determines if the supplied path collides with anything in the zone's
      * geometry
@@ -842,6 +972,10 @@ private:
     /// List of active entities in the zone
     std::list<std::shared_ptr<ActiveEntityState>> mActiveEntities;
 
+    /// Position snapshot of the active entities taken on the last tick the
+    /// zone was updated
+    std::shared_ptr<const ZonePositionSnapshot> mPositionSnapshot;
+
     /// List of pointers to allies instantiated for the zone
     std::list<std::shared_ptr<AllyState>> mAllies;
 
@@ -953,6 +1087,17 @@ private:
     /// Next ID to use for encounters registered for the zone
     uint32_t mNextEncounterID;
 
+    /// Number of AI controlled entities updated during the last tick per
+    /// AI level of detail tier
+    std::array<std::atomic<uint32_t>, AI_LOD_TIER_COUNT> mAIUpdateCounts;
+
+    /// Number of AI controlled entities deferred during the last tick
+    std::atomic<uint32_t> mAIDeferredCount;
+
+    /// Entity ID of the last AI controlled entity updated before the AI
+    /// time budget ran out
+    int32_t mAIResumeEntityID;
+
     /// Quick reference flag to determine if the zone has respwa
     bool mHasRespawns;
 
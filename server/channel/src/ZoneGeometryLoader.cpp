@@ -97,8 +97,18 @@ bool ZoneGeometryLoader::LoadZoneQMP(
     auto zoneData = definitionManager->GetZoneData(zoneID);
 
     libcomp::String filename = zoneData->GetFile()->GetQmpFile();
-    if(filename.IsEmpty() || mZoneGeometry.find(filename.C()) !=
-        mZoneGeometry.end())
+    if(filename.IsEmpty())
+    {
+        return true;
+    }
+
+    // Zones can share a QMP file so claim it before loading to keep
+    // another thread from loading it at the same time
+    mDataLock.lock();
+    bool claimed = mClaimedFiles.insert(filename.C()).second;
+    mDataLock.unlock();
+
+    if(!claimed)
     {
         return true;
     }
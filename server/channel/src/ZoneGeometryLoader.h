@@ -66,6 +66,9 @@ private:
     /// List of zone pairs for the QMP loading process.
     std::list<std::pair<uint32_t, std::set<uint32_t>>> mZonePairs;
 
+    /// Set of QMP filenames already being loaded by a thread
+    std::set<std::string> mClaimedFiles;
+
     /// Map of QMP filenames to the geometry structures built from them
     std::unordered_map<std::string,
         std::shared_ptr<ZoneGeometry>> mZoneGeometry;
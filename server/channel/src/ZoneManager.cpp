@@ -44,6 +44,7 @@
 #include <ActionStartEvent.h>
 #include <ActivatedAbility.h>
 #include <Ally.h>
+#include <ChannelConfig.h>
 #include <ChannelLogin.h>
 #include <CharacterLogin.h>
 #include <CharacterProgress.h>
@@ -160,7 +161,7 @@ namespace libcomp
 
 ZoneManager::ZoneManager(const std::weak_ptr<ChannelServer>& server)
     : mTrackingRefresh(0), mNextZoneID(1), mNextZoneInstanceID(1),
-    mServer(server)
+    mAIZoneOffset(0), mServer(server)
 {
 }
 
@@ -1034,6 +1035,12 @@ void ZoneManager::LeaveZone(const std::shared_ptr<ChannelClientConnection>& clie
     // Lock entity interactions in the zone
     state->SetZoneInTime(0);
 
+    // Drop any part of the zone entry snapshot not sent yet
+    {
+        std::lock_guard<std::mutex> lock(mPendingZoneInLock);
+        mPendingZoneIn.erase(worldCID);
+    }
+
     // Detach from zone specific state info
     auto exchangeSession = state->GetExchangeSession();
     if(exchangeSession)
@@ -1578,6 +1585,29 @@ std::shared_ptr<ZoneInstance> ZoneManager::GetInstance(uint32_t instanceID)
     return it != mZoneInstances.end() ? it->second : nullptr;
 }
 
+size_t ZoneManager::GetInstanceCount()
+{
+    std::lock_guard<libcomp::Mutex> lock(mLock);
+    return mZoneInstances.size();
+}
+
+std::list<std::shared_ptr<Zone>> ZoneManager::GetActiveZones()
+{
+    std::list<std::shared_ptr<Zone>> zones;
+
+    std::lock_guard<libcomp::Mutex> lock(mLock);
+    for(auto uniqueID : mActiveZones)
+    {
+        auto it = mZones.find(uniqueID);
+        if(it != mZones.end())
+        {
+            zones.push_back(it->second);
+        }
+    }
+
+    return zones;
+}
+
 std::shared_ptr<objects::InstanceAccess> ZoneManager::GetInstanceAccess(
     int32_t worldCID)
 {
@@ -1875,7 +1905,6 @@ bool ZoneManager::SendPopulateZoneData(const std::shared_ptr<
     state->SetLockMovement(false);
     state->SetZoneInTime(ChannelServer::GetServerTime());
 
-    auto zoneDef = zone->GetDefinition();
     auto characterManager = server->GetCharacterManager();
     auto definitionManager = server->GetDefinitionManager();
 
@@ -1933,164 +1962,495 @@ bool ZoneManager::SendPopulateZoneData(const std::shared_ptr<
     TriggerZoneActions(zone, { cState, dState }, ZoneTrigger_t::ON_ZONE_IN,
         client);
 
-    // All zone information is queued and sent together to minimize excess
-    // communication
-    for(auto enemyState : zone->GetEnemies())
+    // Build the zone entry snapshot. Entities within draw distance are
+    // queued and sent together to minimize excess communication and the
+    // rest are streamed to the client over the next ticks.
+    auto conf = std::dynamic_pointer_cast<objects::ChannelConfig>(
+        server->GetConfig());
+
+    float drawDistance = conf->GetZoneInDrawDistance();
+    float drawDistanceSq = drawDistance * drawDistance;
+
+    ZoneInStream deferred;
+    deferred.ZoneID = zone->GetID();
+
+    for(auto& entry : GetZoneInEntries(zone, cState))
     {
-        SendEnemyData(enemyState, client, zone, true);
+        // Combat entities are referenced by AI, skill and status packets
+        // sent to the whole zone so they must always be shown first
+        if(entry.Priority > 0 && drawDistance > 0.f &&
+            entry.DistanceSq > drawDistanceSq)
+        {
+            deferred.Entries.push_back(entry);
+        }
+        else
+        {
+            SendZoneInEntry(client, zone, entry);
+        }
     }
 
-    for(auto npcState : zone->GetNPCs())
+    // Stream the far entities nearest first regardless of priority
+    deferred.Entries.sort([](const ZoneInEntry& a, const ZoneInEntry& b)
+        {
+            return a.DistanceSq < b.DistanceSq;
+        });
+
     {
-        if(npcState->GetEntity()->GetState() == HNPC_STATE_SHOW)
+        std::lock_guard<std::mutex> lock(mPendingZoneInLock);
+        if(deferred.Entries.size() > 0)
+        {
+            mPendingZoneIn[state->GetWorldCID()] = deferred;
+        }
+        else
         {
-            ShowNPC(zone, { client }, npcState, true);
+            mPendingZoneIn.erase(state->GetWorldCID());
         }
     }
 
-    for(auto objState : zone->GetServerObjects())
+    // Send all the queued entity packets
+    client->FlushOutgoing();
+
+    std::list<std::shared_ptr<ChannelClientConnection>> self = { client };
+    for(auto oConnection : otherClients)
     {
-        if(objState->GetEntity()->GetState() != ONPC_STATE_HIDE)
+        auto oState = oConnection->GetClientState();
+        auto oCState = oState->GetCharacterState();
+        auto oDState = oState->GetDemonState();
+
+        if(oCState->IsClientVisible())
+        {
+            characterManager->SendOtherCharacterData(self, oState);
+
+            PopEntityForProduction(client, oCState->GetEntityID(), 0);
+            ShowEntity(client, oCState->GetEntityID());
+        }
+
+        if(oDState->IsClientVisible())
         {
-            ShowObject(zone, { client }, objState, true);
+            characterManager->SendOtherPartnerData(self, oState);
+            PopEntityForProduction(client, oDState->GetEntityID(), 0);
+            ShowEntity(client, oDState->GetEntityID());
+
+            if(oDState->GetDeathTimeOut())
+            {
+                UpdateDeathTimeOut(oState, 0, client);
+            }
         }
     }
 
-    for(auto plasmaPair : zone->GetPlasma())
+    return true;
+}
+
+void ZoneManager::StreamPendingZoneInData()
+{
+    auto server = mServer.lock();
+    auto conf = std::dynamic_pointer_cast<objects::ChannelConfig>(
+        server->GetConfig());
+
+    uint32_t budget = conf->GetZoneInByteBudget();
+
+    // Pull the next batch for each client while locked but send them after
+    std::list<std::pair<int32_t, ZoneInStream>> batches;
     {
-        auto pState = plasmaPair.second;
-        auto pSpawn = pState->GetEntity();
+        std::lock_guard<std::mutex> lock(mPendingZoneInLock);
+        for(auto it = mPendingZoneIn.begin(); it != mPendingZoneIn.end();)
+        {
+            auto& entries = it->second.Entries;
 
-        libcomp::Packet p;
-        p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_PLASMA_DATA);
-        p.WriteS32Little(pState->GetEntityID());
-        p.WriteS32Little((int32_t)zone->GetID());
-        p.WriteS32Little((int32_t)zoneDef->GetID());
-        p.WriteFloat(pState->GetCurrentX());
-        p.WriteFloat(pState->GetCurrentY());
-        p.WriteFloat(pState->GetCurrentRotation());
-        p.WriteS8((int8_t)pSpawn->GetColor());
-        p.WriteS8((int8_t)pSpawn->GetPickTime());
-        p.WriteS8((int8_t)pSpawn->GetPickSpeed());
-        p.WriteU16Little(pSpawn->GetPickSize());
+            ZoneInStream batch;
+            batch.ZoneID = it->second.ZoneID;
 
-        auto activePoints = pState->GetActivePoints();
+            // Always send at least one entry so large entities still go out
+            uint32_t total = 0;
+            while(entries.size() > 0 && (!budget || total == 0 ||
+                (total + entries.front().Size) <= budget))
+            {
+                total = (uint32_t)(total + entries.front().Size);
+                batch.Entries.push_back(entries.front());
+                entries.pop_front();
+            }
+
+            batches.push_back(std::make_pair(it->first, batch));
+
+            if(entries.size() == 0)
+            {
+                it = mPendingZoneIn.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
 
-        uint8_t pointCount = (uint8_t)activePoints.size();
-        p.WriteS8((int8_t)pointCount);
-        for(auto point : activePoints)
+    auto connectionManager = server->GetManagerConnection();
+    for(auto& pair : batches)
+    {
+        auto client = connectionManager->GetEntityClient(pair.first, true);
+        auto zone = client ? GetCurrentZone(client) : nullptr;
+        if(!zone || zone->GetID() != pair.second.ZoneID)
         {
-            p.WriteS8((int8_t)point->GetID());
-            p.WriteS32Little(point->GetState(state->GetWorldCID()));
+            // Left the zone, the rest of the snapshot is no longer needed
+            std::lock_guard<std::mutex> lock(mPendingZoneInLock);
+            auto it = mPendingZoneIn.find(pair.first);
+            if(it != mPendingZoneIn.end() &&
+                it->second.ZoneID == pair.second.ZoneID)
+            {
+                mPendingZoneIn.erase(it);
+            }
 
-            p.WriteFloat(point->GetX());
-            p.WriteFloat(point->GetY());
-            p.WriteFloat(point->GetRotation());
+            continue;
         }
 
-        client->QueuePacket(p);
-        ShowEntity(client, pState->GetEntityID(), true);
+        for(auto& entry : pair.second.Entries)
+        {
+            SendZoneInEntry(client, zone, entry);
+        }
+
+        client->FlushOutgoing();
     }
+}
 
-    for(auto bState : zone->GetBazaars())
+void ZoneManager::SendPendingZoneInData(const std::list<std::shared_ptr<
+    ChannelClientConnection>>& clients)
+{
+    // Pull the rest of the snapshot for every client still waiting on one
+    std::list<std::pair<std::shared_ptr<ChannelClientConnection>,
+        ZoneInStream>> streams;
     {
-        auto bazaar = bState->GetEntity();
+        std::lock_guard<std::mutex> lock(mPendingZoneInLock);
+        if(mPendingZoneIn.size() == 0)
+        {
+            return;
+        }
 
-        libcomp::Packet p;
-        p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_BAZAAR_DATA);
-        p.WriteS32Little(bState->GetEntityID());
-        p.WriteS32Little((int32_t)zone->GetID());
-        p.WriteS32Little((int32_t)zoneDef->GetID());
-        p.WriteFloat(bState->GetCurrentX());
-        p.WriteFloat(bState->GetCurrentY());
-        p.WriteFloat(bState->GetCurrentRotation());
-        p.WriteS32Little((int32_t)bazaar->MarketIDsCount());
+        for(auto& client : clients)
+        {
+            auto it = mPendingZoneIn.find(client->GetClientState()
+                ->GetWorldCID());
+            if(it != mPendingZoneIn.end())
+            {
+                streams.push_back(std::make_pair(client,
+                    std::move(it->second)));
+                mPendingZoneIn.erase(it);
+            }
+        }
+    }
 
-        for(uint32_t marketID : bazaar->GetMarketIDs())
+    for(auto& pair : streams)
+    {
+        auto client = pair.first;
+        auto zone = GetCurrentZone(client);
+        if(zone && zone->GetID() == pair.second.ZoneID)
         {
-            auto market = bState->GetCurrentMarket(marketID);
-            if(market && market->GetState() ==
-                objects::BazaarData::State_t::BAZAAR_INACTIVE)
+            for(auto& entry : pair.second.Entries)
             {
-                market = nullptr;
+                SendZoneInEntry(client, zone, entry);
             }
 
-            p.WriteU32Little(marketID);
-            p.WriteS32Little(market ? (int32_t)market->GetState() : 0);
-            p.WriteS32Little(market ? market->GetNPCType() : -1);
-            p.WriteString16Little(state->GetClientStringEncoding(),
-                market ? market->GetComment() : "", true);
+            client->FlushOutgoing();
         }
+    }
+}
 
-        client->QueuePacket(p);
-        ShowEntity(client, bState->GetEntityID(), true);
+void ZoneManager::DropPendingZoneInEntity(const std::list<std::shared_ptr<
+    ChannelClientConnection>>& clients, int32_t entityID)
+{
+    std::lock_guard<std::mutex> lock(mPendingZoneInLock);
+    if(mPendingZoneIn.size() == 0)
+    {
+        return;
     }
 
-    for(auto& cmPair : zone->GetCultureMachines())
+    for(auto& client : clients)
     {
-        auto cmState = cmPair.second;
-        auto rental = cmState->GetRentalData();
-        bool active = rental && rental->GetActive();
+        auto it = mPendingZoneIn.find(client->GetClientState()
+            ->GetWorldCID());
+        if(it != mPendingZoneIn.end())
+        {
+            it->second.Entries.remove_if([entityID](const ZoneInEntry& e)
+                {
+                    return e.EntityID == entityID;
+                });
+        }
+    }
+}
 
-        libcomp::Packet p;
-        p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_CULTURE_MACHINE_DATA);
-        p.WriteS32Little(cmState->GetEntityID());
-        p.WriteU32Little(cmPair.first);
-        p.WriteU8(active ? 1 : 0);
-        p.WriteS32Little((int32_t)zone->GetID());
-        p.WriteS32Little((int32_t)zoneDef->GetID());
-        p.WriteFloat(cmState->GetCurrentX());
-        p.WriteFloat(cmState->GetCurrentY());
-        p.WriteFloat(cmState->GetCurrentRotation());
-        p.WriteU8(active &&
-            rental->GetCharacter() == cState->GetEntityUUID() ? 1 : 0);
+std::list<ZoneInEntry> ZoneManager::GetZoneInEntries(
+    const std::shared_ptr<Zone>& zone,
+    const std::shared_ptr<CharacterState>& cState)
+{
+    std::list<ZoneInEntry> entries;
 
-        client->QueuePacket(p);
-        ShowEntity(client, cmState->GetEntityID(), true);
-    }
+    float x = cState->GetCurrentX();
+    float y = cState->GetCurrentY();
 
-    for(auto lState : zone->GetLootBoxes())
+    auto addEntry = [&entries, x, y](const std::shared_ptr<
+        objects::EntityStateObject>& eState, uint32_t key, uint8_t priority,
+        uint32_t size)
+        {
+            float dx = eState->GetCurrentX() - x;
+            float dy = eState->GetCurrentY() - y;
+
+            ZoneInEntry entry;
+            entry.EntityID = eState->GetEntityID();
+            entry.Type = eState->GetEntityType();
+            entry.Key = key;
+            entry.Priority = priority;
+            entry.DistanceSq = dx * dx + dy * dy;
+            entry.Size = size;
+
+            entries.push_back(entry);
+        };
+
+    // Sizes below include the 6 byte command header of each packet plus the
+    // pop and show packets sent with the data.
+
+    // Enemies, allies and loot boxes can act on or be acted on by the
+    // player right away so they go first and are never streamed
+    for(auto enemyState : zone->GetEnemies())
     {
-        SendLootBoxData(client, lState, nullptr, false, true);
+        addEntry(enemyState, 0, 0, (uint32_t)(75 + 9 *
+            enemyState->GetStatusEffectCount()));
     }
 
     for(auto allyState : zone->GetAllies())
     {
-        SendAllyData(allyState, client, zone, true);
+        addEntry(allyState, 0, 0, (uint32_t)(75 + 9 *
+            allyState->GetStatusEffectCount()));
     }
 
-    // Send all the queued NPC packets
-    client->FlushOutgoing();
-
-    std::list<std::shared_ptr<ChannelClientConnection>> self = { client };
-    for(auto oConnection : otherClients)
+    for(auto lState : zone->GetLootBoxes())
     {
-        auto oState = oConnection->GetClientState();
-        auto oCState = oState->GetCharacterState();
-        auto oDState = oState->GetDemonState();
+        // Loot item data is variable so assume a few items
+        addEntry(lState, 0, 0, 128);
+    }
 
-        if(oCState->IsClientVisible())
+    for(auto npcState : zone->GetNPCs())
+    {
+        if(npcState->GetEntity()->GetState() == HNPC_STATE_SHOW)
         {
-            characterManager->SendOtherCharacterData(self, oState);
+            addEntry(npcState, 0, 1, 46);
+        }
+    }
 
-            PopEntityForProduction(client, oCState->GetEntityID(), 0);
-            ShowEntity(client, oCState->GetEntityID());
+    for(auto objState : zone->GetServerObjects())
+    {
+        if(objState->GetEntity()->GetState() != ONPC_STATE_HIDE)
+        {
+            addEntry(objState, 0, 1, 45);
         }
+    }
 
-        if(oDState->IsClientVisible())
+    for(auto& plasmaPair : zone->GetPlasma())
+    {
+        addEntry(plasmaPair.second, plasmaPair.first, 2, (uint32_t)(46 +
+            17 * plasmaPair.second->GetActivePoints().size()));
+    }
+
+    for(auto bState : zone->GetBazaars())
+    {
+        addEntry(bState, 0, 2, (uint32_t)(44 + 32 *
+            bState->GetEntity()->MarketIDsCount()));
+    }
+
+    for(auto& cmPair : zone->GetCultureMachines())
+    {
+        addEntry(cmPair.second, cmPair.first, 2, 46);
+    }
+
+    entries.sort([](const ZoneInEntry& a, const ZoneInEntry& b)
         {
-            characterManager->SendOtherPartnerData(self, oState);
-            PopEntityForProduction(client, oDState->GetEntityID(), 0);
-            ShowEntity(client, oDState->GetEntityID());
+            return a.Priority != b.Priority ? a.Priority < b.Priority
+                : a.DistanceSq < b.DistanceSq;
+        });
 
-            if(oDState->GetDeathTimeOut())
+    return entries;
+}
+
+void ZoneManager::SendZoneInEntry(const std::shared_ptr<
+    ChannelClientConnection>& client, const std::shared_ptr<Zone>& zone,
+    const ZoneInEntry& entry)
+{
+    switch(entry.Type)
+    {
+    case EntityType_t::ENEMY:
+        {
+            auto enemyState = zone->GetEnemy(entry.EntityID);
+            if(enemyState)
             {
-                UpdateDeathTimeOut(oState, 0, client);
+                SendEnemyData(enemyState, client, zone, true);
+            }
+        }
+        break;
+    case EntityType_t::ALLY:
+        {
+            auto allyState = zone->GetAlly(entry.EntityID);
+            if(allyState)
+            {
+                SendAllyData(allyState, client, zone, true);
+            }
+        }
+        break;
+    case EntityType_t::NPC:
+        {
+            auto npcState = zone->GetNPC(entry.EntityID);
+            if(npcState &&
+                npcState->GetEntity()->GetState() == HNPC_STATE_SHOW)
+            {
+                ShowNPC(zone, { client }, npcState, true);
+            }
+        }
+        break;
+    case EntityType_t::OBJECT:
+        {
+            auto objState = zone->GetServerObject(entry.EntityID);
+            if(objState &&
+                objState->GetEntity()->GetState() != ONPC_STATE_HIDE)
+            {
+                ShowObject(zone, { client }, objState, true);
             }
         }
+        break;
+    case EntityType_t::LOOT_BOX:
+        {
+            auto lState = zone->GetLootBox(entry.EntityID);
+            if(lState)
+            {
+                SendLootBoxData(client, lState, nullptr, false, true);
+            }
+        }
+        break;
+    case EntityType_t::PLASMA:
+        {
+            auto pState = zone->GetPlasma(entry.Key);
+            if(pState)
+            {
+                SendPlasmaData(client, zone, pState);
+            }
+        }
+        break;
+    case EntityType_t::BAZAAR:
+        {
+            auto bState = zone->GetBazaar(entry.EntityID);
+            if(bState)
+            {
+                SendBazaarData(client, zone, bState);
+            }
+        }
+        break;
+    case EntityType_t::CULTURE_MACHINE:
+        {
+            auto cmState = zone->GetCultureMachine(entry.EntityID);
+            if(cmState)
+            {
+                SendCultureMachineData(client, zone, entry.Key, cmState);
+            }
+        }
+        break;
+    default:
+        break;
     }
+}
 
-    return true;
+void ZoneManager::SendPlasmaData(const std::shared_ptr<
+    ChannelClientConnection>& client, const std::shared_ptr<Zone>& zone,
+    const std::shared_ptr<PlasmaState>& pState)
+{
+    auto state = client->GetClientState();
+    auto pSpawn = pState->GetEntity();
+
+    libcomp::Packet p;
+    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_PLASMA_DATA);
+    p.WriteS32Little(pState->GetEntityID());
+    p.WriteS32Little((int32_t)zone->GetID());
+    p.WriteS32Little((int32_t)zone->GetDefinitionID());
+    p.WriteFloat(pState->GetCurrentX());
+    p.WriteFloat(pState->GetCurrentY());
+    p.WriteFloat(pState->GetCurrentRotation());
+    p.WriteS8((int8_t)pSpawn->GetColor());
+    p.WriteS8((int8_t)pSpawn->GetPickTime());
+    p.WriteS8((int8_t)pSpawn->GetPickSpeed());
+    p.WriteU16Little(pSpawn->GetPickSize());
+
+    auto activePoints = pState->GetActivePoints();
+
+    uint8_t pointCount = (uint8_t)activePoints.size();
+    p.WriteS8((int8_t)pointCount);
+    for(auto point : activePoints)
+    {
+        p.WriteS8((int8_t)point->GetID());
+        p.WriteS32Little(point->GetState(state->GetWorldCID()));
+
+        p.WriteFloat(point->GetX());
+        p.WriteFloat(point->GetY());
+        p.WriteFloat(point->GetRotation());
+    }
+
+    client->QueuePacket(p);
+    ShowEntity(client, pState->GetEntityID(), true);
+}
+
+void ZoneManager::SendBazaarData(const std::shared_ptr<
+    ChannelClientConnection>& client, const std::shared_ptr<Zone>& zone,
+    const std::shared_ptr<BazaarState>& bState)
+{
+    auto state = client->GetClientState();
+    auto bazaar = bState->GetEntity();
+
+    libcomp::Packet p;
+    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_BAZAAR_DATA);
+    p.WriteS32Little(bState->GetEntityID());
+    p.WriteS32Little((int32_t)zone->GetID());
+    p.WriteS32Little((int32_t)zone->GetDefinitionID());
+    p.WriteFloat(bState->GetCurrentX());
+    p.WriteFloat(bState->GetCurrentY());
+    p.WriteFloat(bState->GetCurrentRotation());
+    p.WriteS32Little((int32_t)bazaar->MarketIDsCount());
+
+    for(uint32_t marketID : bazaar->GetMarketIDs())
+    {
+        auto market = bState->GetCurrentMarket(marketID);
+        if(market && market->GetState() ==
+            objects::BazaarData::State_t::BAZAAR_INACTIVE)
+        {
+            market = nullptr;
+        }
+
+        p.WriteU32Little(marketID);
+        p.WriteS32Little(market ? (int32_t)market->GetState() : 0);
+        p.WriteS32Little(market ? market->GetNPCType() : -1);
+        p.WriteString16Little(state->GetClientStringEncoding(),
+            market ? market->GetComment() : "", true);
+    }
+
+    client->QueuePacket(p);
+    ShowEntity(client, bState->GetEntityID(), true);
+}
+
+void ZoneManager::SendCultureMachineData(const std::shared_ptr<
+    ChannelClientConnection>& client, const std::shared_ptr<Zone>& zone,
+    uint32_t machineID, const std::shared_ptr<CultureMachineState>& cmState)
+{
+    auto cState = client->GetClientState()->GetCharacterState();
+    auto rental = cmState->GetRentalData();
+    bool active = rental && rental->GetActive();
+
+    libcomp::Packet p;
+    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_CULTURE_MACHINE_DATA);
+    p.WriteS32Little(cmState->GetEntityID());
+    p.WriteU32Little(machineID);
+    p.WriteU8(active ? 1 : 0);
+    p.WriteS32Little((int32_t)zone->GetID());
+    p.WriteS32Little((int32_t)zone->GetDefinitionID());
+    p.WriteFloat(cmState->GetCurrentX());
+    p.WriteFloat(cmState->GetCurrentY());
+    p.WriteFloat(cmState->GetCurrentRotation());
+    p.WriteU8(active &&
+        rental->GetCharacter() == cState->GetEntityUUID() ? 1 : 0);
+
+    client->QueuePacket(p);
+    ShowEntity(client, cmState->GetEntityID(), true);
 }
 
 void ZoneManager::ShowEntity(const std::shared_ptr<
@@ -2189,6 +2549,8 @@ void ZoneManager::RemoveEntities(const std::list <std::shared_ptr<
 {
     for(int32_t entityID : entityIDs)
     {
+        DropPendingZoneInEntity(clients, entityID);
+
         libcomp::Packet p;
         p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_REMOVE_ENTITY);
         p.WriteS32Little(entityID);
@@ -2213,24 +2575,43 @@ void ZoneManager::ShowNPC(const std::shared_ptr<Zone>& zone,
     const std::list<std::shared_ptr<ChannelClientConnection>>& clients,
     const std::shared_ptr<NPCState>& npcState, bool queue)
 {
+    // Clients still waiting on the NPC from zone entry are shown it here
+    DropPendingZoneInEntity(clients, npcState->GetEntityID());
+
     auto npc = npcState->GetEntity();
 
+    // Reuse the last packet built if nothing in it has changed
+    auto cache = npcState->GetShowPacketCache();
+    EntityPacketCache::Key_t key = {
+        (int64_t)zone->GetID(),
+        (int64_t)npc->GetID(),
+        (int64_t)npc->GetDisplayFlag(),
+        EntityPacketCache::FloatKey(npcState->GetCurrentX()),
+        EntityPacketCache::FloatKey(npcState->GetCurrentY()),
+        EntityPacketCache::FloatKey(npcState->GetCurrentRotation())
+    };
+
     libcomp::Packet p;
-    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_NPC_DATA);
-    p.WriteS32Little(npcState->GetEntityID());
-    p.WriteU32Little(npc->GetID());
-    p.WriteS32Little((int32_t)zone->GetID());
-    p.WriteS32Little((int32_t)zone->GetDefinitionID());
-    p.WriteFloat(npcState->GetCurrentX());
-    p.WriteFloat(npcState->GetCurrentY());
-    p.WriteFloat(npcState->GetCurrentRotation());
+    if(!cache->Load(key, p))
+    {
+        p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_NPC_DATA);
+        p.WriteS32Little(npcState->GetEntityID());
+        p.WriteU32Little(npc->GetID());
+        p.WriteS32Little((int32_t)zone->GetID());
+        p.WriteS32Little((int32_t)zone->GetDefinitionID());
+        p.WriteFloat(npcState->GetCurrentX());
+        p.WriteFloat(npcState->GetCurrentY());
+        p.WriteFloat(npcState->GetCurrentRotation());
 
-    // Client side display value, mostly replaced with event conditions
-    // but still useful for "modal" NPCs that change with game state.
-    // See NPCInvisibleData for the matching IDs and criteria.
-    p.WriteS16Little(npc->GetDisplayFlag());
+        // Client side display value, mostly replaced with event conditions
+        // but still useful for "modal" NPCs that change with game state.
+        // See NPCInvisibleData for the matching IDs and criteria.
+        p.WriteS16Little(npc->GetDisplayFlag());
+
+        cache->Store(key, p);
+    }
 
-    ChannelClientConnection::BroadcastPacket(clients, p, true);
+    ChannelClientConnection::QueuePacketToAll(clients, p);
 
     ShowEntity(clients, npcState->GetEntityID(), true);
 
@@ -2244,20 +2625,40 @@ void ZoneManager::ShowObject(const std::shared_ptr<Zone>& zone,
     const std::list<std::shared_ptr<ChannelClientConnection>>& clients,
     const std::shared_ptr<ServerObjectState>& objState, bool queue)
 {
+    // Clients still waiting on the object from zone entry are shown it here
+    DropPendingZoneInEntity(clients, objState->GetEntityID());
+
     auto obj = objState->GetEntity();
 
+    // Reuse the last packet built if nothing in it has changed
+    auto cache = objState->GetShowPacketCache();
+    EntityPacketCache::Key_t key = {
+        (int64_t)zone->GetID(),
+        (int64_t)obj->GetID(),
+        (int64_t)obj->GetState(),
+        EntityPacketCache::FloatKey(objState->GetCurrentX()),
+        EntityPacketCache::FloatKey(objState->GetCurrentY()),
+        EntityPacketCache::FloatKey(objState->GetCurrentRotation())
+    };
+
     libcomp::Packet p;
-    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_OBJECT_NPC_DATA);
-    p.WriteS32Little(objState->GetEntityID());
-    p.WriteU32Little(obj->GetID());
-    p.WriteU8(obj->GetState());
-    p.WriteS32Little((int32_t)zone->GetID());
-    p.WriteS32Little((int32_t)zone->GetDefinitionID());
-    p.WriteFloat(objState->GetCurrentX());
-    p.WriteFloat(objState->GetCurrentY());
-    p.WriteFloat(objState->GetCurrentRotation());
+    if(!cache->Load(key, p))
+    {
+        p.WritePacketCode(
+            ChannelToClientPacketCode_t::PACKET_OBJECT_NPC_DATA);
+        p.WriteS32Little(objState->GetEntityID());
+        p.WriteU32Little(obj->GetID());
+        p.WriteU8(obj->GetState());
+        p.WriteS32Little((int32_t)zone->GetID());
+        p.WriteS32Little((int32_t)zone->GetDefinitionID());
+        p.WriteFloat(objState->GetCurrentX());
+        p.WriteFloat(objState->GetCurrentY());
+        p.WriteFloat(objState->GetCurrentRotation());
 
-    ChannelClientConnection::BroadcastPacket(clients, p, true);
+        cache->Store(key, p);
+    }
+
+    ChannelClientConnection::QueuePacketToAll(clients, p);
 
     ShowEntity(clients, objState->GetEntityID(), true);
 
@@ -2395,9 +2796,9 @@ void ZoneManager::SendLootBoxData(const std::shared_ptr<ChannelClientConnection>
     }
 
     // Send the data and prepare it to show
+    ChannelClientConnection::QueuePacketToAll(clients, p);
     for(auto zClient : clients)
     {
-        zClient->QueuePacketCopy(p);
         PopEntityForProduction(zClient, lState->GetEntityID(), 0, true);
     }
 
@@ -2629,37 +3030,47 @@ void ZoneManager::SendEnemyData(const std::shared_ptr<EnemyState>& enemyState,
     auto stats = enemyState->GetCoreStats();
     auto zoneData = zone->GetDefinition();
 
+    // Reuse the last packet built if nothing in it has changed
+    auto cache = enemyState->GetShowPacketCache();
+    EntityPacketCache::Key_t key = {
+        (int64_t)zone->GetID(),
+        (int64_t)enemyState->GetMaxHP(),
+        (int64_t)stats->GetHP(),
+        (int64_t)stats->GetLevel(),
+        EntityPacketCache::FloatKey(enemyState->GetDestinationX()),
+        EntityPacketCache::FloatKey(enemyState->GetDestinationY()),
+        EntityPacketCache::FloatKey(enemyState->GetDestinationRotation()),
+        enemyState->GetStatusEffectDataKey()
+    };
+
     libcomp::Packet p;
-    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_ENEMY_DATA);
-    p.WriteS32Little(enemyState->GetEntityID());
-    p.WriteS32Little((int32_t)eBase->GetType());
-    p.WriteS32Little(enemyState->GetMaxHP());
-    p.WriteS32Little(stats->GetHP());
-    p.WriteS8(stats->GetLevel());
-    p.WriteS32Little((int32_t)zone->GetID());
-    p.WriteS32Little((int32_t)zoneData->GetID());
+    if(!cache->Load(key, p))
+    {
+        p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_ENEMY_DATA);
+        p.WriteS32Little(enemyState->GetEntityID());
+        p.WriteS32Little((int32_t)eBase->GetType());
+        p.WriteS32Little(enemyState->GetMaxHP());
+        p.WriteS32Little(stats->GetHP());
+        p.WriteS8(stats->GetLevel());
+        p.WriteS32Little((int32_t)zone->GetID());
+        p.WriteS32Little((int32_t)zoneData->GetID());
 
-    // Send destination instead of origin so the next move doesn't look
-    // off and they are more likely to be valid for attacking
-    p.WriteFloat(enemyState->GetDestinationX());
-    p.WriteFloat(enemyState->GetDestinationY());
-    p.WriteFloat(enemyState->GetDestinationRotation());
+        // Send destination instead of origin so the next move doesn't look
+        // off and they are more likely to be valid for attacking
+        p.WriteFloat(enemyState->GetDestinationX());
+        p.WriteFloat(enemyState->GetDestinationY());
+        p.WriteFloat(enemyState->GetDestinationRotation());
 
-    auto statusEffects = enemyState->GetCurrentStatusEffectStates();
+        enemyState->WriteStatusEffectData(p);
 
-    p.WriteU32Little(static_cast<uint32_t>(statusEffects.size()));
-    for(auto ePair : statusEffects)
-    {
-        p.WriteU32Little(ePair.first->GetEffect());
-        p.WriteS32Little((int32_t)ePair.second);
-        p.WriteU8(ePair.first->GetStack());
-    }
+        p.WriteU32Little(eBase->GetVariantType());
 
-    p.WriteU32Little(eBase->GetVariantType());
+        cache->Store(key, p);
+    }
 
+    ChannelClientConnection::QueuePacketToAll(clients, p);
     for(auto zClient : clients)
     {
-        zClient->QueuePacketCopy(p);
         PopEntityForProduction(zClient, enemyState->GetEntityID(),
             !client ? 3 : 0, true);
         ShowEntity(zClient, enemyState->GetEntityID(), true);
@@ -2705,33 +3116,43 @@ void ZoneManager::SendAllyData(const std::shared_ptr<AllyState>& allyState,
     auto stats = allyState->GetCoreStats();
     auto zoneData = zone->GetDefinition();
 
+    // Reuse the last packet built if nothing in it has changed
+    auto cache = allyState->GetShowPacketCache();
+    EntityPacketCache::Key_t key = {
+        (int64_t)zone->GetID(),
+        (int64_t)allyState->GetMaxHP(),
+        (int64_t)stats->GetHP(),
+        (int64_t)stats->GetLevel(),
+        EntityPacketCache::FloatKey(allyState->GetDestinationX()),
+        EntityPacketCache::FloatKey(allyState->GetDestinationY()),
+        EntityPacketCache::FloatKey(allyState->GetDestinationRotation()),
+        allyState->GetStatusEffectDataKey()
+    };
+
     libcomp::Packet p;
-    p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_ALLY_DATA);
-    p.WriteS32Little(allyState->GetEntityID());
-    p.WriteS32Little((int32_t)allyState->GetEntity()->GetType());
-    p.WriteS32Little(allyState->GetMaxHP());
-    p.WriteS32Little(stats->GetHP());
-    p.WriteS8(stats->GetLevel());
-    p.WriteS32Little((int32_t)zone->GetID());
-    p.WriteS32Little((int32_t)zoneData->GetID());
+    if(!cache->Load(key, p))
+    {
+        p.WritePacketCode(ChannelToClientPacketCode_t::PACKET_ALLY_DATA);
+        p.WriteS32Little(allyState->GetEntityID());
+        p.WriteS32Little((int32_t)allyState->GetEntity()->GetType());
+        p.WriteS32Little(allyState->GetMaxHP());
+        p.WriteS32Little(stats->GetHP());
+        p.WriteS8(stats->GetLevel());
+        p.WriteS32Little((int32_t)zone->GetID());
+        p.WriteS32Little((int32_t)zoneData->GetID());
 
-    // Send destination instead of origin so the next move doesn't look
-    // off and they are more likely to be valid for using skills on
-    p.WriteFloat(allyState->GetDestinationX());
-    p.WriteFloat(allyState->GetDestinationY());
-    p.WriteFloat(allyState->GetDestinationRotation());
+        // Send destination instead of origin so the next move doesn't look
+        // off and they are more likely to be valid for using skills on
+        p.WriteFloat(allyState->GetDestinationX());
+        p.WriteFloat(allyState->GetDestinationY());
+        p.WriteFloat(allyState->GetDestinationRotation());
 
-    auto statusEffects = allyState->GetCurrentStatusEffectStates();
+        allyState->WriteStatusEffectData(p);
 
-    p.WriteU32Little(static_cast<uint32_t>(statusEffects.size()));
-    for(auto ePair : statusEffects)
-    {
-        p.WriteU32Little(ePair.first->GetEffect());
-        p.WriteS32Little((int32_t)ePair.second);
-        p.WriteU8(ePair.first->GetStack());
-    }
+        p.WriteU32Little(allyState->GetEntity()->GetVariantType());
 
-    p.WriteU32Little(allyState->GetEntity()->GetVariantType());
+        cache->Store(key, p);
+    }
 
     // Ally NPCs have a unique distinction from enemies that allows them to
     // contextually be treated as enemies to player entities with non-default
@@ -3137,29 +3558,29 @@ void ZoneManager::HandleSpecialInstancePopulate(
 void ZoneManager::BroadcastPacket(const std::shared_ptr<ChannelClientConnection>& client,
     libcomp::Packet& p, bool includeSelf)
 {
-    std::list<std::shared_ptr<libcomp::TcpConnection>> connections;
-    for(auto connection : GetZoneConnections(client, includeSelf))
-    {
-        connections.push_back(connection);
-    }
-
-    libcomp::TcpConnection::BroadcastPacket(connections, p);
+    BroadcastPacket(GetZoneConnections(client, includeSelf), p);
 }
 
 void ZoneManager::BroadcastPacket(const std::shared_ptr<Zone>& zone, libcomp::Packet& p)
 {
     if(nullptr != zone)
     {
-        std::list<std::shared_ptr<libcomp::TcpConnection>> connections;
-        for(auto connectionPair : zone->GetConnections())
-        {
-            connections.push_back(connectionPair.second);
-        }
-
-        libcomp::TcpConnection::BroadcastPacket(connections, p);
+        BroadcastPacket(zone->GetConnectionList(), p);
     }
 }
 
+void ZoneManager::BroadcastPacket(const std::list<std::shared_ptr<
+    ChannelClientConnection>>& clients, libcomp::Packet& p)
+{
+    // Zone wide packets can reference any entity in the zone so finish
+    // sending the zone entry snapshot to anyone still waiting on it first
+    SendPendingZoneInData(clients);
+
+    // Send through the client connections so the writes join any active
+    // packet batch
+    ChannelClientConnection::BroadcastPacket(clients, p);
+}
+
 void ZoneManager::SendToRange(const std::shared_ptr<ChannelClientConnection>& client,
     libcomp::Packet& p, bool includeSelf)
 {
@@ -3168,26 +3589,44 @@ void ZoneManager::SendToRange(const std::shared_ptr<ChannelClientConnection>& cl
     auto state = client->GetClientState();
     auto cState = state->GetCharacterState();
 
-    cState->RefreshCurrentPosition(now);
-
-    std::list<std::shared_ptr<libcomp::TcpConnection>> zConnections;
+    std::list<std::shared_ptr<ChannelClientConnection>> zConnections;
     if(includeSelf)
     {
         zConnections.push_back(client);
     }
 
+    // The sender is often moving on this very packet so always use its
+    // exact position
+    cState->RefreshCurrentPosition(now);
+    float x = cState->GetCurrentX();
+    float y = cState->GetCurrentY();
+
+    // Draw distance does not need sub-tick precision for everyone else so
+    // use the zone's position snapshot for anyone it recorded
+    auto zone = cState->GetZone();
+    auto snapshot = zone ? zone->GetPositionSnapshot(now) : nullptr;
+
     float rSquared = (float)std::pow(MAX_ENTITY_DRAW_DISTANCE, 2);
     for(auto zConnection : GetZoneConnections(client, false))
     {
         auto otherCState = zConnection->GetClientState()->GetCharacterState();
-        otherCState->RefreshCurrentPosition(now);
 
-        if(rSquared >= cState->GetDistance(otherCState, true))
+        float otherX = 0.f, otherY = 0.f;
+        if(!snapshot || !snapshot->GetPosition(otherCState->GetEntityID(),
+            otherX, otherY))
+        {
+            otherCState->RefreshCurrentPosition(now);
+            otherX = otherCState->GetCurrentX();
+            otherY = otherCState->GetCurrentY();
+        }
+
+        if(rSquared >= (float)(std::pow(otherX - x, 2) +
+            std::pow(otherY - y, 2)))
         {
             zConnections.push_back(zConnection);
         }
     }
-    libcomp::TcpConnection::BroadcastPacket(zConnections, p);
+    BroadcastPacket(zConnections, p);
 }
 
 std::list<std::shared_ptr<ChannelClientConnection>> ZoneManager::GetZoneConnections(
@@ -4705,6 +5144,21 @@ void ZoneManager::UpdateActiveZoneStates()
 
     bool isNight = worldClock.IsNight();
 
+    // Rotate the zone order every tick so the same zones are not always
+    // left with the smallest share of the AI time budget
+    if(zones.size() > 1)
+    {
+        auto it = zones.begin();
+        std::advance(it, (size_t)(mAIZoneOffset++ % (uint32_t)zones.size()));
+        zones.splice(zones.end(), zones, zones.begin(), it);
+    }
+
+    auto config = std::dynamic_pointer_cast<objects::ChannelConfig>(
+        server->GetConfig());
+    uint64_t aiBudget = (uint64_t)config->GetAITickBudget();
+    uint64_t aiTime = 0;
+    size_t zonesLeft = zones.size();
+
     for(auto zone : zones)
     {
         perf.Start();
@@ -4723,11 +5177,27 @@ void ZoneManager::UpdateActiveZoneStates()
             }
         }
 
-        // Update active AI controlled entities
+        // Record where everything is for this tick before the AI starts
+        // querying positions
+        zone->UpdatePositionSnapshot(serverTime);
+
+        // Update active AI controlled entities, splitting what is left of
+        // the budget evenly between the remaining zones
+        uint64_t aiStart = ChannelServer::GetServerTime();
+        uint64_t aiDeadline = 0;
+        if(aiBudget)
+        {
+            aiDeadline = aiStart + (aiBudget > aiTime
+                ? (aiBudget - aiTime) / (uint64_t)zonesLeft : 0);
+        }
+
         perf2.Start();
-        aiManager->UpdateActiveStates(zone, serverTime, isNight);
+        aiManager->UpdateActiveStates(zone, serverTime, isNight, aiDeadline);
         perf2.Stop("Zone AI");
 
+        aiTime += ChannelServer::GetServerTime() - aiStart;
+        zonesLeft--;
+
         // Update staggered spawns before doing any normal spawns
         if(zone->HasStaggeredSpawns(serverTime))
         {
@@ -4748,6 +5218,8 @@ void ZoneManager::UpdateActiveZoneStates()
         perf.Stop(libcomp::String("Zone %1").Arg(zone->GetDefinitionID()));
     }
 
+    aiManager->RecordTickTime(aiTime);
+
     // Get any updated time restricted zones and clear the list
     // after retrieval (essentially they "unfreeze" momentarily)
     {
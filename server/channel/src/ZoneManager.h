@@ -33,6 +33,9 @@
 // libcomp Includes
 #include <Mutex.h>
 
+// Standard C++11 Includes
+#include <mutex>
+
 // channel Includes
 #include "ChannelClientConnection.h"
 #include "Zone.h"
@@ -61,6 +64,44 @@ class WorldClockTime;
 
 typedef objects::ServerZoneTrigger::Trigger_t ZoneTrigger_t;
 
+/**
+ * Entity queued to be sent to a client as part of the snapshot built when
+ * they enter a zone.
+ */
+struct ZoneInEntry
+{
+    // Entity ID of the entity to show
+    int32_t EntityID = 0;
+
+    // Type of the entity, used to look it up again when it is sent
+    EntityType_t Type = EntityType_t::OBJECT;
+
+    // Zone specific key for entity types not stored by entity ID
+    // (plasma and culture machines)
+    uint32_t Key = 0;
+
+    // Send priority, lower values are sent first
+    uint8_t Priority = 0;
+
+    // Squared distance from the player's character on zone entry
+    float DistanceSq = 0.f;
+
+    // Approximate number of bytes sent to the client to show the entity
+    uint32_t Size = 0;
+};
+
+/**
+ * Zone entry snapshot entries still waiting to be sent to a client.
+ */
+struct ZoneInStream
+{
+    // Unique ID of the zone the snapshot was built for
+    uint32_t ZoneID = 0;
+
+    // Entries left to send, in send order
+    std::list<ZoneInEntry> Entries;
+};
+
 /**
  * Manager to handle zone focused actions.
  */
@@ -198,6 +239,18 @@ public:
      */
     std::shared_ptr<ZoneInstance> GetInstance(uint32_t instanceID);
 
+    /**
+     * Get the number of zone instances that currently exist
+     * @return Number of zone instances
+     */
+    size_t GetInstanceCount();
+
+    /**
+     * Get every zone currently being updated
+     * @return List of pointers to the active zones
+     */
+    std::list<std::shared_ptr<Zone>> GetActiveZones();
+
     /**
      * Get the zone instance access available to the supplied world CID
      * @param worldCID Character world CID
@@ -281,6 +334,9 @@ public:
     /**
      * Send data about entities that exist in a zone to a new connection and
      * update any existing connections with information about the new one.
+     * Entities are sent nearest first by priority and anything outside of
+     * the configured draw distance is streamed to the client over the
+     * following ticks via @ref StreamPendingZoneInData.
      * @param client Client connection that was added to a zone
      * @return true if the client is in a zone, false if they are not
      */
@@ -500,6 +556,15 @@ public:
      */
     void BroadcastPacket(const std::shared_ptr<Zone>& zone, libcomp::Packet& p);
 
+    /**
+     * Send a packet to a list of connections in the same zone. Any part
+     * of their zone entry snapshot still pending is sent first.
+     * @param clients List of client connections to send the packet to
+     * @param p Packet to send to the clients
+     */
+    void BroadcastPacket(const std::list<std::shared_ptr<
+        ChannelClientConnection>>& clients, libcomp::Packet& p);
+
     /**
     * sends a packet to a specified range
     * @param client Client connection to use as the "source" connection
@@ -697,6 +762,24 @@ public:
      */
     void UpdateActiveZoneStates();
 
+    /**
+     * Send the next part of any zone entry snapshots still pending for
+     * clients that recently entered a zone. Each client is sent at most
+     * the configured ZoneInByteBudget per call.
+     */
+    void StreamPendingZoneInData();
+
+    /**
+     * Send the rest of the zone entry snapshot to each supplied client
+     * still waiting on one. The zone broadcast helpers call this before
+     * sending so zone wide packets never reference an entity a client has
+     * not been shown yet.
+     * @param clients List of client connections about to be sent a zone
+     *  wide packet
+     */
+    void SendPendingZoneInData(const std::list<std::shared_ptr<
+        ChannelClientConnection>>& clients);
+
     /**
      * Update the state of status effects in the supplied zone, adding
      * and updating existing effects, expiring old effects and applying
@@ -1133,6 +1216,67 @@ public:
         std::list<std::shared_ptr<objects::InstanceAccess>> removes);
 
 private:
+    /**
+     * Build the list of entities to show to a client entering a zone,
+     * sorted by priority then distance from the supplied character.
+     * @param zone Pointer to the zone being entered
+     * @param cState Pointer to the state of the character entering
+     * @return List of snapshot entries in send order
+     */
+    std::list<ZoneInEntry> GetZoneInEntries(const std::shared_ptr<Zone>& zone,
+        const std::shared_ptr<CharacterState>& cState);
+
+    /**
+     * Queue the data needed to show one zone entry snapshot entity to
+     * the supplied client. Entities that no longer exist or are no longer
+     * visible are skipped.
+     * @param client Pointer to the client connection
+     * @param zone Pointer to the zone the client is in
+     * @param entry Snapshot entry to send
+     */
+    void SendZoneInEntry(const std::shared_ptr<ChannelClientConnection>& client,
+        const std::shared_ptr<Zone>& zone, const ZoneInEntry& entry);
+
+    /**
+     * Remove an entity from the zone entry snapshots still pending for
+     * the supplied clients as it is being shown or removed explicitly.
+     * @param clients List of client connections the entity is sent to
+     * @param entityID ID of the entity
+     */
+    void DropPendingZoneInEntity(const std::list<std::shared_ptr<
+        ChannelClientConnection>>& clients, int32_t entityID);
+
+    /**
+     * Queue the data for a plasma spawn to the supplied client.
+     * @param client Pointer to the client connection
+     * @param zone Pointer to the zone the plasma exists in
+     * @param pState Pointer to the state of the plasma
+     */
+    void SendPlasmaData(const std::shared_ptr<ChannelClientConnection>& client,
+        const std::shared_ptr<Zone>& zone,
+        const std::shared_ptr<PlasmaState>& pState);
+
+    /**
+     * Queue the data for a bazaar to the supplied client.
+     * @param client Pointer to the client connection
+     * @param zone Pointer to the zone the bazaar exists in
+     * @param bState Pointer to the state of the bazaar
+     */
+    void SendBazaarData(const std::shared_ptr<ChannelClientConnection>& client,
+        const std::shared_ptr<Zone>& zone,
+        const std::shared_ptr<BazaarState>& bState);
+
+    /**
+     * Queue the data for a culture machine to the supplied client.
+     * @param client Pointer to the client connection
+     * @param zone Pointer to the zone the machine exists in
+     * @param machineID Zone specific ID of the culture machine
+     * @param cmState Pointer to the state of the culture machine
+     */
+    void SendCultureMachineData(const std::shared_ptr<
+        ChannelClientConnection>& client, const std::shared_ptr<Zone>& zone,
+        uint32_t machineID, const std::shared_ptr<CultureMachineState>& cmState);
+
     /**
      * Select a spot for a spawn group and get it's location.
      * @param useSpotID If the spot ID should be used.
@@ -1454,6 +1598,13 @@ private:
     /// any zone
     std::list<std::shared_ptr<objects::ServerZoneTrigger>> mGlobalTimeTriggers;
 
+    /// Map of world CIDs to zone entry snapshot entries that have not been
+    /// sent to the client yet
+    std::unordered_map<int32_t, ZoneInStream> mPendingZoneIn;
+
+    /// Server lock for the pending zone entry snapshots
+    std::mutex mPendingZoneInLock;
+
     /// Next server time that tracked zones will be refreshed during
     ServerTime mTrackingRefresh;
 
@@ -1463,6 +1614,9 @@ private:
     /// Next available zone instance unique ID
     uint32_t mNextZoneInstanceID;
 
+    /// Offset of the first active zone to update AI for on the next tick
+    uint32_t mAIZoneOffset;
+
     /// Server lock for shared resources
     libcomp::Mutex mLock;
 
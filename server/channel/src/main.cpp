@@ -27,6 +27,7 @@
 // channel Includes
 #include "ChannelConfig.h"
 #include "ChannelServer.h"
+#include "MetricsHandler.h"
 
 // libcomp Includes
 #include <Config.h>
@@ -37,6 +38,13 @@
 #include <ServerCommandLineParser.h>
 #include <Shutdown.h>
 
+// Civet Includes
+#include <CivetServer.h>
+
+// Standard C++11 Includes
+#include <string>
+#include <vector>
+
 #if defined(_WIN32) && defined(WIN32_SERV)
 int ApplicationMain(int argc, const char *argv[])
 #else
@@ -106,12 +114,43 @@ int main(int argc, const char *argv[])
         return EXIT_FAILURE;
     }
 
+    // Serve the metrics for monitoring if a port has been configured.
+    channel::MetricsHandler metricsHandler(server);
+    CivetServer *pMetricsServer = nullptr;
+
+    if(0 != config->GetMetricsPort())
+    {
+        std::vector<std::string> options;
+        options.push_back("listening_ports");
+        options.push_back(std::to_string(config->GetMetricsPort()));
+
+        try
+        {
+            pMetricsServer = new CivetServer(options);
+            pMetricsServer->addHandler("/metrics", metricsHandler);
+        }
+        catch(CivetException e)
+        {
+            LogGeneralError([&]()
+            {
+                return libcomp::String("The metrics server failed to start "
+                    "with the following message: %1\n").Arg(e.what());
+            });
+
+            pMetricsServer = nullptr;
+        }
+    }
+
     // Set this for the signal handler.
     libcomp::Shutdown::Configure(server.get());
 
     // Start the main server loop (blocks until done).
     int returnCode = server->Start(true);
 
+    // Shut down the metrics server.
+    delete pMetricsServer;
+    pMetricsServer = nullptr;
+
     // Complete the shutdown process.
     libcomp::Shutdown::Complete();
 
@@ -29,12 +29,17 @@
 // libcomp Includes
 #include <Account.h>
 #include <AccountLogin.h>
-#include <Crypto.h>
 #include <Log.h>
 #include <ManagerPacket.h>
 #include <Packet.h>
 #include <PacketCodes.h>
 
+// Standard C++11 Includes
+#include <cstdio>
+
+// OpenSSL Includes
+#include <openssl/evp.h>
+
 // channel Includes
 #include "AccountManager.h"
 #include "ChannelServer.h"
@@ -43,63 +48,159 @@ using namespace channel;
 
 #define PART_SIZE (1024)
 
-void DumpAccount(AccountManager* accountManager,
-    const std::shared_ptr<ChannelClientConnection> client)
+// Number of parts sent each time the server ticks so a large dump does
+// not all sit in the outgoing queue at once
+#define PARTS_PER_TICK (64)
+
+/**
+ * Account dump written to a temporary file while it is generated and
+ * then read back as each part is sent.
+ */
+struct AccountDumpSpool
 {
-    auto state = client->GetClientState();
+    AccountDumpSpool() : File(std::tmpfile()), Size(0), NextPart(1),
+        PartCount(0)
+    {
+    }
 
-    std::string dump = accountManager->DumpAccount(state).ToUtf8();
+    ~AccountDumpSpool()
+    {
+        if(File)
+        {
+            std::fclose(File);
+        }
+    }
 
-    // Send the account dump to the client.
-    if(!dump.empty())
+    /// Temporary file containing the dump
+    std::FILE *File;
+
+    /// Size of the dump in bytes
+    uint32_t Size;
+
+    /// Number of the next part to send
+    uint32_t NextPart;
+
+    /// Total number of parts to send
+    uint32_t PartCount;
+};
+
+void SendDumpParts(ChannelServer* server,
+    const std::shared_ptr<ChannelClientConnection> client,
+    const std::shared_ptr<AccountDumpSpool> spool)
+{
+    // Stop sending if the client has gone away
+    if(libcomp::TcpConnection::STATUS_CONNECTED != client->GetStatus())
     {
-        std::vector<char> dumpData(dump.c_str(), dump.c_str() + dump.size());
+        return;
+    }
+
+    char part[PART_SIZE];
 
+    for(int i = 0; i < PARTS_PER_TICK && spool->NextPart <= spool->PartCount;
+        i++)
+    {
+        uint32_t partSize = (uint32_t)std::fread(part, 1, PART_SIZE,
+            spool->File);
+        if(!partSize)
         {
-            auto accountName = state->GetAccountLogin()->GetAccount(
-                )->GetUsername();
-
-            libcomp::Packet reply;
-            reply.WritePacketCode(
-                ChannelToClientPacketCode_t::PACKET_AMALA_ACCOUNT_DUMP_HEADER);
-            reply.WriteU32Little((uint32_t)dump.size());
-            reply.WriteU32Little(((uint32_t)dump.size() + PART_SIZE - 1) /
-                PART_SIZE);
-            reply.WriteString16Little(
-                libcomp::Convert::Encoding_t::ENCODING_UTF8,
-                libcomp::Crypto::SHA1(dumpData), true);
-            reply.WriteString16Little(
-                libcomp::Convert::Encoding_t::ENCODING_UTF8,
-                accountName, true);
-
-            client->SendPacket(reply);
+            LogGeneralErrorMsg("Failed to read back account dump.\n");
+
+            return;
         }
 
-        const char *szNextPart = &dumpData[0];
-        const char *szEnd = szNextPart + dump.size();
+        libcomp::Packet reply;
+        reply.WritePacketCode(
+            ChannelToClientPacketCode_t::PACKET_AMALA_ACCOUNT_DUMP_PART);
+        reply.WriteU32Little(spool->NextPart++);
+        reply.WriteU32Little(partSize);
+        reply.WriteArray(part, partSize);
 
-        uint32_t partNumber = 1;
+        client->SendPacket(reply);
+    }
 
-        while(szNextPart < szEnd)
-        {
-            uint32_t partSize = (uint32_t)(szEnd - szNextPart);
+    if(spool->NextPart <= spool->PartCount)
+    {
+        server->ScheduleWork(ChannelServer::GetServerTime(), SendDumpParts,
+            server, client, spool);
+    }
+}
+
+void DumpAccount(ChannelServer* server,
+    const std::shared_ptr<ChannelClientConnection> client)
+{
+    auto state = client->GetClientState();
+
+    auto spool = std::make_shared<AccountDumpSpool>();
+    if(!spool->File)
+    {
+        LogGeneralErrorMsg("Failed to create account dump file.\n");
 
-            if(partSize > PART_SIZE)
+        return;
+    }
+
+    // Hash the dump as it is written so it never has to be read back
+    // into memory as a whole
+    EVP_MD_CTX *pHash = EVP_MD_CTX_create();
+    EVP_DigestInit_ex(pHash, EVP_sha1(), nullptr);
+
+    bool dumped = server->GetAccountManager()->DumpAccount(state,
+        [&](const std::string& data)
+        {
+            if(data.size() != std::fwrite(data.c_str(), 1, data.size(),
+                spool->File))
             {
-                partSize = PART_SIZE;
+                return false;
             }
 
-            libcomp::Packet reply;
-            reply.WritePacketCode(
-                ChannelToClientPacketCode_t::PACKET_AMALA_ACCOUNT_DUMP_PART);
-            reply.WriteU32Little(partNumber++);
-            reply.WriteU32Little(partSize);
-            reply.WriteArray(szNextPart, partSize);
+            EVP_DigestUpdate(pHash, data.c_str(), data.size());
+            spool->Size = (uint32_t)(spool->Size + data.size());
 
-            client->SendPacket(reply);
+            return true;
+        });
 
-            szNextPart += partSize;
-        }
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestSize = 0;
+
+    EVP_DigestFinal_ex(pHash, digest, &digestSize);
+    EVP_MD_CTX_destroy(pHash);
+
+    // Same lower case hex string libcomp::Crypto::SHA1 returns so the
+    // hash the client checks does not change
+    char szHash[EVP_MAX_MD_SIZE * 2 + 1] = { 0 };
+
+    for(unsigned int i = 0; i < digestSize; i++)
+    {
+        std::snprintf(&szHash[i * 2], 3, "%02x", digest[i]);
+    }
+
+    libcomp::String hash(szHash);
+
+    // Send the account dump to the client.
+    if(dumped && spool->Size && 0 == std::fseek(spool->File, 0, SEEK_SET))
+    {
+        spool->PartCount = (spool->Size + PART_SIZE - 1) / PART_SIZE;
+
+        auto accountName = state->GetAccountLogin()->GetAccount(
+            )->GetUsername();
+
+        libcomp::Packet reply;
+        reply.WritePacketCode(
+            ChannelToClientPacketCode_t::PACKET_AMALA_ACCOUNT_DUMP_HEADER);
+        reply.WriteU32Little(spool->Size);
+        reply.WriteU32Little(spool->PartCount);
+        reply.WriteString16Little(
+            libcomp::Convert::Encoding_t::ENCODING_UTF8, hash, true);
+        reply.WriteString16Little(
+            libcomp::Convert::Encoding_t::ENCODING_UTF8,
+            accountName, true);
+
+        client->SendPacket(reply);
+
+        SendDumpParts(server, client, spool);
+    }
+    else if(!dumped)
+    {
+        LogGeneralErrorMsg("Failed to dump account.\n");
     }
 }
 
@@ -118,7 +219,7 @@ bool Parsers::AmalaAccountDumpRequest::Parse(
     auto server = std::dynamic_pointer_cast<ChannelServer>(
         pPacketManager->GetServer());
 
-    server->QueueWork(DumpAccount, server->GetAccountManager(), client);
+    server->QueueWork(DumpAccount, server.get(), client);
 
     return true;
 }
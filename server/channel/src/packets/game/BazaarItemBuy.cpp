@@ -42,6 +42,7 @@
 #include <ServerZone.h>
 
 // channel Includes
+#include "BazaarPriceIndex.h"
 #include "ChannelServer.h"
 #include "CharacterManager.h"
 #include "ManagerConnection.h"
@@ -189,6 +190,8 @@ bool Parsers::BazaarItemBuy::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS32Little(0);    // Success
                 success = true;
 
+                server->GetBazaarPriceIndex()->RecordSale(bItem);
+
                 std::list<uint16_t> updatedSlots = { (uint16_t)destSlot };
                 server->GetCharacterManager()->SendItemBoxData(client,
                     inventory, updatedSlots);
@@ -42,6 +42,7 @@
 // channel Includes
 #include "BazaarState.h"
 #include "ChannelServer.h"
+#include "ChannelSyncManager.h"
 #include "CharacterManager.h"
 
 using namespace channel;
@@ -89,9 +90,10 @@ bool Parsers::BazaarMarketInfo::Parse(libcomp::ManagerPacket *pPacketManager,
         {
             reply.WriteS32Little(0);    // Success
 
-            auto owner = market->GetCharacter().Get(worldDB);
+            auto owner = server->GetChannelSyncManager()->GetProfileCache()
+                ->GetCharacterProfile(market->GetCharacter().GetUUID());
             reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                owner ? owner->GetName() : "", true);
+                owner ? owner->Name : "", true);
 
             int32_t itemCount = 0;
             for(auto bItem : market->GetItems())
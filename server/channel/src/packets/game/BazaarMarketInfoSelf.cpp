@@ -40,6 +40,7 @@
 // channel Includes
 #include "BazaarState.h"
 #include "ChannelServer.h"
+#include "ChannelSyncManager.h"
 #include "CharacterManager.h"
 
 using namespace channel;
@@ -63,13 +64,16 @@ bool Parsers::BazaarMarketInfoSelf::Parse(libcomp::ManagerPacket *pPacketManager
     auto bazaarData = objects::BazaarData::LoadBazaarDataByAccount(worldDB,
         state->GetAccountUID());
 
-    auto character = bazaarData ? bazaarData->LoadCharacter(worldDB) : nullptr;
+    // Only the owner name is needed so use the shared profile
+    auto character = bazaarData ? server->GetChannelSyncManager()
+        ->GetProfileCache()->GetCharacterProfile(bazaarData->GetCharacter()
+            .GetUUID()) : nullptr;
 
     libcomp::Packet reply;
     reply.WritePacketCode(ChannelToClientPacketCode_t::PACKET_BAZAAR_MARKET_INFO_SELF);
     reply.WriteS32Little(0);    // Success
     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-        character ? character->GetName() : "", true);
+        character ? character->Name : "", true);
     reply.WriteS8(bazaarData ? (int8_t)bazaarData->GetChannelID() : -1);
     reply.WriteU32Little(bazaarData ? bazaarData->GetZone() : 0);
     reply.WriteU32Little(bazaarData ? bazaarData->GetMarketID() : 0);
@@ -196,7 +196,7 @@ bool Parsers::BazaarMarketOpen::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(-1);   // Failure
     }
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     // Lastly clear the reservation
     if(reserved)
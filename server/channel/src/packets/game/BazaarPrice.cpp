@@ -38,11 +38,29 @@
 #include <MiItemData.h>
 #include <Item.h>
 
+// Standard C++11 Includes
+#include <algorithm>
+#include <limits>
+
 // channel Includes
+#include "BazaarPriceIndex.h"
 #include "ChannelServer.h"
 
 using namespace channel;
 
+namespace
+{
+
+/// Clamp a price to what fits in the packet. Prices are player set so
+/// a unit price times a full stack can be larger than a 32-bit value.
+int32_t ClampPrice(int64_t price)
+{
+    return (int32_t)std::max((int64_t)std::numeric_limits<int32_t>::min(),
+        std::min(price, (int64_t)std::numeric_limits<int32_t>::max()));
+}
+
+} // namespace
+
 bool Parsers::BazaarPrice::Parse(libcomp::ManagerPacket *pPacketManager,
     const std::shared_ptr<libcomp::TcpConnection>& connection,
     libcomp::ReadOnlyPacket& p) const
@@ -72,14 +90,29 @@ bool Parsers::BazaarPrice::Parse(libcomp::ManagerPacket *pPacketManager,
 
         reply.WriteS32Little(0);   // Success
 
-        int32_t refPrice = itemData->GetBasic()->GetBuyPrice() *
-            (int32_t)item->GetStackSize();
-
-        reply.WriteS32Little(refPrice); // Reference
-
-        // High/low suggestions default to +/-20% the reference price
-        reply.WriteS32Little((int32_t)((double)refPrice * 1.2));
-        reply.WriteS32Little((int32_t)((double)refPrice * 0.8));
+        int64_t stack = (int64_t)item->GetStackSize();
+
+        BazaarPriceSummary summary;
+        if(server->GetBazaarPriceIndex()->GetSummary(item->GetType(),
+            summary))
+        {
+            // Suggest the median of recent sales as the reference price
+            // with the interquartile range as the high/low suggestions
+            reply.WriteS32Little(ClampPrice(summary.Median * stack));
+            reply.WriteS32Little(ClampPrice(summary.High * stack));
+            reply.WriteS32Little(ClampPrice(summary.Low * stack));
+        }
+        else
+        {
+            int64_t refPrice = (int64_t)itemData->GetBasic()->GetBuyPrice() *
+                stack;
+
+            reply.WriteS32Little(ClampPrice(refPrice)); // Reference
+
+            // High/low suggestions default to +/-20% the reference price
+            reply.WriteS32Little(ClampPrice((int64_t)((double)refPrice * 1.2)));
+            reply.WriteS32Little(ClampPrice((int64_t)((double)refPrice * 0.8)));
+        }
     }
     else
     {
@@ -95,7 +95,7 @@ bool Parsers::BazaarState::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(0);    // No error
     }
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     return true;
 }
@@ -92,7 +92,9 @@ bool Parsers::ChannelList::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS8(0);   // 0 = visible, 2 = Specialty (ex: PvP)
     }
 
-    connection->SendPacket(reply);
+    auto client = std::dynamic_pointer_cast<ChannelClientConnection>(
+        connection);
+    client->SendPacket(reply);
 
     return true;
 }
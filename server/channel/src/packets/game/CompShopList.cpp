@@ -88,7 +88,9 @@ bool Parsers::CompShopList::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(-1);    // No first idx, none exist
     }
 
-    connection->SendPacket(reply);
+    auto client = std::dynamic_pointer_cast<ChannelClientConnection>(
+        connection);
+    client->SendPacket(reply);
 
     return true;
 }
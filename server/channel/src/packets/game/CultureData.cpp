@@ -70,7 +70,7 @@ bool Parsers::CultureData::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteU32Little(active ? cultureItem->GetType()
         : static_cast<uint32_t>(-1));
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     return true;
 }
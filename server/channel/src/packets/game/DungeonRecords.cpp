@@ -68,7 +68,7 @@ bool Parsers::DungeonRecords::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteU16Little(trialTime ? trialTime : (uint16_t)-1);
     }
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     return true;
 }
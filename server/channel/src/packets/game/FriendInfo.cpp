@@ -71,7 +71,7 @@ bool Parsers::FriendInfo::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteU8(privacySet ? 1 : 0);
     reply.WriteU8(fSettings->GetPublicToZone() ? 1 : 0);
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     // Request current friend info from the world to send on reply
     libcomp::Packet request;
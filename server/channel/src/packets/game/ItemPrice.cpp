@@ -207,7 +207,9 @@ bool Parsers::ItemPrice::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteU32Little((uint32_t)price);
     reply.WriteS32Little(price > 0 ? 0 : -1);
 
-    connection->SendPacket(reply);
+    auto client = std::dynamic_pointer_cast<ChannelClientConnection>(
+        connection);
+    client->SendPacket(reply);
 
     return true;
 }
@@ -144,6 +144,10 @@ bool Parsers::ItemPromo::Parse(libcomp::ManagerPacket *pPacketManager,
     if(success)
     {
         success = db->ProcessChangeSet(dbChanges);
+        if(success)
+        {
+            state->InvalidatePostItems();
+        }
     }
 
     libcomp::Packet reply;
@@ -87,7 +87,7 @@ bool Parsers::LootDemonEggData::Parse(libcomp::ManagerPacket *pPacketManager,
         }
         reply.WriteS8(-1);  // Unknown
 
-        connection->SendPacket(reply);
+        client->SendPacket(reply);
     }
 
     return true;
@@ -55,7 +55,9 @@ bool Parsers::PAttributeDeadline::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteS8(0);
     reply.WriteS32Little(deadline);
 
-    connection->SendPacket(reply);
+    auto client = std::dynamic_pointer_cast<ChannelClientConnection>(
+        connection);
+    client->SendPacket(reply);
 
     return true;
 }
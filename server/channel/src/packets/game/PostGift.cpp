@@ -68,8 +68,13 @@ bool Parsers::PostGift::Parse(libcomp::ManagerPacket *pPacketManager,
     bool success = false;
     if(!itemUUID.IsNull())
     {
-        auto postItem = libcomp::PersistentObject::LoadObjectByUUID<
-            objects::PostItem>(lobbyDB, itemUUID);
+        auto postItem = state->GetCachedPostItem(itemUUID);
+        if(!postItem)
+        {
+            postItem = libcomp::PersistentObject::LoadObjectByUUID<
+                objects::PostItem>(lobbyDB, itemUUID);
+        }
+
         if(postItem)
         {
             reply.WriteS32Little(0);
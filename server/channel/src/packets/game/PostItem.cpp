@@ -96,6 +96,11 @@ bool Parsers::PostItem::Parse(libcomp::ManagerPacket *pPacketManager,
 
                 client->Close();
             }
+
+            if(success)
+            {
+                state->InvalidatePostItems();
+            }
         }
     }
 
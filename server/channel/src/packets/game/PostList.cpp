@@ -59,43 +59,19 @@ bool Parsers::PostList::Parse(libcomp::ManagerPacket *pPacketManager,
     int32_t slotsRemaining = p.ReadS32Little();
     int32_t itemIdx = p.ReadS32Little();
 
-    // Always reload the items
-    auto postItems = objects::PostItem::LoadPostItemListByAccount(lobbyDB,
-        state->GetAccountUID());
-
-    // Since the post items are not kept in a sequential container,
-    // guarantee the order doesn't change by listing by timestamp,
-    // then type, then UUID
-    postItems.sort([](const std::shared_ptr<objects::PostItem>& a,
-        const std::shared_ptr<objects::PostItem>& b)
-    {
-        return a->GetTimestamp() < b->GetTimestamp() ||
-            (a->GetTimestamp() == b->GetTimestamp() &&
-                a->GetType() < b->GetType()) ||
-            (a->GetTimestamp() == b->GetTimestamp() &&
-                a->GetType() == b->GetType() &&
-                a->GetUUID().ToString() < b->GetUUID().ToString());
-    });
+    // Reload the items when the list is opened, later pages are read
+    // from the cached index
+    bool reload = itemIdx == 0;
+    auto postItems = state->GetPostItems(lobbyDB, reload);
 
     // Adjust the index to only return the ones the client doesn't
     // know about as the client only wants new items
     itemIdx = (int32_t)(itemIdx + (21 - slotsRemaining));
 
     // Pull the items starting at the index
-    std::list<std::shared_ptr<objects::PostItem>> items;
-    if(itemIdx < (int32_t)postItems.size())
-    {
-        auto pIter = postItems.begin();
-        std::advance(pIter, itemIdx);
-
-        for(int32_t i = itemIdx; i < (int32_t)(itemIdx + slotsRemaining) &&
-            pIter != postItems.end(); i++)
-        {
-            auto item = *pIter;
-            items.push_back(item);
-            pIter++;
-        }
-    }
+    size_t total = 0;
+    auto items = state->GetPostItemPage(lobbyDB, itemIdx, slotsRemaining,
+        total);
 
     libcomp::Packet reply;
     reply.WritePacketCode(ChannelToClientPacketCode_t::PACKET_POST_LIST);
@@ -123,9 +99,9 @@ bool Parsers::PostList::Parse(libcomp::ManagerPacket *pPacketManager,
     }
 
     reply.WriteS32Little(itemIdx);
-    reply.WriteS32Little((int32_t)postItems.size());
+    reply.WriteS32Little((int32_t)total);
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     // Send any post items pending distribution
     auto distribute = postItems;
@@ -36,7 +36,6 @@
 // object Includes
 #include <CharacterLogin.h>
 #include <Clan.h>
-#include <ClanMember.h>
 
 // channel Includes
 #include "AccountManager.h"
@@ -57,7 +56,7 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
     auto server = std::dynamic_pointer_cast<ChannelServer>(pPacketManager->GetServer());
     auto client = std::dynamic_pointer_cast<ChannelClientConnection>(connection);
     auto syncManager = server->GetChannelSyncManager();
-    auto worldDB = server->GetWorldDatabase();
+    auto profileCache = syncManager->GetProfileCache();
 
     int32_t type = p.ReadS32Little();
     int32_t entryID = p.ReadS32Little();
@@ -88,11 +87,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little((int32_t)entry->GetPostTime());
 
@@ -106,11 +105,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little((int32_t)entry->GetPostTime());
 
@@ -129,11 +128,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little(ChannelServer::GetExpirationInSeconds(
                     entry->GetExpirationTime()));
@@ -158,47 +157,19 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS16Little((int16_t)entry->GetData(SEARCH_IDX_TIME_TO));
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_PREF_DEMON_RACE));
                 
-                auto clan = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Clan>(worldDB, entry->GetRelatedTo());
+                auto clanProfile = profileCache->GetClanProfile(
+                    entry->GetRelatedTo());
+                auto clan = clanProfile ? clanProfile->Clan : nullptr;
 
                 int8_t averageLevel = 0;
-                std::shared_ptr<objects::ClanMember> masterMember;
                 if(clan)
                 {
-                    std::list<libobjgen::UUID> memberUIDs;
-                    for(auto member : objects::ClanMember::LoadClanMemberListByClan(worldDB,
-                        clan->GetUUID()))
-                    {
-                        if(member->GetMemberType() == objects::ClanMember::MemberType_t::MASTER)
-                        {
-                            masterMember = member;
-                        }
-                        memberUIDs.push_back(member->GetCharacter());
-                    }
-
-                    auto master = masterMember
-                        ? libcomp::PersistentObject::LoadObjectByUUID<objects::Character>(
-                            worldDB, masterMember->GetCharacter()) : nullptr;
-
                     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                         clan->GetName(), true);
                     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                        master ? master->GetName() : "", true);
-
-                    uint8_t memberCount = 0;
-                    uint16_t levelSum = 0;
-                    for(libobjgen::UUID& uuid : memberUIDs)
-                    {
-                        auto stats = objects::EntityStats::LoadEntityStatsByEntity(worldDB,
-                            uuid);
-                        if(stats)
-                        {
-                            memberCount++;
-                            levelSum = (uint16_t)(levelSum + stats->GetLevel());
-                        }
-                    }
-
-                    averageLevel = (int8_t)((levelSum * 1.f) / (memberCount * 1.f));
+                        clanProfile->MasterName, true);
+
+                    averageLevel = clanProfile->AverageLevel;
                 }
                 else
                 {
@@ -208,8 +179,9 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS32Little(ChannelServer::GetExpirationInSeconds(
                     entry->GetExpirationTime()));
 
-                auto cLogin = masterMember ? server->GetAccountManager()
-                    ->GetActiveLogin(masterMember->GetCharacter()) : nullptr;
+                auto cLogin = clanProfile && !clanProfile->MasterUUID.IsNull()
+                    ? server->GetAccountManager()->GetActiveLogin(
+                        clanProfile->MasterUUID) : nullptr;
                 reply.WriteS8(cLogin ? (int8_t)cLogin->GetStatus() : 0);
 
                 reply.WriteS32Little((int32_t)(clan ? clan->GetBaseZoneID() : 0));
@@ -224,11 +196,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little((int32_t)entry->GetPostTime());
 
@@ -258,11 +230,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little((int32_t)entry->GetPostTime());
 
@@ -274,11 +246,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little((int32_t)entry->GetPostTime());
 
@@ -295,11 +267,11 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                     entry->GetTextData(SEARCH_IDX_COMMENT), true);
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS32Little((int32_t)entry->GetPostTime());
 
@@ -316,7 +288,7 @@ bool Parsers::SearchEntryData::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(-1);   // Failure
     }
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     return true;
 }
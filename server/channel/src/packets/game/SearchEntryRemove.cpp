@@ -148,7 +148,7 @@ bool Parsers::SearchEntryRemove::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(-1);
         reply.WriteS32Little(0);
 
-        connection->SendPacket(reply);
+        client->SendPacket(reply);
     }
 
     return true;
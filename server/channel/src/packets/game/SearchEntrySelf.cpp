@@ -238,7 +238,7 @@ bool Parsers::SearchEntrySelf::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteS32Little(previousPageIndexID);
     reply.WriteS32Little(nextPageIndexID);
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     return true;
 }
@@ -302,7 +302,7 @@ bool Parsers::SearchEntryUpdate::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(-1);
         reply.WriteS32Little(entryID);
 
-        connection->SendPacket(reply);
+        client->SendPacket(reply);
     }
 
     return true;
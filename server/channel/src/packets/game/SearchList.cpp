@@ -35,7 +35,6 @@
 
 // object Includes
 #include <Clan.h>
-#include <ClanMember.h>
 #include <EventInstance.h>
 #include <EventState.h>
 
@@ -56,7 +55,7 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
 
     auto server = std::dynamic_pointer_cast<ChannelServer>(pPacketManager->GetServer());
     auto syncManager = server->GetChannelSyncManager();
-    auto worldDB = server->GetWorldDatabase();
+    auto profileCache = syncManager->GetProfileCache();
 
     int32_t type = p.ReadS32Little();
     int32_t pageID = p.ReadS32Little();
@@ -281,18 +280,15 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_GOAL));
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_LOCATION));
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 if(character)
                 {
-                    auto stats = libcomp::PersistentObject::LoadObjectByUUID<
-                        objects::EntityStats>(worldDB, character->GetCoreStats().GetUUID());
-
                     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                        character->GetName(), true);
+                        character->Name, true);
 
-                    reply.WriteS8(stats ? stats->GetLevel() : 0);
+                    reply.WriteS8(character->Level);
                 }
                 else
                 {
@@ -311,18 +307,15 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS32Little(entry->GetEntryID());
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_PLAYSTYLE));
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 if(character)
                 {
-                    auto stats = libcomp::PersistentObject::LoadObjectByUUID<
-                        objects::EntityStats>(worldDB, character->GetCoreStats().GetUUID());
-
                     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                        character->GetName(), true);
+                        character->Name, true);
 
-                    reply.WriteS8(stats ? stats->GetLevel() : 0);
+                    reply.WriteS8(character->Level);
                 }
                 else
                 {
@@ -350,29 +343,12 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS32Little(entry->GetEntryID());
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_PLAYSTYLE));
 
-                auto clan = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Clan>(worldDB, entry->GetRelatedTo());
+                auto clanProfile = profileCache->GetClanProfile(
+                    entry->GetRelatedTo());
+                auto clan = clanProfile ? clanProfile->Clan : nullptr;
 
                 if(clan)
                 {
-                    std::shared_ptr<objects::ClanMember> masterMember;
-                    for(auto member : objects::ClanMember::LoadClanMemberListByClan(worldDB,
-                        clan->GetUUID()))
-                    {
-                        if(member->GetMemberType() == objects::ClanMember::MemberType_t::MASTER)
-                        {
-                            masterMember = member;
-                            break;
-                        }
-                    }
-
-                    auto master = masterMember
-                        ? libcomp::PersistentObject::LoadObjectByUUID<objects::Character>(
-                            worldDB, masterMember->GetCharacter()) : nullptr;
-                    auto masterStats = master
-                        ? libcomp::PersistentObject::LoadObjectByUUID<objects::EntityStats>(
-                            worldDB, master->GetCoreStats().GetUUID()) : nullptr;
-
                     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
                         clan->GetName(), true);
                     reply.WriteS32Little((int32_t)clan->MembersCount());
@@ -382,7 +358,7 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
                     reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_CLAN_IMAGE));
 
                     reply.WriteS8(clan->GetLevel());
-                    reply.WriteS8(masterStats ? masterStats->GetLevel() : 0);
+                    reply.WriteS8(clanProfile->MasterLevel);
 
                     reply.WriteU8(clan->GetEmblemBase());
                     reply.WriteU8(clan->GetEmblemSymbol());
@@ -412,11 +388,11 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
 
                 reply.WriteS32Little(entry->GetData(SEARCH_IDX_ITEM_TYPE));
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 int8_t slotCount = 0;
                 int8_t attrMask = 0;
@@ -466,11 +442,11 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
 
                 reply.WriteS32Little(entry->GetData(SEARCH_IDX_ITEM_TYPE));
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_SUB_CATEGORY));
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_SLOT_COUNT));
@@ -483,18 +459,15 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
                 reply.WriteS32Little(entry->GetEntryID());
                 reply.WriteS8((int8_t)entry->GetData(SEARCH_IDX_GOAL));
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 if(character)
                 {
-                    auto stats = libcomp::PersistentObject::LoadObjectByUUID<
-                        objects::EntityStats>(worldDB, character->GetCoreStats().GetUUID());
-
                     reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                        character->GetName(), true);
+                        character->Name, true);
 
-                    reply.WriteS8(stats ? stats->GetLevel() : 0);
+                    reply.WriteS8(character->Level);
                 }
                 else
                 {
@@ -517,11 +490,11 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
             {
                 reply.WriteS32Little(entry->GetEntryID());
 
-                auto character = libcomp::PersistentObject::LoadObjectByUUID<
-                    objects::Character>(worldDB, entry->GetRelatedTo());
+                auto character = profileCache->GetCharacterProfile(
+                    entry->GetRelatedTo());
 
                 reply.WriteString16Little(libcomp::Convert::ENCODING_CP932,
-                    character ? character->GetName() : "", true);
+                    character ? character->Name : "", true);
 
                 reply.WriteBlank(3);    // Padding?
             }
@@ -544,7 +517,9 @@ bool Parsers::SearchList::Parse(libcomp::ManagerPacket *pPacketManager,
         reply.WriteS32Little(-1);
     }
 
-    connection->SendPacket(reply);
+    auto client = std::dynamic_pointer_cast<ChannelClientConnection>(
+        connection);
+    client->SendPacket(reply);
 
     return true;
 }
@@ -363,8 +363,14 @@ void HandleShopPurchase(const std::shared_ptr<ChannelServer> server,
 
         quantity = (int32_t)product->GetStack();
 
-        auto postItems = objects::PostItem::LoadPostItemListByAccount(
-            lobbyDB, targetCharacter->GetAccount());
+        // Always count from the database since gifts and distributions
+        // from other channels are not synced to the cached post index.
+        // Reload the index when buying for the player's own account.
+        bool selfPost = targetCharacter->GetAccount() ==
+            state->GetAccountUID();
+        auto postItems = selfPost ? state->GetPostItems(lobbyDB, true)
+            : objects::PostItem::LoadPostItemListByAccount(lobbyDB,
+                targetCharacter->GetAccount());
         if(((int32_t)postItems.size() + 1) >= MAX_POST_ITEM_COUNT)
         {
             SendShopPurchaseReply(client, shopID, productID, -1, false);
@@ -416,6 +422,11 @@ void HandleShopPurchase(const std::shared_ptr<ChannelServer> server,
         else
         {
             result = !gifteeName.IsEmpty() ? 2 : 1;
+
+            if(selfPost)
+            {
+                state->InvalidatePostItems();
+            }
             server->GetChannelSyncManager()->SyncRecordUpdate(account,
                 "Account");
 
@@ -117,8 +117,7 @@ void SendStateData(std::shared_ptr<ChannelServer> server,
 
     // Send pending post distribution messages
     std::list<std::shared_ptr<objects::PostItem>> distribute;
-    for(auto post : objects::PostItem::LoadPostItemListByAccount(server
-        ->GetLobbyDatabase(), state->GetAccountUID()))
+    for(auto post : state->GetPostItems(server->GetLobbyDatabase()))
     {
         if(post->GetDistributionMessageID())
         {
@@ -59,7 +59,7 @@ bool Parsers::Sync::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteU32Little(timeFromClient);
     reply.WriteFloat(currentClientTime);
 
-    connection->SendPacket(reply);
+    client->SendPacket(reply);
 
     return true;
 }
@@ -55,7 +55,9 @@ bool Parsers::WorldTime::Parse(libcomp::ManagerPacket *pPacketManager,
     reply.WriteS8(clock.Hour);
     reply.WriteS8(clock.Min);
 
-    connection->SendPacket(reply);
+    auto client = std::dynamic_pointer_cast<ChannelClientConnection>(
+        connection);
+    client->SendPacket(reply);
 
     return true;
 }
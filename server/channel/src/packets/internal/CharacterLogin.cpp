@@ -44,6 +44,7 @@
 
 // channel Includes
 #include "ChannelServer.h"
+#include "ChannelSyncManager.h"
 #include "ManagerConnection.h"
 #include "Zone.h"
 
@@ -95,6 +96,10 @@ bool Parsers::CharacterLogin::Parse(libcomp::ManagerPacket *pPacketManager,
         return false;
     }
 
+    // Any update can carry a new level or name
+    server->GetChannelSyncManager()->GetProfileCache()->Invalidate(
+        login->GetCharacter().GetUUID());
+
     auto member = std::make_shared<objects::PartyCharacter>();
     if(updateFlags & (uint8_t)CharacterLoginStateFlag_t::CHARLOGIN_PARTY_INFO &&
         !member->LoadPacket(p, true))
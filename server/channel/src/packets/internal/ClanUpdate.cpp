@@ -44,6 +44,7 @@
 
 // channel Includes
 #include "ChannelServer.h"
+#include "ChannelSyncManager.h"
 #include "CharacterManager.h"
 #include "ManagerConnection.h"
 #include "SkillManager.h"
@@ -141,6 +142,11 @@ bool Parsers::ClanUpdate::Parse(libcomp::ManagerPacket *pPacketManager,
             auto clan = !uid.IsNull() ? libcomp::PersistentObject::LoadObjectByUUID<
                 objects::Clan>(worldDB, uid, true) : nullptr;
 
+            // Membership, names and levels shown in the clan info may
+            // have changed
+            server->GetChannelSyncManager()->GetProfileCache()->Invalidate(
+                uid);
+
             bool nameUpdated = (updateFlags & 0x01) != 0;
             bool emblemUpdated = (updateFlags & 0x02) != 0;
             bool levelUpdated = (updateFlags & 0x04) != 0;
@@ -44,6 +44,7 @@ bool Parsers::DataSync::Parse(libcomp::ManagerPacket *pPacketManager,
 
     auto server = std::dynamic_pointer_cast<ChannelServer>(pPacketManager->GetServer());
     auto syncManager = server->GetChannelSyncManager();
+    syncManager->RecordIncoming(p.Size());
 
     if(!syncManager->SyncIncoming(p))
     {
@@ -41,6 +41,7 @@
 #include <WorldSharedConfig.h>
 
 // channel Includes
+#include "BazaarPriceIndex.h"
 #include "ChannelServer.h"
 #include "ChannelSyncManager.h"
 #include "ManagerConnection.h"
@@ -182,6 +183,9 @@ bool SetWorldInfoFromPacket(libcomp::ManagerPacket *pPacketManager,
         server->LoadAllRegisteredChannels();
     }
 
+    // Seed bazaar price suggestions from sales still on record
+    server->GetBazaarPriceIndex()->Rebuild();
+
     server->ServerReady();
 
     //Reply with the channel information
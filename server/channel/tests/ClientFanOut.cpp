@@ -0,0 +1,221 @@
+/**
+ * @file server/channel/tests/ClientFanOut.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Test queueing one packet for several client connections.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <PushIgnore.h>
+#include <gtest/gtest.h>
+#include <PopIgnore.h>
+
+// libcomp Includes
+#include <Packet.h>
+
+// channel Includes
+#include <ChannelClientConnection.h>
+#include <ChannelServer.h>
+
+// Standard C++11 Includes
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace channel;
+
+namespace
+{
+
+/// Number of clients in a crowded zone
+const size_t CLIENT_COUNT = 32;
+
+/// Number of threads queueing packets at the same time
+const size_t THREAD_COUNT = 8;
+
+/// Number of packets each thread queues for every client
+const size_t PACKET_COUNT = 200;
+
+/// Offset of the time written by the relative time test
+const uint32_t TIME_OFFSET = 6;
+
+typedef std::list<std::shared_ptr<ChannelClientConnection>> ClientList;
+
+/// Service the client sockets belong to, they are never connected
+asio::io_service gService;
+
+/// Create a list of client connections that only queue packets
+ClientList CreateClients(size_t count)
+{
+    ClientList clients;
+    for(size_t i = 0; i < count; i++)
+    {
+        asio::ip::tcp::socket socket(gService);
+        clients.push_back(std::make_shared<ChannelClientConnection>(socket,
+            nullptr));
+    }
+
+    return clients;
+}
+
+/// Write a packet shaped like a broadcast with a time to convert
+void Encode(libcomp::Packet& p, int32_t seed)
+{
+    p.WriteU16Little(0x1234);
+    p.WriteS32Little(seed);
+    p.WriteFloat(0.f);
+    for(int32_t i = 0; i < 100; i++)
+    {
+        p.WriteS32Little(seed + i);
+        p.WriteFloat((float)i * 10.f);
+    }
+}
+
+/**
+ * Copy counters of the connection class, used to check how many copies
+ * a call made.
+ */
+struct CopyCounts
+{
+    CopyCounts() : Copies(ChannelClientConnection::GetPacketCopyCount()),
+        Bytes(ChannelClientConnection::GetPacketCopyBytes()),
+        Avoided(ChannelClientConnection::GetPacketCopiesAvoided())
+    {
+    }
+
+    /// Packets copied so far
+    uint64_t Copies;
+
+    /// Packet bytes copied so far
+    uint64_t Bytes;
+
+    /// Copies avoided so far
+    uint64_t Avoided;
+};
+
+} // namespace
+
+TEST(ClientFanOut, QueueToAllCopiesForAllButOneClient)
+{
+    auto clients = CreateClients(CLIENT_COUNT);
+
+    libcomp::Packet p;
+    Encode(p, 7);
+    uint64_t size = (uint64_t)p.Size();
+
+    CopyCounts before;
+    ChannelClientConnection::QueuePacketToAll(clients, p);
+    CopyCounts after;
+
+    EXPECT_EQ(after.Copies - before.Copies, (uint64_t)CLIENT_COUNT - 1);
+    EXPECT_EQ(after.Bytes - before.Bytes, size * (CLIENT_COUNT - 1));
+    EXPECT_EQ(after.Avoided - before.Avoided, 1u);
+    EXPECT_GE(ChannelClientConnection::GetLargestFanOut(),
+        (uint64_t)CLIENT_COUNT);
+}
+
+TEST(ClientFanOut, QueueToOneClientMakesNoCopy)
+{
+    auto clients = CreateClients(1);
+
+    libcomp::Packet p;
+    Encode(p, 7);
+
+    CopyCounts before;
+    ChannelClientConnection::QueuePacketToAll(clients, p);
+    CopyCounts after;
+
+    EXPECT_EQ(after.Copies, before.Copies);
+    EXPECT_EQ(after.Avoided - before.Avoided, 1u);
+}
+
+TEST(ClientFanOut, RelativeTimeCopiesForAllButOneClient)
+{
+    auto clients = CreateClients(CLIENT_COUNT);
+
+    libcomp::Packet p;
+    Encode(p, 7);
+
+    RelativeTimeMap timeMap;
+    timeMap[TIME_OFFSET] = ChannelServer::GetServerTime();
+
+    CopyCounts before;
+    ChannelClientConnection::SendRelativeTimePacket(clients, p, timeMap,
+        true);
+    CopyCounts after;
+
+    EXPECT_EQ(after.Copies - before.Copies, (uint64_t)CLIENT_COUNT - 1);
+    EXPECT_EQ(after.Avoided - before.Avoided, 1u);
+}
+
+TEST(ClientFanOut, ConcurrentQueueToAll)
+{
+    // Worker threads broadcast to the same zone at the same time so
+    // every connection is queued to from several threads at once
+    auto clients = CreateClients(CLIENT_COUNT);
+
+    CopyCounts before;
+
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < THREAD_COUNT; i++)
+    {
+        threads.push_back(std::thread([&clients, i]()
+        {
+            for(size_t n = 0; n < PACKET_COUNT; n++)
+            {
+                libcomp::Packet p;
+                Encode(p, (int32_t)(i * PACKET_COUNT + n));
+
+                if(n % 2)
+                {
+                    ChannelClientConnection::QueuePacketToAll(clients, p);
+                }
+                else
+                {
+                    RelativeTimeMap timeMap;
+                    timeMap[TIME_OFFSET] = ChannelServer::GetServerTime();
+
+                    ChannelClientConnection::SendRelativeTimePacket(clients,
+                        p, timeMap, true);
+                }
+            }
+        }));
+    }
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CopyCounts after;
+
+    uint64_t broadcasts = (uint64_t)(THREAD_COUNT * PACKET_COUNT);
+    EXPECT_EQ(after.Copies - before.Copies,
+        broadcasts * (CLIENT_COUNT - 1));
+    EXPECT_EQ(after.Avoided - before.Avoided, broadcasts);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
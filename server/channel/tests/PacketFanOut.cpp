@@ -0,0 +1,267 @@
+/**
+ * @file server/channel/tests/PacketFanOut.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Test handing one packet to several clients.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <PushIgnore.h>
+#include <gtest/gtest.h>
+#include <PopIgnore.h>
+
+// channel Includes
+#include <PacketFanOut.h>
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace channel;
+
+namespace
+{
+
+/// Number of clients in a crowded zone
+const size_t CLIENT_COUNT = 32;
+
+/// Number of threads fanning out packets at the same time
+const size_t THREAD_COUNT = 4;
+
+/// Offset of the per-client value written by the relative time test
+const uint32_t CLIENT_VALUE_OFFSET = 6;
+
+/**
+ * Client that keeps what it is handed the way a connection queues a
+ * packet, by taking the packet data.
+ */
+struct TestClient
+{
+    /// Take a packet handed to the client
+    void QueuePacket(libcomp::Packet& packet, bool copy)
+    {
+        Queued.push_back(std::move(packet));
+        Copies.push_back(copy);
+    }
+
+    /// Packets queued for the client
+    std::vector<libcomp::Packet> Queued;
+
+    /// true for each queued packet that was a copy
+    std::vector<bool> Copies;
+};
+
+typedef std::list<std::shared_ptr<TestClient>> ClientList;
+
+/// Create a list of clients
+ClientList CreateClients(size_t count)
+{
+    ClientList clients;
+    for(size_t i = 0; i < count; i++)
+    {
+        clients.push_back(std::make_shared<TestClient>());
+    }
+
+    return clients;
+}
+
+/// Write a packet shaped like a broadcast with a time to convert
+void Encode(libcomp::Packet& p, int32_t seed)
+{
+    p.WriteU16Little(0x1234);
+    p.WriteS32Little(seed);
+    p.WriteFloat(0.f);
+    for(int32_t i = 0; i < 100; i++)
+    {
+        p.WriteS32Little(seed + i);
+        p.WriteFloat((float)i * 10.f);
+    }
+}
+
+/// Get every byte of a packet
+std::vector<char> Payload(libcomp::Packet& p)
+{
+    p.Seek(0);
+
+    return p.ReadArray(p.Size());
+}
+
+/// Queue a packet for every client the way QueuePacketToAll does
+void QueueToAll(const ClientList& clients, libcomp::Packet& packet)
+{
+    FanOutPacket(clients, packet, [](const std::shared_ptr<TestClient>& client,
+        libcomp::Packet& p, bool copy)
+    {
+        client->QueuePacket(p, copy);
+    });
+}
+
+} // namespace
+
+TEST(PacketFanOut, EveryClientReceivesIdenticalPayload)
+{
+    auto clients = CreateClients(CLIENT_COUNT);
+
+    libcomp::Packet p;
+    Encode(p, 1);
+    auto expected = Payload(p);
+
+    QueueToAll(clients, p);
+
+    size_t index = 0;
+    for(auto client : clients)
+    {
+        ASSERT_EQ(client->Queued.size(), 1u) << "Client " << index;
+        EXPECT_EQ(Payload(client->Queued.front()), expected)
+            << "Client " << index;
+
+        // Only the last client takes the packet without a copy
+        EXPECT_EQ(client->Copies.front(), index + 1 < CLIENT_COUNT)
+            << "Client " << index;
+
+        index++;
+    }
+}
+
+TEST(PacketFanOut, LastClientTakingPacketKeepsEarlierCopies)
+{
+    auto clients = CreateClients(CLIENT_COUNT);
+
+    libcomp::Packet p;
+    Encode(p, 2);
+    auto expected = Payload(p);
+
+    QueueToAll(clients, p);
+
+    // Change the packet data the last client took
+    auto& taken = clients.back()->Queued.front();
+    taken.Seek(0);
+    taken.WriteU16Little(0xFFFF);
+    taken.WriteS32Little(-1);
+    taken.WriteFloat(1.f);
+
+    for(auto client : clients)
+    {
+        if(client != clients.back())
+        {
+            EXPECT_EQ(Payload(client->Queued.front()), expected);
+        }
+    }
+}
+
+TEST(PacketFanOut, PerClientChangesStayWithTheClient)
+{
+    auto clients = CreateClients(CLIENT_COUNT);
+
+    libcomp::Packet p;
+    Encode(p, 3);
+    auto expected = Payload(p);
+
+    // Write a different value for each client the way relative times are
+    // written before sending
+    float value = 0.f;
+    FanOutPacket(clients, p, [&value](const std::shared_ptr<TestClient>&
+        client, libcomp::Packet& cp, bool copy)
+    {
+        cp.Seek(CLIENT_VALUE_OFFSET);
+        cp.WriteFloat(value);
+        value += 1.f;
+
+        client->QueuePacket(cp, copy);
+    });
+
+    value = 0.f;
+    for(auto client : clients)
+    {
+        ASSERT_EQ(client->Queued.size(), 1u);
+
+        auto& queued = client->Queued.front();
+        queued.Seek(CLIENT_VALUE_OFFSET);
+        EXPECT_EQ(queued.ReadFloat(), value);
+
+        // Everything else is untouched
+        auto payload = Payload(queued);
+        ASSERT_EQ(payload.size(), expected.size());
+        EXPECT_TRUE(std::equal(payload.begin(), payload.begin() +
+            CLIENT_VALUE_OFFSET, expected.begin()));
+        EXPECT_TRUE(std::equal(payload.begin() + CLIENT_VALUE_OFFSET + 4,
+            payload.end(), expected.begin() + CLIENT_VALUE_OFFSET + 4));
+
+        value += 1.f;
+    }
+}
+
+TEST(PacketFanOut, ConcurrentFanOuts)
+{
+    // Worker threads broadcast at the same time in a busy channel so
+    // copies and moves on one thread must not affect another
+    std::vector<ClientList> clients;
+    std::vector<std::vector<char>> expected(THREAD_COUNT);
+    for(size_t i = 0; i < THREAD_COUNT; i++)
+    {
+        clients.push_back(CreateClients(CLIENT_COUNT));
+    }
+
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < THREAD_COUNT; i++)
+    {
+        threads.push_back(std::thread([&clients, &expected, i]()
+        {
+            for(int32_t n = 0; n < 50; n++)
+            {
+                libcomp::Packet p;
+                Encode(p, (int32_t)i * 1000);
+                if(n == 0)
+                {
+                    expected[i] = Payload(p);
+                }
+
+                QueueToAll(clients[i], p);
+            }
+        }));
+    }
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(size_t i = 0; i < THREAD_COUNT; i++)
+    {
+        for(auto client : clients[i])
+        {
+            ASSERT_EQ(client->Queued.size(), 50u);
+            for(auto& queued : client->Queued)
+            {
+                EXPECT_EQ(Payload(queued), expected[i]) << "Thread " << i;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
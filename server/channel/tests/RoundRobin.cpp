@@ -0,0 +1,168 @@
+/**
+ * @file server/channel/tests/RoundRobin.cpp
+ * @ingroup channel
+ *
+ * @author HACKfrost
+ *
+ * @brief Test the round-robin order used for budgeted AI updates.
+ *
+ * This file is part of the Channel Server (channel).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <PushIgnore.h>
+#include <gtest/gtest.h>
+#include <PopIgnore.h>
+
+// channel Includes
+#include <RoundRobin.h>
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace channel;
+
+namespace
+{
+
+/// Run one budgeted pass the same way AIManager::UpdateActiveStates does,
+/// updating at most budget entities and tracking where the pass stopped
+std::vector<int32_t> RunPass(std::list<int32_t> entities, int32_t& resumeID,
+    size_t budget)
+{
+    OrderRoundRobin(entities, resumeID, [](int32_t entityID)
+        {
+            return entityID;
+        });
+
+    std::vector<int32_t> updated;
+    int32_t lastUpdatedID = resumeID;
+    bool ranOut = false;
+
+    for(int32_t entityID : entities)
+    {
+        if(updated.size() >= budget)
+        {
+            ranOut = true;
+            break;
+        }
+
+        updated.push_back(entityID);
+        lastUpdatedID = entityID;
+    }
+
+    resumeID = ranOut ? lastUpdatedID : 0;
+
+    return updated;
+}
+
+} // namespace
+
+TEST(RoundRobin, EveryEntityUpdatedEvenly)
+{
+    std::list<int32_t> entities;
+    for(int32_t entityID = 1; entityID <= 10; entityID++)
+    {
+        entities.push_back(entityID);
+    }
+
+    std::map<int32_t, int32_t> counts;
+    std::map<int32_t, int32_t> lastTick;
+    int32_t longestWait = 0;
+
+    int32_t resumeID = 0;
+    for(int32_t tick = 0; tick < 30; tick++)
+    {
+        for(int32_t entityID : RunPass(entities, resumeID, 3))
+        {
+            counts[entityID]++;
+
+            int32_t wait = tick - (lastTick.find(entityID) != lastTick.end()
+                ? lastTick[entityID] : -1);
+            longestWait = std::max(longestWait, wait);
+            lastTick[entityID] = tick;
+        }
+    }
+
+    // 90 updates shared by 10 entities
+    ASSERT_EQ(counts.size(), 10u);
+    for(auto& pair : counts)
+    {
+        EXPECT_EQ(pair.second, 9) << "Entity " << pair.first;
+    }
+
+    // Nobody waits longer than it takes to get through everyone once
+    EXPECT_LE(longestWait, 4);
+}
+
+TEST(RoundRobin, UnsortedEntitiesUseEntityIDOrder)
+{
+    // Enemies come before allies so the list is not sorted
+    std::list<int32_t> entities = { 5, 7, 9, 6, 8 };
+
+    int32_t resumeID = 6;
+    auto updated = RunPass(entities, resumeID, 10);
+
+    EXPECT_EQ(updated, std::vector<int32_t>({ 7, 8, 9, 5, 6 }));
+    EXPECT_EQ(resumeID, 0);
+}
+
+TEST(RoundRobin, ResumeAfterRemovedEntity)
+{
+    std::list<int32_t> entities = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    int32_t resumeID = 0;
+    EXPECT_EQ(RunPass(entities, resumeID, 3),
+        std::vector<int32_t>({ 1, 2, 3 }));
+    EXPECT_EQ(resumeID, 3);
+
+    // The entity the pass stopped at is removed
+    entities.remove(3);
+
+    EXPECT_EQ(RunPass(entities, resumeID, 3),
+        std::vector<int32_t>({ 4, 5, 6 }));
+    EXPECT_EQ(resumeID, 6);
+
+    // The entity the next pass would start with is removed too
+    entities.remove(6);
+    entities.remove(7);
+
+    EXPECT_EQ(RunPass(entities, resumeID, 3),
+        std::vector<int32_t>({ 8, 1, 2 }));
+    EXPECT_EQ(resumeID, 2);
+}
+
+TEST(RoundRobin, ResumeWrapsAfterRemovedLastEntity)
+{
+    std::list<int32_t> entities = { 1, 2, 3, 4 };
+
+    int32_t resumeID = 4;
+    entities.remove(4);
+
+    EXPECT_EQ(RunPass(entities, resumeID, 2),
+        std::vector<int32_t>({ 1, 2 }));
+    EXPECT_EQ(resumeID, 2);
+}
+
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
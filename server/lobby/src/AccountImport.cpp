@@ -0,0 +1,419 @@
+/**
+ * @file server/lobby/src/AccountImport.cpp
+ * @ingroup lobby
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Incremental parser for account import data.
+ *
+ * This file is part of the Lobby Server (lobby).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AccountImport.h"
+
+// libcomp Includes
+#include <DatabaseChangeSet.h>
+#include <Log.h>
+#include <PersistentObject.h>
+
+// Object Includes
+#include "LobbyConfig.h"
+
+// Standard C++11 Includes
+#include <cctype>
+#include <cstring>
+
+// tinyxml2 Includes
+#include <tinyxml2.h>
+
+// lobby Includes
+#include "LobbyServer.h"
+#include "World.h"
+
+using namespace lobby;
+
+// Size of the buffer decompressed data is written to before parsing
+#define INFLATE_BUFFER_SIZE (16 * 1024)
+
+AccountImport::AccountImport(LobbyServer *server, uint8_t worldID) :
+    mServer(server), mScanOffset(0), mObjectStart(0), mDepth(0),
+    mReceived(0), mParsed(0), mCompressed(false)
+{
+    std::memset(&mStream, 0, sizeof(mStream));
+
+    mLobbyDB = server->GetMainDatabase();
+
+    auto world = server->GetWorldByID(worldID);
+
+    if(world)
+    {
+        mWorldDB = world->GetWorldDatabase();
+    }
+
+    if(!mLobbyDB || !mWorldDB)
+    {
+        mError = "Failed to connect to database.";
+    }
+}
+
+AccountImport::~AccountImport()
+{
+    if(mCompressed)
+    {
+        inflateEnd(&mStream);
+    }
+}
+
+bool AccountImport::Feed(const char *pData, size_t size)
+{
+    if(!mError.IsEmpty())
+    {
+        return false;
+    }
+
+    std::string header;
+
+    if(2 > mReceived)
+    {
+        // Wait for enough data to check for the gzip magic.
+        mPending.append(pData, size);
+        mReceived += size;
+
+        if(2 > mReceived)
+        {
+            return true;
+        }
+
+        header.swap(mPending);
+        pData = header.c_str();
+        size = header.size();
+
+        mCompressed = 0x1F == (uint8_t)header[0] &&
+            0x8B == (uint8_t)header[1];
+
+        // Add 16 to the window bits to only accept a gzip header.
+        if(mCompressed && Z_OK != inflateInit2(&mStream, 16 + MAX_WBITS))
+        {
+            mCompressed = false;
+            mError = "Failed to decompress account data.";
+
+            return false;
+        }
+    }
+    else
+    {
+        mReceived += size;
+    }
+
+    if(!mCompressed)
+    {
+        return Parse(pData, size);
+    }
+
+    char out[INFLATE_BUFFER_SIZE];
+
+    mStream.next_in = (Bytef*)pData;
+    mStream.avail_in = (uInt)size;
+
+    do
+    {
+        mStream.next_out = (Bytef*)out;
+        mStream.avail_out = (uInt)sizeof(out);
+
+        int result = inflate(&mStream, Z_NO_FLUSH);
+
+        if(Z_OK != result && Z_STREAM_END != result && Z_BUF_ERROR != result)
+        {
+            mError = "Failed to decompress account data.";
+
+            return false;
+        }
+
+        if(!Parse(out, sizeof(out) - mStream.avail_out))
+        {
+            return false;
+        }
+
+        if(Z_OK != result)
+        {
+            break;
+        }
+    } while(0 < mStream.avail_in || 0 == mStream.avail_out);
+
+    return true;
+}
+
+libcomp::String AccountImport::Finish()
+{
+    if(!mError.IsEmpty())
+    {
+        return mError;
+    }
+
+    if(0 != mDepth || (mLobbyObjects.empty() && mWorldObjects.empty()))
+    {
+        return "Failed to parse account data.";
+    }
+
+    for(auto pair : mLobbyObjects)
+    {
+        if(!pair.second->Register(pair.second, pair.first))
+        {
+            return "Failed to register an object.";
+        }
+    }
+
+    for(auto pair : mWorldObjects)
+    {
+        if(!pair.second->Register(pair.second, pair.first))
+        {
+            return "Failed to register an object.";
+        }
+    }
+
+    auto lobbyChangeSet = libcomp::DatabaseChangeSet::Create();
+
+    for(auto pair : mLobbyObjects)
+    {
+        lobbyChangeSet->Insert(pair.second);
+    }
+
+    if(!mLobbyDB->ProcessChangeSet(lobbyChangeSet))
+    {
+        LogGeneralError([&]()
+        {
+            return libcomp::String("Import failed with lobby database error: "
+                "%1\n").Arg(mLobbyDB->GetLastError());
+        });
+
+        return "Failed to write account into database.";
+    }
+
+    auto worldChangeSet = libcomp::DatabaseChangeSet::Create();
+
+    for(auto pair : mWorldObjects)
+    {
+        worldChangeSet->Insert(pair.second);
+    }
+
+    if(!mWorldDB->ProcessChangeSet(worldChangeSet))
+    {
+        LogGeneralError([&]()
+        {
+            return libcomp::String("Import failed with world database error: "
+                "%1\n").Arg(mWorldDB->GetLastError());
+        });
+
+        return "Failed to write account into database.";
+    }
+
+    return {};
+}
+
+libcomp::String AccountImport::GetError() const
+{
+    return mError;
+}
+
+bool AccountImport::Parse(const char *pData, size_t size)
+{
+    auto conf = std::dynamic_pointer_cast<objects::LobbyConfig>(
+        mServer->GetConfig());
+
+    // Compressed data is held to the same limit once decompressed.
+    mParsed += size;
+
+    if((size_t)(conf->GetImportMaxPayload() * 1024) < mParsed)
+    {
+        mError = "Account data is too large.";
+
+        return false;
+    }
+
+    mPending.append(pData, size);
+
+    while(mScanOffset < mPending.size())
+    {
+        size_t tag = mPending.find('<', mScanOffset);
+
+        if(std::string::npos == tag)
+        {
+            mScanOffset = mPending.size();
+
+            break;
+        }
+
+        // Wait for enough data to tell which tag this is.
+        if(strlen("</object>") > (mPending.size() - tag))
+        {
+            mScanOffset = tag;
+
+            break;
+        }
+
+        if(0 == mPending.compare(tag, strlen("<object"), "<object") &&
+            ('>' == mPending[tag + strlen("<object")] ||
+            std::isspace((uint8_t)mPending[tag + strlen("<object")])))
+        {
+            if(0 == mDepth)
+            {
+                mObjectStart = tag;
+            }
+
+            mDepth++;
+            mScanOffset = tag + strlen("<object");
+        }
+        else if(0 == mPending.compare(tag, strlen("</object>"), "</object>"))
+        {
+            size_t end = tag + strlen("</object>");
+
+            if(0 == mDepth)
+            {
+                mError = "Failed to parse account data.";
+
+                return false;
+            }
+            else if(0 == --mDepth)
+            {
+                if(!ImportObject(mPending.substr(mObjectStart,
+                    end - mObjectStart)))
+                {
+                    return false;
+                }
+
+                // Drop the object now that it has been loaded.
+                mPending.erase(0, end);
+                end = 0;
+            }
+
+            mScanOffset = end;
+        }
+        else
+        {
+            mScanOffset = tag + 1;
+        }
+    }
+
+    // Anything scanned outside of an object is not needed any more.
+    if(0 == mDepth && 0 < mScanOffset)
+    {
+        mPending.erase(0, mScanOffset);
+        mScanOffset = 0;
+    }
+
+    return true;
+}
+
+bool AccountImport::ImportObject(const std::string& xml)
+{
+    tinyxml2::XMLDocument doc;
+
+    if(tinyxml2::XML_SUCCESS != doc.Parse(xml.c_str(), xml.size()))
+    {
+        mError = "Failed to parse account data.";
+
+        return false;
+    }
+
+    const tinyxml2::XMLElement *pImportObject = doc.RootElement();
+
+    const char *szObjectType = pImportObject->Attribute("name");
+    std::string objectType(szObjectType ? szObjectType : "");
+
+    auto typeExists = false;
+    auto typeHash = libcomp::PersistentObject::GetTypeHashByName(
+        objectType, typeExists);
+
+    if(!typeExists)
+    {
+        mError = libcomp::String("Failed to parse unknown "
+            "object '%1'.").Arg(objectType);
+
+        return false;
+    }
+
+    // Grab the UUID for the object.
+    std::string uuidText;
+    libobjgen::UUID uuid;
+
+    const tinyxml2::XMLElement *pMember =
+        pImportObject->FirstChildElement("member");
+
+    while(nullptr != pMember)
+    {
+        if("uuid" == libcomp::String(pMember->Attribute(
+            "name")).ToLower())
+        {
+            uuidText = pMember->GetText();
+            uuid = libobjgen::UUID(uuidText);
+
+            break;
+        }
+
+        pMember = pMember->NextSiblingElement("member");
+    }
+
+    // Make sure every object has a UUID.
+    if(uuid.IsNull())
+    {
+        mError = libcomp::String("Bad UUID '%1' for object "
+            "'%2'").Arg(uuidText).Arg(objectType);
+
+        return false;
+    }
+
+    auto obj = libcomp::PersistentObject::New(typeHash);
+
+    if(!obj || !obj->Load(doc, *pImportObject))
+    {
+        mError = libcomp::String("Failed to load object '%1' with "
+            "UUID %2.").Arg(objectType).Arg(uuid.ToString());
+
+        return false;
+    }
+
+    std::shared_ptr<libcomp::Database> db;
+
+    if("Account" == objectType)
+    {
+        db = mLobbyDB;
+
+        mLobbyObjects.push_back(std::make_pair(uuid, obj));
+    }
+    else
+    {
+        db = mWorldDB;
+
+        mWorldObjects.push_back(std::make_pair(uuid, obj));
+    }
+
+    auto existingObject = libcomp::PersistentObject::LoadObjectByUUID(
+        typeHash, db, uuid);
+
+    if(existingObject)
+    {
+        mError = libcomp::String("Object with UUID '%1' already exists "
+            "in database.").Arg(uuid.ToString());
+
+        return false;
+    }
+
+    mError = mServer->CheckImportObject(objectType, obj, mLobbyDB, mWorldDB);
+
+    return mError.IsEmpty();
+}
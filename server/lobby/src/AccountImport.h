@@ -0,0 +1,153 @@
+/**
+ * @file server/lobby/src/AccountImport.h
+ * @ingroup lobby
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Incremental parser for account import data.
+ *
+ * This file is part of the Lobby Server (lobby).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_LOBBY_SRC_ACCOUNTIMPORT_H
+#define SERVER_LOBBY_SRC_ACCOUNTIMPORT_H
+
+// libcomp Includes
+#include <CString.h>
+#include <Database.h>
+
+// Standard C++11 Includes
+#include <list>
+#include <memory>
+#include <string>
+
+// zlib Includes
+#include <zlib.h>
+
+namespace lobby
+{
+
+class LobbyServer;
+
+/**
+ * Imports an account dump that is supplied a piece at a time. Each
+ * <object> element is parsed and checked as soon as it has been fully
+ * received so the dump is never held in memory as a whole. Dumps may
+ * optionally be gzip compressed. Nothing is written to the databases
+ * until @ref Finish is called and every object has been accepted.
+ */
+class AccountImport
+{
+public:
+    /**
+     * Create a new account import.
+     * @param server Pointer to the lobby server.
+     * @param worldID ID of the world to import the characters into.
+     */
+    AccountImport(LobbyServer *server, uint8_t worldID = 0);
+
+    /**
+     * Clean up the import.
+     */
+    ~AccountImport();
+
+    /**
+     * Supply the next piece of the account dump.
+     * @param pData Pointer to the data.
+     * @param size Size of the data in bytes.
+     * @returns false if the import has failed, see @ref GetError.
+     */
+    bool Feed(const char *pData, size_t size);
+
+    /**
+     * Write every imported object to the databases once the entire dump
+     * has been supplied.
+     * @returns Error string or an empty string on success.
+     */
+    libcomp::String Finish();
+
+    /**
+     * Get the reason the import failed.
+     * @returns Error string or an empty string if no error occurred.
+     */
+    libcomp::String GetError() const;
+
+private:
+    /**
+     * Split uncompressed dump data into complete <object> elements.
+     * @param pData Pointer to the data.
+     * @param size Size of the data in bytes.
+     * @returns false if the import has failed.
+     */
+    bool Parse(const char *pData, size_t size);
+
+    /**
+     * Load and check a single object from the dump.
+     * @param xml Text of the <object> element.
+     * @returns false if the object can not be imported.
+     */
+    bool ImportObject(const std::string& xml);
+
+    /// Pointer to the lobby server.
+    LobbyServer *mServer;
+
+    /// Lobby database to import the account into.
+    std::shared_ptr<libcomp::Database> mLobbyDB;
+
+    /// World database to import the characters into.
+    std::shared_ptr<libcomp::Database> mWorldDB;
+
+    /// Objects to insert into the lobby database.
+    std::list<std::pair<libobjgen::UUID,
+        std::shared_ptr<libcomp::PersistentObject>>> mLobbyObjects;
+
+    /// Objects to insert into the world database.
+    std::list<std::pair<libobjgen::UUID,
+        std::shared_ptr<libcomp::PersistentObject>>> mWorldObjects;
+
+    /// Data received that does not yet form a complete object.
+    std::string mPending;
+
+    /// Offset in mPending to continue scanning for tags from.
+    size_t mScanOffset;
+
+    /// Offset in mPending the current top level object starts at.
+    size_t mObjectStart;
+
+    /// Depth of nested <object> elements at the scan offset.
+    int mDepth;
+
+    /// Number of bytes received so far.
+    size_t mReceived;
+
+    /// Number of uncompressed bytes parsed so far.
+    size_t mParsed;
+
+    /// State of the gzip decompression.
+    z_stream mStream;
+
+    /// true if the dump is gzip compressed.
+    bool mCompressed;
+
+    /// Reason the import failed.
+    libcomp::String mError;
+};
+
+} // namespace lobby
+
+#endif // SERVER_LOBBY_SRC_ACCOUNTIMPORT_H
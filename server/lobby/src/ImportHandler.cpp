@@ -32,11 +32,18 @@
 // object Includes
 #include <Character.h>
 
+// Standard C++11 Includes
+#include <algorithm>
+
 // lobby Includes
+#include "AccountImport.h"
 #include "World.h"
 
 using namespace lobby;
 
+// Size of each read of the POST data
+#define READ_BUFFER_SIZE (16 * 1024)
+
 ImportHandler::ImportHandler(
     const std::shared_ptr<objects::LobbyConfig>& config,
     const std::shared_ptr<lobby::LobbyServer>& server) :
@@ -101,16 +108,6 @@ bool ImportHandler::handlePost(CivetServer *pServer,
         return true;
     }
 
-    // Allocate.
-    char *szPostData = new char[postContentLength + 1];
-
-    // Read the post data.
-    postContentLength = static_cast<size_t>(mg_read(
-        pConnection, szPostData, postContentLength));
-    szPostData[postContentLength] = 0;
-
-    libcomp::String importError;
-
     const char *szContentType = mg_get_header(pConnection, "Content-Type");
 
     if(!szContentType)
@@ -121,26 +118,23 @@ bool ImportHandler::handlePost(CivetServer *pServer,
         return true;
     }
 
-    // Extract the file from the POST data.
-    libcomp::String importData = ExtractFile(szContentType, szPostData);
-
-    delete[] szPostData;
+    libcomp::String importError;
 
-    // Import the account and collect the error.
+    // Import the account as the file is read and collect the error.
     if(mServer)
     {
-        if( !importData.IsEmpty() )
-        {
-            importError = mServer->ImportAccount(importData,
-                mConfig->GetImportWorld());
-        }
-        else
+        AccountImport import(mServer.get(), mConfig->GetImportWorld());
+
+        if(!ExtractFile(pConnection, szContentType, postContentLength,
+            import))
         {
             mg_printf(pConnection, "HTTP/1.1 400 Bad Request\r\n"
                 "Connection: close\r\n\r\n");
 
             return true;
         }
+
+        importError = import.Finish();
     }
     else
     {
@@ -174,12 +168,11 @@ bool ImportHandler::handlePost(CivetServer *pServer,
     return true;
 }
 
-libcomp::String ImportHandler::ExtractFile(const libcomp::String& contentType,
-    const libcomp::String& contentData)
+bool ImportHandler::ExtractFile(struct mg_connection *pConnection,
+    const libcomp::String& contentType, size_t contentLength,
+    AccountImport& import)
 {
-    libcomp::String boundary;
-
-    auto data = libcomp::String("\r\n") + contentData;
+    std::string delimiter;
 
     for(auto _s : contentType.Split(";"))
     {
@@ -187,57 +180,145 @@ libcomp::String ImportHandler::ExtractFile(const libcomp::String& contentType,
 
         if("boundary=" == s.Left(strlen("boundary=")))
         {
-            // Grab the boundary value.
-            boundary = s.Mid(strlen("boundary="));
-
-            // Remove the end boundary.
-            data = data.LeftOf(libcomp::String("\r\n--%1--\r\n").Arg(boundary));
-
             // Save out the proper boundary.
-            boundary = libcomp::String("\r\n--%1\r\n").Arg(
-                boundary);
-
-            // Put back a normal boundary at the end.
-            data += boundary;
+            delimiter = libcomp::String("\r\n--%1").Arg(
+                s.Mid(strlen("boundary="))).ToUtf8();
 
             break;
         }
     }
 
-    if(boundary.IsEmpty())
+    if(delimiter.empty())
     {
-        return {};
+        return false;
     }
 
-    while(!data.IsEmpty())
+    enum class PartState_t
+    {
+        SKIP,
+        HEADERS,
+        FILE,
+    };
+
+    // Start with a line break so the first boundary matches as well.
+    std::string data = "\r\n";
+    PartState_t state = PartState_t::SKIP;
+    bool found = false;
+
+    char buffer[READ_BUFFER_SIZE];
+
+    // Parse each part of the multi-part form as it is read and pass the
+    // first file along without holding the entire request in memory.
+    while(true)
     {
-        // Parse each part of the multi-part form.
-        auto part = data.LeftOf(boundary);
-        auto headers = part.LeftOf("\r\n\r\n").Split("\r\n");
-        part = part.RightOf("\r\n\r\n");
+        bool partEnded = true;
 
-        // Look in the headers to see if this is a file.
-        for(auto header : headers)
+        while(partEnded)
         {
-            if("Content-Disposition:" ==
-                header.Left(strlen("Content-Disposition:")))
+            partEnded = false;
+
+            if(PartState_t::HEADERS == state)
             {
-                for(auto keyValuePair : header.RightOf(
-                    "Content-Disposition:").Split(";"))
+                // The final boundary is followed by two dashes.
+                if(2 <= data.size() && "--" == data.substr(0, 2))
                 {
-                    auto pair = keyValuePair.Trimmed().Split("=");
+                    return found;
+                }
 
-                    // If this is the first file return the data.
-                    if(!pair.empty() && "filename" == pair.front())
+                size_t headersEnd = data.find("\r\n\r\n");
+
+                if(std::string::npos == headersEnd)
+                {
+                    break;
+                }
+
+                auto headers = libcomp::String(data.substr(0, headersEnd)
+                    ).Split("\r\n");
+                data.erase(0, headersEnd + strlen("\r\n\r\n"));
+
+                state = PartState_t::SKIP;
+                partEnded = true;
+
+                // Look in the headers to see if this is a file.
+                for(auto header : headers)
+                {
+                    if("Content-Disposition:" ==
+                        header.Left(strlen("Content-Disposition:")))
                     {
-                        return part;
+                        for(auto keyValuePair : header.RightOf(
+                            "Content-Disposition:").Split(";"))
+                        {
+                            auto pair = keyValuePair.Trimmed().Split("=");
+
+                            // Only the first file is imported.
+                            if(!found && !pair.empty() &&
+                                "filename" == pair.front())
+                            {
+                                state = PartState_t::FILE;
+                                found = true;
+                            }
+                        }
                     }
                 }
+
+                continue;
             }
+
+            size_t partEnd = data.find(delimiter);
+
+            if(std::string::npos == partEnd)
+            {
+                // Keep enough to match a boundary split between reads.
+                if(data.size() >= delimiter.size())
+                {
+                    size_t partSize = data.size() - delimiter.size() + 1;
+
+                    if(PartState_t::FILE == state && !import.Feed(
+                        data.c_str(), partSize))
+                    {
+                        return true;
+                    }
+
+                    data.erase(0, partSize);
+                }
+
+                break;
+            }
+
+            if(PartState_t::FILE == state)
+            {
+                import.Feed(data.c_str(), partEnd);
+
+                return true;
+            }
+
+            data.erase(0, partEnd + delimiter.size());
+            state = PartState_t::HEADERS;
+            partEnded = true;
+        }
+
+        if(0 == contentLength)
+        {
+            break;
+        }
+
+        int readSize = mg_read(pConnection, buffer,
+            std::min(contentLength, sizeof(buffer)));
+
+        if(0 >= readSize)
+        {
+            break;
         }
 
-        data = data.RightOf(boundary);
+        contentLength -= (size_t)readSize;
+        data.append(buffer, (size_t)readSize);
+    }
+
+    // The request ended without a final boundary.
+    if(PartState_t::FILE == state)
+    {
+        import.Feed(data.c_str(), data.size());
     }
 
-    return {};
+    return found;
 }
@@ -44,6 +44,8 @@
 namespace lobby
 {
 
+class AccountImport;
+
 class ImportHandler : public CivetHandler
 {
 public:
@@ -56,8 +58,9 @@ public:
         struct mg_connection *pConnection);
 
 private:
-    libcomp::String ExtractFile(const libcomp::String& contentType,
-        const libcomp::String& contentData);
+    bool ExtractFile(struct mg_connection *pConnection,
+        const libcomp::String& contentType, size_t contentLength,
+        AccountImport& import);
 
     std::shared_ptr<objects::LobbyConfig> mConfig;
     std::shared_ptr<lobby::LobbyServer> mServer;
@@ -43,6 +43,7 @@
 #include <iostream>
 
 // lobby Includes
+#include "AccountImport.h"
 #include "AccountManager.h"
 #include "LobbyClientConnection.h"
 #include "LobbySyncManager.h"
@@ -603,182 +604,16 @@ libcomp::String LobbyServer::GetFakeAccountSalt(
 libcomp::String LobbyServer::ImportAccount(const libcomp::String& data,
     uint8_t worldID)
 {
-    tinyxml2::XMLDocument doc;
+    AccountImport import(this, worldID);
 
-    if(tinyxml2::XML_SUCCESS != doc.Parse(data.C()))
-    {
-        return "Failed to parse account data.";
-    }
-
-    const tinyxml2::XMLElement *pImportObject = doc.RootElement(
-        )->FirstChildElement("object");
-
-    std::shared_ptr<libcomp::Database> lobbyDB, worldDB;
-
-    {
-        lobbyDB = GetMainDatabase();
-
-        auto world = GetWorldByID(worldID);
-
-        if(world)
-        {
-            worldDB = world->GetWorldDatabase();
-        }
-    }
-
-    if(!lobbyDB || !worldDB)
-    {
-        return "Failed to connect to database.";
-    }
-
-    std::list<std::pair<libobjgen::UUID,
-        std::shared_ptr<libcomp::PersistentObject>>> lobbyObjects;
-    std::list<std::pair<libobjgen::UUID,
-        std::shared_ptr<libcomp::PersistentObject>>> worldObjects;
-
-    while(nullptr != pImportObject)
-    {
-        std::string objectType(pImportObject->Attribute("name"));
-
-        auto typeExists = false;
-        auto typeHash = libcomp::PersistentObject::GetTypeHashByName(
-            objectType, typeExists);
-
-        if(!typeExists)
-        {
-            return libcomp::String("Failed to parse unknown "
-                "object '%1'.").Arg(objectType);
-        }
-
-        // Grab the UUID for the object.
-        std::string uuidText;
-        libobjgen::UUID uuid;
-
-        const tinyxml2::XMLElement *pMember =
-            pImportObject->FirstChildElement("member");
-
-        while(nullptr != pMember)
-        {
-            if("uuid" == libcomp::String(pMember->Attribute(
-                "name")).ToLower())
-            {
-                uuidText = pMember->GetText();
-                uuid = libobjgen::UUID(uuidText);
-
-                break;
-            }
-
-            pMember = pMember->NextSiblingElement("member");
-        }
-
-        // Make sure every object has a UUID.
-        if(uuid.IsNull())
-        {
-            return libcomp::String("Bad UUID '%1' for object "
-                "'%2'").Arg(uuidText).Arg(objectType);
-        }
-
-        auto obj = libcomp::PersistentObject::New(typeHash);
-
-        if(!obj || !obj->Load(doc, *pImportObject))
-        {
-            return libcomp::String("Failed to load object '%1' with "
-                "UUID %2.").Arg(objectType).Arg(uuid.ToString());
-        }
-
-        std::shared_ptr<libcomp::Database> db;
-
-        if("Account" == objectType)
-        {
-            db = lobbyDB;
-
-            lobbyObjects.push_back(std::make_pair(uuid, obj));
-        }
-        else
-        {
-            db = worldDB;
+    std::string utf8 = data.ToUtf8();
 
-            worldObjects.push_back(std::make_pair(uuid, obj));
-        }
-
-        if(!db)
-        {
-            return "Failed to connect to database.";
-        }
-
-        auto existingObject = libcomp::PersistentObject::LoadObjectByUUID(
-            typeHash, db, uuid);
-
-        if(existingObject)
-        {
-            return libcomp::String("Object with UUID '%1' already exists "
-                "in database.").Arg(uuid.ToString());
-        }
-
-        libcomp::String importError = CheckImportObject(objectType, obj,
-            lobbyDB, worldDB);
-
-        if(!importError.IsEmpty())
-        {
-            return importError;
-        }
-
-        pImportObject = pImportObject->NextSiblingElement("object");
-    }
-
-    for(auto pair : lobbyObjects)
+    if(!import.Feed(utf8.c_str(), utf8.size()))
     {
-        if(!pair.second->Register(pair.second, pair.first))
-        {
-            return "Failed to register an object.";
-        }
-    }
-
-    for(auto pair : worldObjects)
-    {
-        if(!pair.second->Register(pair.second, pair.first))
-        {
-            return "Failed to register an object.";
-        }
+        return import.GetError();
     }
 
-    auto lobbyChangeSet = libcomp::DatabaseChangeSet::Create();
-
-    for(auto pair : lobbyObjects)
-    {
-        lobbyChangeSet->Insert(pair.second);
-    }
-
-    if(!lobbyDB->ProcessChangeSet(lobbyChangeSet))
-    {
-        LogGeneralError([&]()
-        {
-            return libcomp::String("Import failed with lobby database error: "
-                "%1\n").Arg(lobbyDB->GetLastError());
-        });
-
-        return "Failed to write account into database.";
-    }
-
-    auto worldChangeSet = libcomp::DatabaseChangeSet::Create();
-
-    for(auto pair : worldObjects)
-    {
-        worldChangeSet->Insert(pair.second);
-    }
-
-    if(!worldDB->ProcessChangeSet(worldChangeSet))
-    {
-        LogGeneralError([&]()
-        {
-            return libcomp::String("Import failed with world database error: "
-                "%1\n").Arg(worldDB->GetLastError());
-        });
-
-        return "Failed to write account into database.";
-    }
-
-    return {};
+    return import.Finish();
 }
 
 libcomp::String LobbyServer::CheckImportObject(
@@ -0,0 +1,133 @@
+/**
+ * @file server/lobby/src/MetricsHandler.cpp
+ * @ingroup lobby
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Civet handler for the lobby metrics.
+ *
+ * This file is part of the Lobby Server (lobby).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricsHandler.h"
+
+// object Includes
+#include <RegisteredChannel.h>
+#include <RegisteredWorld.h>
+
+// Standard C++11 Includes
+#include <sstream>
+
+// lobby Includes
+#include "AccountManager.h"
+#include "World.h"
+
+using namespace lobby;
+
+MetricsHandler::MetricsHandler(
+    const std::shared_ptr<objects::LobbyConfig>& config,
+    const std::shared_ptr<lobby::LobbyServer>& server) :
+    mConfig(config), mServer(server)
+{
+}
+
+MetricsHandler::~MetricsHandler()
+{
+}
+
+bool MetricsHandler::handleGet(CivetServer *pServer,
+    struct mg_connection *pConnection)
+{
+    (void)pServer;
+
+    // Act like the page does not exist unless it has been enabled.
+    if(!mConfig->GetMetricsEnabled() || !mServer)
+    {
+        return false;
+    }
+
+    const mg_request_info *pRequestInfo = mg_get_request_info(pConnection);
+
+    // Sanity check the request info.
+    if(nullptr == pRequestInfo)
+    {
+        return false;
+    }
+
+    libcomp::String requestURI(pRequestInfo->request_uri);
+
+    if("/metrics" != requestURI)
+    {
+        return false;
+    }
+
+    auto worlds = mServer->GetWorlds();
+    auto accountManager = mServer->GetAccountManager();
+
+    std::stringstream ss;
+
+    ss << "# HELP comp_lobby_worlds Worlds registered with the lobby.\n"
+        << "# TYPE comp_lobby_worlds gauge\n"
+        << "comp_lobby_worlds " << worlds.size() << "\n";
+
+    std::stringstream channels;
+    std::stringstream accounts;
+
+    for(auto world : worlds)
+    {
+        auto registeredWorld = world->GetRegisteredWorld();
+
+        if(!registeredWorld)
+        {
+            continue;
+        }
+
+        int8_t worldID = (int8_t)registeredWorld->GetID();
+        auto registeredChannels = world->GetChannels();
+
+        channels << "comp_lobby_channels{world=\"" << (int32_t)worldID
+            << "\"} " << registeredChannels.size() << "\n";
+
+        for(auto channel : registeredChannels)
+        {
+            int8_t channelID = (int8_t)channel->GetID();
+
+            accounts << "comp_lobby_accounts_online{world=\""
+                << (int32_t)worldID << "\",channel=\"" << (int32_t)channelID
+                << "\"} " << accountManager->GetUsersInWorld(worldID,
+                    channelID).size() << "\n";
+        }
+    }
+
+    ss << "# HELP comp_lobby_channels Channels registered with each "
+        "world.\n"
+        << "# TYPE comp_lobby_channels gauge\n" << channels.str();
+
+    ss << "# HELP comp_lobby_accounts_online Accounts logged in on each "
+        "channel.\n"
+        << "# TYPE comp_lobby_accounts_online gauge\n" << accounts.str();
+
+    mg_printf(pConnection, "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: close\r\n"
+        "\r\n%s", (uint32_t)ss.str().size(),
+        ss.str().c_str());
+
+    return true;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file server/lobby/src/MetricsHandler.h
+ * @ingroup lobby
+ *
+ * @author COMP Omega <compomega@tutanota.com>
+ *
+ * @brief Civet handler for the lobby metrics.
+ *
+ * This file is part of the Lobby Server (lobby).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_LOBBY_SRC_METRICSHANDLER_H
+#define SERVER_LOBBY_SRC_METRICSHANDLER_H
+
+// lobby Includes
+#include "LobbyConfig.h"
+#include "LobbyServer.h"
+
+// Civet Includes
+#include <CivetServer.h>
+
+namespace lobby
+{
+
+class MetricsHandler : public CivetHandler
+{
+public:
+    MetricsHandler(const std::shared_ptr<objects::LobbyConfig>& config,
+        const std::shared_ptr<lobby::LobbyServer>& server);
+
+    virtual ~MetricsHandler();
+
+    virtual bool handleGet(CivetServer *pServer,
+        struct mg_connection *pConnection);
+
+private:
+    std::shared_ptr<objects::LobbyConfig> mConfig;
+    std::shared_ptr<lobby::LobbyServer> mServer;
+};
+
+} // namespace lobby
+
+#endif // SERVER_LOBBY_SRC_METRICSHANDLER_H
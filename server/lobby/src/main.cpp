@@ -32,6 +32,7 @@
 #include "LoginWebHandler.h"
 #include "LobbyConfig.h"
 #include "LobbyServer.h"
+#include "MetricsHandler.h"
 
 // libcomp Includes
 #include <Constants.h>
@@ -156,6 +157,8 @@ int main(int argc, const char *argv[])
 
     auto pImportHandler = new lobby::ImportHandler(config, server);
 
+    auto pMetricsHandler = new lobby::MetricsHandler(config, server);
+
     CivetServer *pWebServer = nullptr;
 
     try
@@ -164,6 +167,7 @@ int main(int argc, const char *argv[])
         pWebServer->addHandler("/", pLoginHandler);
         pWebServer->addHandler("/api", pApiHandler);
         pWebServer->addHandler("/import", pImportHandler);
+        pWebServer->addHandler("/metrics", pMetricsHandler);
     }
     catch(CivetException e)
     {
@@ -0,0 +1,252 @@
+/**
+ * @file server/world/bench/main.cpp
+ * @ingroup world
+ *
+ * @author HACKfrost
+ *
+ * @brief Micro-benchmarks for the world server.
+ *
+ * This file is part of the World Server (world).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// libcomp Includes
+#include <Git.h>
+#include <Packet.h>
+
+// object Includes
+#include <CharacterLogin.h>
+
+// Standard C++11 Includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <vector>
+
+// world Includes
+#include "CharacterManager.h"
+#include "WorldServer.h"
+
+using namespace world;
+
+namespace
+{
+
+/// Operation timed by a benchmark
+typedef std::function<void()> BenchmarkOp;
+
+/// Sink for values produced by benchmark operations
+std::atomic<uint64_t> gSink(0);
+
+/// Minimum time in nanoseconds one sample should take
+const uint64_t MIN_SAMPLE_NS = 20000000ULL;
+
+/// Time an operation run a number of times in a row
+uint64_t TimeIterations(const BenchmarkOp& op, uint64_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(uint64_t i = 0; i < iterations; i++)
+    {
+        op();
+    }
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+/// Measure an operation and write the result as one JSON object per line
+/// in the same format as comp_channel_bench
+void Run(std::ostream& out, const std::string& name, const BenchmarkOp& op,
+    uint32_t samples)
+{
+    samples = std::max(samples, (uint32_t)1);
+
+    // Warm up and double the iteration count until one sample takes long
+    // enough for the clock resolution to not matter
+    uint64_t iterations = 1;
+    while(TimeIterations(op, iterations) < MIN_SAMPLE_NS &&
+        iterations < (1ULL << 30))
+    {
+        iterations *= 2;
+    }
+
+    std::vector<double> perOp;
+    perOp.reserve(samples);
+    for(uint32_t i = 0; i < samples; i++)
+    {
+        perOp.push_back((double)TimeIterations(op, iterations) /
+            (double)iterations);
+    }
+
+    std::sort(perOp.begin(), perOp.end());
+
+    double total = 0.0;
+    for(double ns : perOp)
+    {
+        total += ns;
+    }
+
+    out << "{\"name\":\"" << name << "\""
+        << ",\"iterations\":" << iterations
+        << ",\"samples\":" << samples
+        << ",\"min_ns\":" << perOp.front()
+        << ",\"median_ns\":" << perOp[perOp.size() / 2]
+        << ",\"mean_ns\":" << total / (double)perOp.size()
+        << ",\"commit\":\"" << szGitCommittish << "\"}"
+        << std::endl;
+}
+
+/// Build a relay fan-out over a number of logged in characters spread
+/// across a number of channels
+BenchmarkOp RelayFanOut(uint32_t characterCount, int8_t channelCount)
+{
+    auto cLogins = std::make_shared<std::list<
+        std::shared_ptr<objects::CharacterLogin>>>();
+    for(uint32_t i = 0; i < characterCount; i++)
+    {
+        auto cLogin = std::make_shared<objects::CharacterLogin>();
+        cLogin->SetWorldCID((int32_t)(i + 1));
+        cLogin->SetChannelID((int8_t)(i % (uint32_t)channelCount));
+        cLogins->push_back(cLogin);
+
+        // Friends, party and clan lists overlap so some characters are
+        // listed more than once
+        if(i % 4 == 0)
+        {
+            cLogins->push_back(cLogin);
+        }
+    }
+
+    // Roughly the size of a chat message relayed to a clan
+    auto p = std::make_shared<libcomp::Packet>();
+    uint32_t cidOffset = WorldServer::GetRelayPacket(*p);
+    p->WriteBlank(96);
+
+    return [cLogins, p, cidOffset]()
+    {
+        auto packets = CharacterManager::BuildTargetCIDPackets(*p, *cLogins,
+            cidOffset);
+
+        uint64_t size = 0;
+        for(auto& pair : packets)
+        {
+            size += pair.second.Size();
+        }
+
+        gSink.fetch_add(size, std::memory_order_relaxed);
+    };
+}
+
+} // namespace
+
+/**
+ * Run the world micro-benchmarks. Results are written to standard output
+ * (or the file passed to --output) as one JSON object per line.
+ *
+ * Usage: comp_world_bench [--filter NAME] [--samples N] [--output FILE]
+ */
+int main(int argc, const char *argv[])
+{
+    std::string filter;
+    std::string outputPath;
+    uint32_t samples = 15;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(0 == strcmp(argv[i], "--filter") && (i + 1) < argc)
+        {
+            filter = argv[++i];
+        }
+        else if(0 == strcmp(argv[i], "--samples") && (i + 1) < argc)
+        {
+            samples = (uint32_t)atoi(argv[++i]);
+        }
+        else if(0 == strcmp(argv[i], "--output") && (i + 1) < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--filter NAME]"
+                " [--samples N] [--output FILE]" << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Fixtures are built in process so the server is never initialized and
+    // no database is needed
+    std::list<std::pair<std::string,
+        std::function<BenchmarkOp()>>> benchmarks;
+    benchmarks.push_back(std::make_pair(
+        "CharacterManager::BuildTargetCIDPackets/Party", []()
+        {
+            return RelayFanOut(5, 3);
+        }));
+    benchmarks.push_back(std::make_pair(
+        "CharacterManager::BuildTargetCIDPackets/Clan", []()
+        {
+            return RelayFanOut(100, 4);
+        }));
+    benchmarks.push_back(std::make_pair(
+        "CharacterManager::BuildTargetCIDPackets/World", []()
+        {
+            return RelayFanOut(1000, 10);
+        }));
+
+    std::ofstream file;
+    if(!outputPath.empty())
+    {
+        file.open(outputPath.c_str());
+        if(!file.good())
+        {
+            std::cerr << "Failed to open output file: " << outputPath
+                << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    size_t count = 0;
+    for(auto& pair : benchmarks)
+    {
+        if(!filter.empty() && pair.first.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        Run(out, pair.first, pair.second(), samples);
+        count++;
+    }
+
+    if(!count)
+    {
+        std::cerr << "No benchmarks matched the filter." << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -32,6 +32,9 @@
 #include <Log.h>
 #include <PacketCodes.h>
 
+// Standard C++11 Includes
+#include <unordered_set>
+
 // object Includes
 #include <Character.h>
 #include <ClanMember.h>
@@ -188,41 +191,69 @@ bool CharacterManager::RequestChannelDisconnect(int32_t worldCID)
 bool CharacterManager::SendToCharacters(libcomp::Packet& p,
     const std::list<std::shared_ptr<objects::CharacterLogin>>& cLogins, uint32_t cidOffset)
 {
+    auto server = mServer.lock();
+    for(auto& pair : BuildTargetCIDPackets(p, cLogins, cidOffset))
+    {
+        auto channel = server->GetChannelConnectionByID(pair.first);
+
+        // If the channel is not valid, move on and clean it up later
+        if(!channel) continue;
+
+        channel->SendPacket(pair.second);
+    }
+
+    return true;
+}
+
+std::unordered_map<int8_t, libcomp::Packet>
+    CharacterManager::BuildTargetCIDPackets(libcomp::Packet& p,
+    const std::list<std::shared_ptr<objects::CharacterLogin>>& cLogins,
+    uint32_t cidOffset)
+{
+    // Logins can be listed more than once when they are related in more
+    // than one way so only send to each world CID once
+    std::unordered_set<int32_t> sent;
     std::unordered_map<int8_t, std::list<int32_t>> channelMap;
     for(auto c : cLogins)
     {
         int8_t channelID = c->GetChannelID();
-        if(channelID >= 0)
+        if(channelID >= 0 && sent.insert(c->GetWorldCID()).second)
         {
             channelMap[channelID].push_back(c->GetWorldCID());
         }
     }
 
-    if(cidOffset > (p.Size() - 2))
+    std::unordered_map<int8_t, libcomp::Packet> packets;
+    if(channelMap.size() == 0)
     {
-        cidOffset = (p.Size() - 2);
+        return packets;
     }
 
-    auto server = mServer.lock();
-    auto channels = server->GetChannels();
-    for(auto pair : channelMap)
+    if(cidOffset > (p.Size() - 2))
     {
-        auto channel = server->GetChannelConnectionByID(pair.first);
+        cidOffset = (p.Size() - 2);
+    }
 
-        // If the channel is not valid, move on and clean it up later
-        if(!channel) continue;
+    // Split the packet around the CID list once and build each channel's
+    // packet from the two halves instead of copying and converting the
+    // whole packet for every channel
+    p.Seek(0);
+    auto beforeData = p.ReadArray(cidOffset + 2);
+    auto afterData = p.ReadArray(p.Left());
 
-        libcomp::Packet p2(p);
-        ConvertToTargetCIDPacket(p2, cidOffset, pair.second.size());
+    for(auto& pair : channelMap)
+    {
+        libcomp::Packet& p2 = packets[pair.first];
+        p2.WriteArray(beforeData);
+        p2.WriteU16Little((uint16_t)pair.second.size());
         for(int32_t fCID : pair.second)
         {
             p2.WriteS32Little(fCID);
         }
-
-        channel->SendPacket(p2);
+        p2.WriteArray(afterData);
     }
 
-    return true;
+    return packets;
 }
 
 void CharacterManager::ConvertToTargetCIDPacket(libcomp::Packet& p, uint32_t cidOffset,
@@ -274,8 +305,7 @@ bool CharacterManager::SendToRelatedCharacters(libcomp::Packet& p,
         cLogins.push_back(cLogin);
     }
 
-    cLogins.unique();
-
+    // Duplicates are removed when sending
     return cLogins.size() == 0 || SendToCharacters(p, cLogins, cidOffset);
 }
 
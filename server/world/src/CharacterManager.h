@@ -134,7 +134,8 @@ public:
     bool RequestChannelDisconnect(int32_t worldCID);
 
     /**
-     * Send a packet to the specified logins
+     * Send a packet to the specified logins. Each world CID is only sent
+     * the packet once even if it is listed more than once.
      * @param p Packet to send
      * @param cLogins CharacterLogins to map channel connections to when sending
      *  the packet
@@ -147,6 +148,23 @@ public:
         const std::list<std::shared_ptr<objects::CharacterLogin>>& cLogins,
         uint32_t cidOffset);
 
+    /**
+     * Build the packet @ref SendToCharacters sends to each channel. The
+     * packet is split around the CID list once and each channel's packet
+     * is built from the two halves and the world CIDs on that channel.
+     * @param p Packet to send
+     * @param cLogins CharacterLogins to map channel connections to when
+     *  sending the packet
+     * @param cidOffset Position in bytes after the packet code where the
+     *  list of CIDs should be inserted. If the value is larger than the
+     *  packet, it will be appended to the end.
+     * @return Map of channel IDs to the packet to send to that channel
+     */
+    static std::unordered_map<int8_t, libcomp::Packet> BuildTargetCIDPackets(
+        libcomp::Packet& p,
+        const std::list<std::shared_ptr<objects::CharacterLogin>>& cLogins,
+        uint32_t cidOffset);
+
     /**
      * Insert space in a packet for a count denoted list of world CID targets and
      * seek to the position of the first CID in the list.
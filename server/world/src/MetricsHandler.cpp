@@ -0,0 +1,163 @@
+/**
+ * @file server/world/src/MetricsHandler.cpp
+ * @ingroup world
+ *
+ * @author HACKfrost
+ *
+ * @brief Web handler that serves the server metrics.
+ *
+ * This file is part of the World Server (world).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricsHandler.h"
+
+// libcomp Includes
+#include <CString.h>
+
+// object Includes
+#include <CharacterLogin.h>
+#include <RegisteredChannel.h>
+
+// Standard C++11 Includes
+#include <map>
+#include <sstream>
+
+// world Includes
+#include "CharacterManager.h"
+#include "WorldServer.h"
+#include "WorldSyncManager.h"
+
+using namespace world;
+
+namespace
+{
+
+/// Write the help and type lines that precede a metric
+void WriteHeader(std::ostream& out, const std::string& name,
+    const std::string& type, const std::string& help)
+{
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+} // namespace
+
+MetricsHandler::MetricsHandler(const std::shared_ptr<WorldServer>& server)
+    : mServer(server)
+{
+}
+
+MetricsHandler::~MetricsHandler()
+{
+}
+
+bool MetricsHandler::handleGet(CivetServer *pServer,
+    struct mg_connection *pConnection)
+{
+    (void)pServer;
+
+    const mg_request_info *pRequestInfo = mg_get_request_info(pConnection);
+
+    if(nullptr == pRequestInfo)
+    {
+        return false;
+    }
+
+    libcomp::String requestURI(pRequestInfo->request_uri);
+
+    if("/metrics" != requestURI)
+    {
+        return false;
+    }
+
+    auto server = mServer.lock();
+
+    if(!server)
+    {
+        mg_printf(pConnection, "HTTP/1.1 503 Service Unavailable\r\n"
+            "Connection: close\r\n\r\n");
+
+        return true;
+    }
+
+    std::ostringstream out;
+
+    WriteHeader(out, "comp_world_channels", "gauge",
+        "Channels registered with the world.");
+    out << "comp_world_channels " << server->GetChannels().size() << "\n";
+
+    // Count characters by the channel they are on
+    std::map<int8_t, uint64_t> channelCounts;
+    for(auto& channel : server->GetChannels())
+    {
+        channelCounts[(int8_t)channel.second->GetID()] = 0;
+    }
+
+    for(auto& cLogin : server->GetCharacterManager()->GetActiveCharacters())
+    {
+        channelCounts[cLogin->GetChannelID()]++;
+    }
+
+    WriteHeader(out, "comp_world_characters_online", "gauge",
+        "Characters logged in on each channel (-1 while between channels).");
+    for(auto& pair : channelCounts)
+    {
+        out << "comp_world_characters_online{channel=\""
+            << (int32_t)pair.first << "\"} " << pair.second << "\n";
+    }
+
+    auto syncManager = server->GetWorldSyncManager();
+
+    WriteHeader(out, "comp_world_sync_records_total", "counter",
+        "Records synchronized with the lobby and channels by type.");
+    for(auto& pair : syncManager->GetSyncStats())
+    {
+        std::string type = pair.first.ToUtf8();
+        auto& stats = pair.second;
+
+        out << "comp_world_sync_records_total{type=\"" << type
+            << "\",op=\"update\"} " << stats.Updates << "\n";
+        out << "comp_world_sync_records_total{type=\"" << type
+            << "\",op=\"remove\"} " << stats.Removes << "\n";
+        out << "comp_world_sync_records_total{type=\"" << type
+            << "\",op=\"coalesced\"} " << stats.Coalesced << "\n";
+        out << "comp_world_sync_records_total{type=\"" << type
+            << "\",op=\"replayed\"} " << stats.Replayed << "\n";
+    }
+
+    WriteHeader(out, "comp_world_sync_received_packets_total", "counter",
+        "Sync packets received from the lobby and channels.");
+    out << "comp_world_sync_received_packets_total "
+        << syncManager->GetIncomingPacketCount() << "\n";
+
+    WriteHeader(out, "comp_world_sync_received_bytes_total", "counter",
+        "Sync packet bytes received from the lobby and channels.");
+    out << "comp_world_sync_received_bytes_total "
+        << syncManager->GetIncomingByteCount() << "\n";
+
+    std::string text = out.str();
+
+    mg_printf(pConnection, "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: %u\r\n"
+        "Connection: close\r\n"
+        "\r\n", (uint32_t)text.size());
+    mg_write(pConnection, text.c_str(), text.size());
+
+    return true;
+}
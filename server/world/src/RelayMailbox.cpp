@@ -0,0 +1,254 @@
+/**
+ * @file server/world/src/RelayMailbox.cpp
+ * @ingroup world
+ *
+ * @author HACKfrost
+ *
+ * @brief Holds relayed tells for offline characters until they log in.
+ *
+ * This file is part of the World Server (world).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RelayMailbox.h"
+
+// libcomp Includes
+#include <InternalConnection.h>
+#include <Log.h>
+#include <Packet.h>
+#include <PacketCodes.h>
+
+// object Includes
+#include <Character.h>
+#include <CharacterLogin.h>
+#include <WorldConfig.h>
+
+// world Includes
+#include "WorldServer.h"
+
+using namespace world;
+
+RelayMailbox::RelayMailbox(const std::weak_ptr<WorldServer>& server)
+    : mServer(server), mMaxSize(0), mExpiration(0), mSenderLimit(0),
+    mMaxCharacters(0)
+{
+    auto config = std::dynamic_pointer_cast<objects::WorldConfig>(
+        server.lock()->GetConfig());
+    mMaxSize = (size_t)config->GetRelayMailboxSize();
+    mExpiration = (std::time_t)config->GetRelayMailboxExpiration();
+    mSenderLimit = (size_t)config->GetRelayMailboxSenderLimit();
+    mMaxCharacters = (size_t)config->GetRelayMailboxCharacters();
+}
+
+bool RelayMailbox::IsStorable(const std::vector<char>& packetData)
+{
+    if(packetData.size() < 4)
+    {
+        return false;
+    }
+
+    // Packet code followed by the chat type, both little endian
+    uint16_t packetCode = (uint16_t)((uint8_t)packetData[0] |
+        ((uint8_t)packetData[1] << 8));
+    uint16_t chatType = (uint16_t)((uint8_t)packetData[2] |
+        ((uint8_t)packetData[3] << 8));
+
+    // Only tells are meant for one specific character
+    return packetCode == (uint16_t)ChannelToClientPacketCode_t::PACKET_CHAT &&
+        chatType == (uint16_t)ChatType_t::CHAT_TELL;
+}
+
+bool RelayMailbox::Store(int32_t sourceCID, const std::shared_ptr<
+    objects::CharacterLogin>& targetLogin,
+    const std::vector<char>& packetData)
+{
+    if(!mMaxSize || !targetLogin || !IsStorable(packetData))
+    {
+        return false;
+    }
+
+    libcomp::String lookup = targetLogin->GetCharacter().GetUUID().ToString();
+    std::time_t now = std::time(0);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    if(mMaxCharacters && mMailboxes.size() >= mMaxCharacters &&
+        mMailboxes.find(lookup) == mMailboxes.end())
+    {
+        // Make room from mailboxes of characters that never came back
+        ExpireMailboxes(now);
+
+        if(mMailboxes.size() >= mMaxCharacters)
+        {
+            LogGeneralDebug([&]()
+            {
+                return libcomp::String("Relay mailbox character limit"
+                    " reached, not holding tell for character %1\n")
+                    .Arg(lookup);
+            });
+
+            return false;
+        }
+    }
+
+    auto& entries = mMailboxes[lookup];
+    Expire(entries, now);
+
+    if(entries.size() >= mMaxSize)
+    {
+        LogGeneralDebug([&]()
+        {
+            return libcomp::String("Relay mailbox for character %1 is full\n")
+                .Arg(lookup);
+        });
+
+        return false;
+    }
+
+    if(mSenderLimit)
+    {
+        PruneSenders(now);
+
+        auto& times = mSenderTimes[sourceCID];
+        while(times.size() > 0 && (now - times.front()) >= 60)
+        {
+            times.pop_front();
+        }
+
+        if(times.size() >= mSenderLimit)
+        {
+            LogGeneralDebug([&]()
+            {
+                return libcomp::String("Relay mailbox sender limit reached"
+                    " by world CID %1\n").Arg(sourceCID);
+            });
+
+            return false;
+        }
+
+        times.push_back(now);
+    }
+
+    Entry entry;
+    entry.SourceCID = sourceCID;
+    entry.Time = now;
+    entry.Data = packetData;
+    entries.push_back(entry);
+
+    return true;
+}
+
+size_t RelayMailbox::Deliver(const std::shared_ptr<
+    objects::CharacterLogin>& cLogin,
+    const std::shared_ptr<libcomp::InternalConnection>& channel)
+{
+    if(!mMaxSize || !cLogin || !channel)
+    {
+        return 0;
+    }
+
+    libcomp::String lookup = cLogin->GetCharacter().GetUUID().ToString();
+    std::time_t now = std::time(0);
+
+    std::list<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        auto it = mMailboxes.find(lookup);
+        if(it == mMailboxes.end())
+        {
+            return 0;
+        }
+
+        entries.swap(it->second);
+        mMailboxes.erase(it);
+
+        Expire(entries, now);
+        PruneSenders(now);
+    }
+
+    if(entries.size() == 0)
+    {
+        return 0;
+    }
+
+    for(auto& entry : entries)
+    {
+        libcomp::Packet relay;
+        WorldServer::GetRelayPacket(relay, cLogin->GetWorldCID(),
+            entry.SourceCID);
+        relay.WriteArray(entry.Data);
+
+        channel->QueuePacket(relay);
+    }
+
+    channel->FlushOutgoing();
+
+    LogGeneralDebug([&]()
+    {
+        return libcomp::String("Delivered %1 held relay message(s) to"
+            " character %2\n").Arg(entries.size()).Arg(lookup);
+    });
+
+    return entries.size();
+}
+
+void RelayMailbox::Expire(std::list<Entry>& entries, std::time_t now) const
+{
+    if(!mExpiration)
+    {
+        return;
+    }
+
+    // Entries are held in order so only the front can be expired
+    while(entries.size() > 0 && (now - entries.front().Time) >= mExpiration)
+    {
+        entries.pop_front();
+    }
+}
+
+void RelayMailbox::ExpireMailboxes(std::time_t now)
+{
+    for(auto mIter = mMailboxes.begin(); mIter != mMailboxes.end();)
+    {
+        Expire(mIter->second, now);
+        if(mIter->second.size() == 0)
+        {
+            mIter = mMailboxes.erase(mIter);
+        }
+        else
+        {
+            mIter++;
+        }
+    }
+}
+
+void RelayMailbox::PruneSenders(std::time_t now)
+{
+    for(auto sIter = mSenderTimes.begin(); sIter != mSenderTimes.end();)
+    {
+        if(sIter->second.size() == 0 ||
+            (now - sIter->second.back()) >= 60)
+        {
+            sIter = mSenderTimes.erase(sIter);
+        }
+        else
+        {
+            sIter++;
+        }
+    }
+}
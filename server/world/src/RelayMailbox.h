@@ -0,0 +1,167 @@
+/**
+ * @file server/world/src/RelayMailbox.h
+ * @ingroup world
+ *
+ * @author HACKfrost
+ *
+ * @brief Holds relayed tells for offline characters until they log in.
+ *
+ * This file is part of the World Server (world).
+ *
+ * Copyright (C) 2012-2020 COMP_hack Team <compomega@tutanota.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_WORLD_SRC_RELAYMAILBOX_H
+#define SERVER_WORLD_SRC_RELAYMAILBOX_H
+
+// libcomp Includes
+#include <CString.h>
+
+// Standard C++11 Includes
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace libcomp
+{
+class InternalConnection;
+}
+
+namespace objects
+{
+class CharacterLogin;
+}
+
+namespace world
+{
+
+class WorldServer;
+
+/**
+ * Mailbox for relayed tells that could not be delivered because the target
+ * character was offline. Held tells are delivered in the order they were
+ * sent once the character enters a zone on any channel. Mailboxes are kept
+ * in memory only.
+ */
+class RelayMailbox
+{
+public:
+    /**
+     * Create a new relay mailbox.
+     * @param server Pointer back to the world server this belongs to
+     */
+    RelayMailbox(const std::weak_ptr<WorldServer>& server);
+
+    /**
+     * Check if relayed packet data is a message that can be held for an
+     * offline character.
+     * @param packetData Channel to client packet being relayed
+     * @return true if the packet can be held
+     */
+    static bool IsStorable(const std::vector<char>& packetData);
+
+    /**
+     * Hold relayed packet data for an offline character.
+     * @param sourceCID World CID of the character that sent the packet
+     * @param targetLogin Pointer to the offline target's CharacterLogin
+     * @param packetData Channel to client packet being relayed
+     * @return false if the packet can not be held and should be reported
+     *  to the sender as failed
+     */
+    bool Store(int32_t sourceCID, const std::shared_ptr<
+        objects::CharacterLogin>& targetLogin,
+        const std::vector<char>& packetData);
+
+    /**
+     * Deliver all held packets for a character that has entered a zone.
+     * @param cLogin Pointer to the CharacterLogin of the character
+     * @param channel Connection to the channel the character is on
+     * @return Number of packets delivered
+     */
+    size_t Deliver(const std::shared_ptr<objects::CharacterLogin>& cLogin,
+        const std::shared_ptr<libcomp::InternalConnection>& channel);
+
+private:
+    /**
+     * Packet held for an offline character.
+     */
+    struct Entry
+    {
+        /// World CID of the character that sent the packet
+        int32_t SourceCID;
+
+        /// System time the packet was held at
+        std::time_t Time;
+
+        /// Channel to client packet to deliver
+        std::vector<char> Data;
+    };
+
+    /**
+     * Remove all entries that have expired from a mailbox. The server lock
+     * must be held when calling this.
+     * @param entries Mailbox to remove expired entries from
+     * @param now Current system time
+     */
+    void Expire(std::list<Entry>& entries, std::time_t now) const;
+
+    /**
+     * Remove every mailbox that only held expired entries. The server
+     * lock must be held when calling this.
+     * @param now Current system time
+     */
+    void ExpireMailboxes(std::time_t now);
+
+    /**
+     * Remove sender windows that no longer limit anything. The server
+     * lock must be held when calling this.
+     * @param now Current system time
+     */
+    void PruneSenders(std::time_t now);
+
+    /// Pointer to the world server
+    std::weak_ptr<WorldServer> mServer;
+
+    /// Held packets by target character UUID string
+    std::unordered_map<libcomp::String, std::list<Entry>> mMailboxes;
+
+    /// Times packets were held for each sender world CID within the last
+    /// minute, used to limit how quickly a sender can fill mailboxes
+    std::unordered_map<int32_t, std::list<std::time_t>> mSenderTimes;
+
+    /// Maximum number of packets held per character, 0 disables the mailbox
+    size_t mMaxSize;
+
+    /// Number of seconds a packet is held for, 0 means no expiration
+    std::time_t mExpiration;
+
+    /// Maximum number of packets a sender can have held per minute, 0 means
+    /// no limit
+    size_t mSenderLimit;
+
+    /// Maximum number of characters with held packets, 0 means no limit
+    size_t mMaxCharacters;
+
+    /// Server lock for the mailboxes
+    std::mutex mLock;
+};
+
+} // namespace world
+
+#endif // SERVER_WORLD_SRC_RELAYMAILBOX_H
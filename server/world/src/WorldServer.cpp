@@ -43,6 +43,7 @@
 #include "AccountManager.h"
 #include "CharacterManager.h"
 #include "Packets.h"
+#include "RelayMailbox.h"
 #include "WorldSyncManager.h"
 
 using namespace world;
@@ -85,6 +86,7 @@ bool WorldServer::Initialize()
     mAccountManager = new AccountManager(self);
     mCharacterManager = new CharacterManager(self);
     mSyncManager = new WorldSyncManager(self);
+    mRelayMailbox = new RelayMailbox(self);
 
     return true;
 }
@@ -206,6 +208,7 @@ WorldServer::~WorldServer()
     delete mAccountManager;
     delete mCharacterManager;
     delete mSyncManager;
+    delete mRelayMailbox;
 }
 
 const std::shared_ptr<objects::RegisteredWorld> WorldServer::GetRegisteredWorld() const
@@ -413,6 +416,11 @@ WorldSyncManager* WorldServer::GetWorldSyncManager() const
     return mSyncManager;
 }
 
+RelayMailbox* WorldServer::GetRelayMailbox() const
+{
+    return mRelayMailbox;
+}
+
 uint32_t WorldServer::GetRelayPacket(libcomp::Packet& p,
     const std::list<int32_t>& targetCIDs, int32_t sourceCID)
 {
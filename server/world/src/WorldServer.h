@@ -45,6 +45,7 @@ namespace world
 
 class AccountManager;
 class CharacterManager;
+class RelayMailbox;
 class WorldSyncManager;
 
 class WorldServer : public libcomp::BaseServer
@@ -181,6 +182,12 @@ public:
      */
     WorldSyncManager* GetWorldSyncManager() const;
 
+    /**
+     * Get a pointer to the mailbox holding tells for offline characters.
+     * @return Pointer to the RelayMailbox
+     */
+    RelayMailbox* GetRelayMailbox() const;
+
     /**
      * Build the data-less relay packet from and targetting the supplied
      * world CIDs.
@@ -240,6 +247,9 @@ protected:
     /// Data sync manager for the server.
     WorldSyncManager* mSyncManager;
 
+    /// Mailbox holding tells for offline characters.
+    RelayMailbox* mRelayMailbox;
+
     /// Server lock for shared resources
     std::mutex mLock;
 };
@@ -62,7 +62,8 @@
 using namespace world;
 
 WorldSyncManager::WorldSyncManager(const std::weak_ptr<
-    WorldServer>& server) : mNextMatchID(0), mServer(server)
+    WorldServer>& server) : mNextMatchID(0), mIncomingPackets(0),
+    mIncomingBytes(0), mServer(server)
 {
     mPvPReadyTimes[0] = { { 0, 0 } };
     mPvPReadyTimes[1] = { { 0, 0 } };
@@ -1162,9 +1163,35 @@ int8_t WorldSyncManager::Update<objects::SearchEntry>(const libcomp::String& typ
 }
 }
 
+bool WorldSyncManager::UpdateRecord(
+    const std::shared_ptr<libcomp::Object>& record,
+    const libcomp::String& type)
+{
+    {
+        std::lock_guard<std::mutex> lock(mStatsLock);
+
+        auto& stats = mSyncStats[type];
+        stats.Updates++;
+
+        // Queued records are held by type until the next sync so a repeat
+        // update is only sent once
+        if(record && !mPendingRecords[type].insert(record.get()).second)
+        {
+            stats.Coalesced++;
+        }
+    }
+
+    return DataSyncManager::UpdateRecord(record, type);
+}
+
 bool WorldSyncManager::RemoveRecord(const std::shared_ptr<libcomp::Object>& record,
     const libcomp::String& type)
 {
+    {
+        std::lock_guard<std::mutex> lock(mStatsLock);
+        mSyncStats[type].Removes++;
+    }
+
     if(DataSyncManager::RemoveRecord(record, type))
     {
         bool recalcTeamPvP = false;
@@ -1393,6 +1420,42 @@ bool WorldSyncManager::CleanUpCharacterLogin(int32_t worldCID, bool flushOutgoin
     return result;
 }
 
+void WorldSyncManager::SyncOutgoing()
+{
+    {
+        std::lock_guard<std::mutex> lock(mStatsLock);
+        mPendingRecords.clear();
+    }
+
+    DataSyncManager::SyncOutgoing();
+}
+
+void WorldSyncManager::RecordIncoming(uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(mStatsLock);
+    mIncomingPackets++;
+    mIncomingBytes += (uint64_t)size;
+}
+
+std::unordered_map<libcomp::String, SyncTypeStats>
+    WorldSyncManager::GetSyncStats()
+{
+    std::lock_guard<std::mutex> lock(mStatsLock);
+    return mSyncStats;
+}
+
+uint64_t WorldSyncManager::GetIncomingPacketCount()
+{
+    std::lock_guard<std::mutex> lock(mStatsLock);
+    return mIncomingPackets;
+}
+
+uint64_t WorldSyncManager::GetIncomingByteCount()
+{
+    std::lock_guard<std::mutex> lock(mStatsLock);
+    return mIncomingBytes;
+}
+
 void WorldSyncManager::SyncExistingChannelRecords(const std::shared_ptr<
     libcomp::InternalConnection>& connection)
 {
@@ -1405,13 +1468,12 @@ void WorldSyncManager::SyncExistingChannelRecords(const std::shared_ptr<
     std::lock_guard<std::mutex> lock(mLock);
 
     std::set<std::shared_ptr<libcomp::Object>> records;
-    std::set<std::shared_ptr<libcomp::Object>> blank;
     for(auto entry : mSearchEntries)
     {
         records.insert(entry);
     }
 
-    QueueOutgoing("SearchEntry", connection, records, blank);
+    QueueReplay("SearchEntry", connection, records);
 
     records.clear();
     for(auto cLogin : mServer.lock()->GetCharacterManager()
@@ -1420,7 +1482,7 @@ void WorldSyncManager::SyncExistingChannelRecords(const std::shared_ptr<
         records.insert(cLogin);
     }
 
-    QueueOutgoing("CharacterLogin", connection, records, blank);
+    QueueReplay("CharacterLogin", connection, records);
 
     records.clear();
     for(auto& pair : mInstanceAccess)
@@ -1431,7 +1493,7 @@ void WorldSyncManager::SyncExistingChannelRecords(const std::shared_ptr<
         }
     }
 
-    QueueOutgoing("InstanceAccess", connection, records, blank);
+    QueueReplay("InstanceAccess", connection, records);
 
     records.clear();
     for(auto& pair : mMatchEntries)
@@ -1439,14 +1501,14 @@ void WorldSyncManager::SyncExistingChannelRecords(const std::shared_ptr<
         records.insert(pair.second);
     }
 
-    QueueOutgoing("MatchEntry", connection, records, blank);
+    QueueReplay("MatchEntry", connection, records);
 
     if(mPentalphaMatch)
     {
         records.clear();
         records.insert(mPentalphaMatch);
 
-        QueueOutgoing("PentalphaMatch", connection, records, blank);
+        QueueReplay("PentalphaMatch", connection, records);
     }
 
     if(mUBTournament)
@@ -1454,10 +1516,35 @@ void WorldSyncManager::SyncExistingChannelRecords(const std::shared_ptr<
         records.clear();
         records.insert(mUBTournament);
 
-        QueueOutgoing("UBTournament", connection, records, blank);
+        QueueReplay("UBTournament", connection, records);
     }
 
     connection->FlushOutgoing();
+
+    for(auto& pair : GetSyncStats())
+    {
+        LogDataSyncManagerDebug([&]()
+        {
+            return libcomp::String("Sync totals for %1: %2 update(s), %3"
+                " coalesced, %4 removal(s), %5 replayed.\n")
+                .Arg(pair.first).Arg(pair.second.Updates)
+                .Arg(pair.second.Coalesced).Arg(pair.second.Removes)
+                .Arg(pair.second.Replayed);
+        });
+    }
+}
+
+void WorldSyncManager::QueueReplay(const libcomp::String& type,
+    const std::shared_ptr<libcomp::InternalConnection>& connection,
+    const std::set<std::shared_ptr<libcomp::Object>>& records)
+{
+    {
+        std::lock_guard<std::mutex> lock(mStatsLock);
+        mSyncStats[type].Replayed += (uint64_t)records.size();
+    }
+
+    std::set<std::shared_ptr<libcomp::Object>> blank;
+    QueueOutgoing(type, connection, records, blank);
 }
 
 void WorldSyncManager::StartPvPMatch(uint32_t time, uint8_t type)
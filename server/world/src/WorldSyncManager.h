@@ -35,6 +35,11 @@
 // object Includes
 #include <SearchEntry.h>
 
+// Standard C++11 Includes
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
 namespace objects
 {
 class ChannelLogin;
@@ -51,6 +56,25 @@ namespace world
 
 class WorldServer;
 
+/**
+ * Counts of records of one type synchronized by the world server.
+ */
+struct SyncTypeStats
+{
+    /// Number of record updates queued
+    uint64_t Updates = 0;
+
+    /// Number of record removals queued
+    uint64_t Removes = 0;
+
+    /// Number of updates folded into an update of the same record that
+    /// was already queued to send
+    uint64_t Coalesced = 0;
+
+    /// Number of records sent to newly connected channels
+    uint64_t Replayed = 0;
+};
+
 /**
  * World specific implementation of the DataSyncManager in charge of
  * performing server side update operations.
@@ -102,9 +126,48 @@ public:
         const std::list<std::pair<std::shared_ptr<libcomp::Object>, bool>>& objs,
         const libcomp::String& source);
 
+    /**
+     * Queue a record update to send on the next sync. Updating a record
+     * that is already queued only sends it once.
+     * @param record Pointer to the record being updated
+     * @param type Type name of the record
+     * @return true if the update was queued
+     */
+    bool UpdateRecord(const std::shared_ptr<libcomp::Object>& record,
+        const libcomp::String& type);
+
     virtual bool RemoveRecord(const std::shared_ptr<libcomp::Object>& record,
         const libcomp::String& type);
 
+    /**
+     * Send all queued record updates and removals.
+     */
+    void SyncOutgoing();
+
+    /**
+     * Count a sync packet received from another server.
+     * @param size Size of the packet in bytes
+     */
+    void RecordIncoming(uint32_t size);
+
+    /**
+     * Get the counts of records synchronized by type.
+     * @return Map of record type names to their counts
+     */
+    std::unordered_map<libcomp::String, SyncTypeStats> GetSyncStats();
+
+    /**
+     * Get the number of sync packets received from other servers.
+     * @return Number of sync packets received
+     */
+    uint64_t GetIncomingPacketCount();
+
+    /**
+     * Get the number of sync packet bytes received from other servers.
+     * @return Number of sync packet bytes received
+     */
+    uint64_t GetIncomingByteCount();
+
     /**
      * Expire the existing record with a matching entry ID and expiration time
      * of the templated type. If either does not match, nothing will be expired.
@@ -190,6 +253,18 @@ private:
     void AdjustSearchEntryCount(int32_t sourceCID,
         objects::SearchEntry::Type_t type, bool increment);
 
+    /**
+     * Queue existing records of one type to send to a newly connected
+     * channel. This function is NOT thread safe and requires the caller
+     * to lock mutex access before calling.
+     * @param type Type name of the records
+     * @param connection Pointer to the channel connection
+     * @param records Records to send
+     */
+    void QueueReplay(const libcomp::String& type,
+        const std::shared_ptr<libcomp::InternalConnection>& connection,
+        const std::set<std::shared_ptr<libcomp::Object>>& records);
+
     /**
      * Determine if a solo PvP match of the specified type can be started and
      * queue it to start if it is. This function is thread safe.
@@ -308,6 +383,23 @@ private:
     /// Next match ID to use for any matches prepared by the server
     uint32_t mNextMatchID;
 
+    /// Counts of records synchronized by type
+    std::unordered_map<libcomp::String, SyncTypeStats> mSyncStats;
+
+    /// Records queued to send on the next sync by type, used to count
+    /// updates that were coalesced
+    std::unordered_map<libcomp::String, std::set<
+        const libcomp::Object*>> mPendingRecords;
+
+    /// Number of sync packets received from other servers
+    uint64_t mIncomingPackets;
+
+    /// Number of sync packet bytes received from other servers
+    uint64_t mIncomingBytes;
+
+    /// Server lock for the sync counts
+    std::mutex mStatsLock;
+
     /// Pointer to the channel server.
     std::weak_ptr<WorldServer> mServer;
 };
@@ -41,6 +41,7 @@
 
 // world Includes
 #include "CharacterManager.h"
+#include "RelayMailbox.h"
 #include "WorldServer.h"
 #include "WorldSyncManager.h"
 
@@ -112,6 +113,7 @@ bool Parsers::CharacterLogin::Parse(libcomp::ManagerPacket *pPacketManager,
         cLogin->SetStatus((objects::CharacterLogin::Status_t)statusID);
     }
 
+    bool enteredZone = false;
     uint32_t previousZoneID = cLogin->GetZoneID();
     int8_t previousChannelID = cLogin->GetChannelID();
     if(updateFlags & (uint8_t)CharacterLoginStateFlag_t::CHARLOGIN_ZONE)
@@ -132,6 +134,7 @@ bool Parsers::CharacterLogin::Parse(libcomp::ManagerPacket *pPacketManager,
         if(zoneID && !previousZoneID)
         {
             cLogin->GetCharacter().Get(server->GetWorldDatabase(), true);
+            enteredZone = true;
         }
     }
 
@@ -219,5 +222,13 @@ bool Parsers::CharacterLogin::Parse(libcomp::ManagerPacket *pPacketManager,
     // Sync with everyone else
     server->GetWorldSyncManager()->SyncRecordUpdate(cLogin, "CharacterLogin");
 
+    // Deliver anything held while the character was offline
+    if(enteredZone)
+    {
+        server->GetRelayMailbox()->Deliver(cLogin,
+            std::dynamic_pointer_cast<libcomp::InternalConnection>(
+                connection));
+    }
+
     return true;
 }
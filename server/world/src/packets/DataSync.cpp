@@ -44,6 +44,7 @@ bool Parsers::DataSync::Parse(libcomp::ManagerPacket *pPacketManager,
     auto server = std::dynamic_pointer_cast<WorldServer>(pPacketManager
         ->GetServer());
     auto syncManager = server->GetWorldSyncManager();
+    syncManager->RecordIncoming(p.Size());
 
     libcomp::String source = server->GetLobbyConnection() == connection
         ? "lobby" : "channel";
@@ -43,6 +43,7 @@
 // world Includes
 #include "AccountManager.h"
 #include "CharacterManager.h"
+#include "RelayMailbox.h"
 #include "WorldServer.h"
 
 using namespace world;
@@ -68,6 +69,7 @@ bool Parsers::Relay::Parse(libcomp::ManagerPacket *pPacketManager,
 
     bool reportOffline = false;
     std::list<libcomp::String> reportFailed;
+    std::list<std::shared_ptr<objects::CharacterLogin>> offlineLogins;
     std::list<std::shared_ptr<objects::CharacterLogin>> targetLogins;
     switch(mode)
     {
@@ -99,6 +101,11 @@ bool Parsers::Relay::Parse(libcomp::ManagerPacket *pPacketManager,
                         // but the client changed channels before receiving it
                         targetLogins.push_back(login);
                     }
+                    else if(login->GetChannelID() < 0)
+                    {
+                        // Logged off since the first send, hold it for them
+                        offlineLogins.push_back(login);
+                    }
                     else
                     {
                         auto character = login->GetCharacter().Get(db);
@@ -295,20 +302,7 @@ bool Parsers::Relay::Parse(libcomp::ManagerPacket *pPacketManager,
             }
             else if(reportOffline)
             {
-                auto character = c->GetCharacter().Get(db);
-                if(character)
-                {
-                    reportFailed.push_back(character->GetName());
-                }
-                else
-                {
-                    LogGeneralWarning([&]()
-                    {
-                        return libcomp::String("Failed relay attempt"
-                            " encountered with non-existent character: %1\n")
-                            .Arg(c->GetCharacter().GetUUID().ToString());
-                    });
-                }
+                offlineLogins.push_back(c);
             }
         }
 
@@ -329,6 +323,34 @@ bool Parsers::Relay::Parse(libcomp::ManagerPacket *pPacketManager,
         }
     }
 
+    if(offlineLogins.size() > 0)
+    {
+        // Hold what can be held for offline characters and report the rest
+        auto mailbox = server->GetRelayMailbox();
+        for(auto c : offlineLogins)
+        {
+            if(mailbox->Store(sourceCID, c, packetData))
+            {
+                continue;
+            }
+
+            auto character = c->GetCharacter().Get(db);
+            if(character)
+            {
+                reportFailed.push_back(character->GetName());
+            }
+            else
+            {
+                LogGeneralWarning([&]()
+                {
+                    return libcomp::String("Failed relay attempt"
+                        " encountered with non-existent character: %1\n")
+                        .Arg(c->GetCharacter().GetUUID().ToString());
+                });
+            }
+        }
+    }
+
     if(reportFailed.size() > 0)
     {
         // If anyone could not have the packet delivered, tell the sender
@@ -31,14 +31,21 @@
 #include <Crypto.h>
 
 // Standard C++11 Includes
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
-#include <regex>
+#include <map>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 // Standard C Includes
 #include <ctime>
+#include <sys/stat.h>
+
+/// Name of the file used to skip unchanged files on the next run.
+static const libcomp::String CACHE_NAME = "hashlist.cache";
 
 class FileData
 {
@@ -47,43 +54,197 @@ public:
     libcomp::String compressed_hash;
     libcomp::String uncompressed_hash;
 
-    int compressed_size;
-    int uncompressed_size;
+    int compressed_size = 0;
+    int uncompressed_size = 0;
 };
 
-std::unordered_map<libcomp::String, FileData*> ParseFileList(
-    const std::vector<char> data)
+/**
+ * Entry in the rehash cache. A file is only hashed again if the size or
+ * modification time of the source changed or the compressed copy is gone.
+ */
+class CacheData
 {
-    std::unordered_map<libcomp::String, FileData*> files;
+public:
+    int64_t mtime = 0;
+    int64_t size = 0;
 
-    std::list<libcomp::String> lines = libcomp::String(&data[0], data.size()).Split("\n");
+    FileData data;
+};
+
+/**
+ * Work item for one file in the overlay.
+ */
+class FileJob
+{
+public:
+    libcomp::String absPath;
+    libcomp::String shortComp;
+
+    FileData data;
+
+    bool valid = false;
+    bool cached = false;
+    int64_t mtime = 0;
+    int64_t size = 0;
+};
+
+static bool StatFile(const libcomp::String& path, int64_t& mtime,
+    int64_t& size)
+{
+    struct stat info;
+
+    if(0 != stat(path.C(), &info))
+    {
+        return false;
+    }
+
+    mtime = (int64_t)info.st_mtime;
+    size = (int64_t)info.st_size;
+
+    return true;
+}
+
+/**
+ * Parse one "FILE : .\path,hash,size,hash,size" line without a regex.
+ */
+static bool ParseFileLine(const std::string& line, FileData& info)
+{
+    static const std::string prefix = "FILE : ";
+
+    if(0 != line.compare(0, prefix.size(), prefix))
+    {
+        return false;
+    }
+
+    // Split from the end since the path itself may contain commas.
+    std::vector<std::string> fields;
+    size_t end = line.size();
+
+    for(int i = 0; i < 4; i++)
+    {
+        size_t comma = line.rfind(',', end - 1);
+
+        if(std::string::npos == comma || comma < prefix.size())
+        {
+            return false;
+        }
+
+        fields.push_back(line.substr(comma + 1, end - comma - 1));
+        end = comma;
+    }
+
+    std::string path = line.substr(prefix.size(), end - prefix.size());
+
+    // fields are in reverse order.
+    const std::string& compHash = fields[3];
+    const std::string& compSize = fields[2];
+    const std::string& uncompHash = fields[1];
+    const std::string& uncompSize = fields[0];
+
+    if(2 > path.size() || 32 != compHash.size() || 32 != uncompHash.size() ||
+        compSize.empty() || uncompSize.empty() ||
+        std::string::npos != compSize.find_first_not_of("0123456789") ||
+        std::string::npos != uncompSize.find_first_not_of("0123456789") ||
+        std::string::npos != compHash.find_first_not_of(
+            "0123456789abcdefABCDEF") ||
+        std::string::npos != uncompHash.find_first_not_of(
+            "0123456789abcdefABCDEF"))
+    {
+        return false;
+    }
+
+    info.path = libcomp::String(path).Mid(2).Replace("\\", "/");
+    info.compressed_hash = libcomp::String(compHash).ToUpper();
+    info.compressed_size = libcomp::String(compSize).ToInteger<int>();
+    info.uncompressed_hash = libcomp::String(uncompHash).ToUpper();
+    info.uncompressed_size = libcomp::String(uncompSize).ToInteger<int>();
+
+    return true;
+}
 
-    static const std::regex fileMatcher("FILE : (.+),([0-9a-fA-F]{32}),([0-9]+),"
-        "([0-9a-fA-F]{32}),([0-9]+)");
+std::map<libcomp::String, FileData> ParseFileList(
+    const std::vector<char>& data)
+{
+    std::map<libcomp::String, FileData> files;
+
+    std::list<libcomp::String> lines = libcomp::String(&data[0], data.size()).Split("\n");
 
     // Parse each line of the hashlist.dat file.
     for(auto line : lines)
     {
         std::string cleanLine = line.Trimmed().ToUtf8();
-        std::smatch match;
 
-        if(!std::regex_match(cleanLine, match, fileMatcher))
+        FileData info;
+
+        if(!ParseFileLine(cleanLine, info))
             continue;
 
         // Add each file entry to the map.
-        FileData *info = new FileData;
-        info->path = libcomp::String(match[1]).Mid(2).Replace("\\", "/");
-        info->compressed_hash = libcomp::String(match[2]).ToUpper();
-        info->compressed_size = libcomp::String(match[3]).ToInteger<int>();
-        info->uncompressed_hash = libcomp::String(match[4]).ToUpper();
-        info->uncompressed_size = libcomp::String(match[5]).ToInteger<int>();
-
-        files[info->path] = info;
+        files[info.path] = info;
     }
 
     return files;
 }
 
+std::unordered_map<libcomp::String, CacheData> LoadCache(
+    const libcomp::String& path)
+{
+    std::unordered_map<libcomp::String, CacheData> cache;
+
+    std::ifstream file(path.C());
+    std::string line;
+
+    // Each line is: mtime|size|path|comp hash|comp size|hash|size
+    while(std::getline(file, line))
+    {
+        auto fields = libcomp::String(line).Trimmed().Split("|");
+
+        if(7 != fields.size())
+            continue;
+
+        auto it = fields.begin();
+        bool ok = true;
+        bool allOk = true;
+
+        CacheData entry;
+        entry.mtime = (it++)->ToInteger<int64_t>(&ok); allOk &= ok;
+        entry.size = (it++)->ToInteger<int64_t>(&ok); allOk &= ok;
+        entry.data.path = *(it++);
+        entry.data.compressed_hash = *(it++);
+        entry.data.compressed_size = (it++)->ToInteger<int>(&ok); allOk &= ok;
+        entry.data.uncompressed_hash = *(it++);
+        entry.data.uncompressed_size = (it++)->ToInteger<int>(&ok); allOk &= ok;
+
+        if(allOk)
+        {
+            cache[entry.data.path] = entry;
+        }
+    }
+
+    return cache;
+}
+
+void SaveCache(const libcomp::String& path,
+    const std::vector<FileJob>& jobs)
+{
+    std::ofstream file(path.C(), std::ofstream::binary);
+
+    for(auto& job : jobs)
+    {
+        if(!job.valid)
+            continue;
+
+        libcomp::String line = libcomp::String("%1|%2|%3|%4|%5|%6|%7\n")
+            .Arg(job.mtime).Arg(job.size).Arg(job.data.path)
+            .Arg(job.data.compressed_hash).Arg(job.data.compressed_size)
+            .Arg(job.data.uncompressed_hash).Arg(job.data.uncompressed_size);
+
+        auto l = line.ToUtf8();
+
+        file.write(l.c_str(), (std::streamsize)l.size());
+    }
+}
+
 std::list<libcomp::String> RecursiveEntryList(const libcomp::String& dir)
 {
     std::list<libcomp::String> files;
@@ -106,14 +267,104 @@ std::list<libcomp::String> RecursiveEntryList(const libcomp::String& dir)
     return files;
 }
 
+/**
+ * Compress and hash one file, or reuse the cached result if the file has
+ * not changed since the last run.
+ */
+static void ProcessFile(FileJob& job,
+    const std::unordered_map<libcomp::String, CacheData>& cache)
+{
+    if(!StatFile(job.absPath, job.mtime, job.size))
+    {
+        return;
+    }
+
+    // Ignore empty files
+    if(0 == job.size)
+    {
+        return;
+    }
+
+    auto it = cache.find(job.shortComp);
+
+    if(cache.end() != it && it->second.mtime == job.mtime &&
+        it->second.size == job.size)
+    {
+        int64_t compMtime, compSize;
+
+        // Make sure the compressed copy is still what we made.
+        if(StatFile(job.absPath + ".compressed", compMtime, compSize) &&
+            compSize == (int64_t)it->second.data.compressed_size)
+        {
+            job.data = it->second.data;
+            job.valid = true;
+            job.cached = true;
+
+            return;
+        }
+    }
+
+    job.data.path = job.shortComp;
+
+    // Get the original file contents.
+    std::vector<char> uncomp_data = libcomp::Crypto::LoadFile(
+        job.absPath.ToUtf8());
+
+    // Ignore empty files
+    if(uncomp_data.empty())
+    {
+        return;
+    }
+
+    // Hash the original file.
+    job.data.uncompressed_hash = libcomp::Crypto::MD5(uncomp_data).ToUpper();
+    job.data.uncompressed_size = (int)uncomp_data.size();
+
+    //
+    // Process the compressed copy now.
+    //
+
+    // Calculate max size.
+    int out_size = (int)((float)uncomp_data.size() * 0.001f + 0.5f);
+    out_size += (int32_t)uncomp_data.size() + 12;
+
+    std::vector<char> out_buffer((size_t)out_size);
+
+    // Compress the file.
+    int32_t sz = libcomp::Compress::Compress(&uncomp_data[0], &out_buffer[0],
+        (int32_t)uncomp_data.size(), out_size, 9);
+
+    out_buffer.resize((size_t)sz);
+
+    // Write the compressed copy
+    {
+        std::ofstream file_comp;
+        file_comp.open(libcomp::String(job.absPath + ".compressed").C(),
+            std::ofstream::binary);
+        file_comp.write(&out_buffer[0], (std::streamsize)sz);
+        file_comp.close();
+    }
+
+    // Get the hash for the compressed copy.
+    job.data.compressed_hash = libcomp::Crypto::MD5(out_buffer).ToUpper();
+    job.data.compressed_size = sz;
+
+    job.valid = true;
+}
+
+static void Usage()
+{
+    std::cerr << "SYNTAX: comp_rehash --base BASE --overlay OVERLAY "
+        "[--threads N] [--no-cache]" << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
     // Check the arguments and print the usage.
-    if(argc != 5 || libcomp::String(argv[1]) != "--base" ||
+    if(argc < 5 || libcomp::String(argv[1]) != "--base" ||
         libcomp::String(argv[3]) != "--overlay")
     {
-        std::cerr << "SYNTAX: comp_rehash --base BASE --overlay OVERLAY"
-            << std::endl;
+        Usage();
 
         return -1;
     }
@@ -121,8 +372,45 @@ int main(int argc, char *argv[])
     libcomp::String base = argv[2];
     libcomp::String overlay = argv[4];
 
+    unsigned int threadCount = std::thread::hardware_concurrency();
+    bool useCache = true;
+
+    for(int i = 5; i < argc; i++)
+    {
+        libcomp::String arg = argv[i];
+
+        if(arg == "--threads" && (i + 1) < argc)
+        {
+            bool ok = false;
+            threadCount = libcomp::String(argv[++i]).ToInteger<
+                unsigned int>(&ok);
+
+            if(!ok)
+            {
+                Usage();
+
+                return -1;
+            }
+        }
+        else if(arg == "--no-cache")
+        {
+            useCache = false;
+        }
+        else
+        {
+            Usage();
+
+            return -1;
+        }
+    }
+
+    if(0 == threadCount)
+    {
+        threadCount = 1;
+    }
+
     // Read in the original file list
-    std::unordered_map<libcomp::String, FileData*> files;
+    std::map<libcomp::String, FileData> files;
 
     {
         // Open and read the hashlist.dat file.
@@ -141,104 +429,118 @@ int main(int argc, char *argv[])
         files = ParseFileList(hashlist);
     }
 
-    static const std::regex compressedRx("^.+\\.compressed$");
+    libcomp::String cachePath = libcomp::String("%1/%2").Arg(
+        overlay).Arg(CACHE_NAME);
 
-    // Find each file in the overlay and handle it.
-    for(auto filePath : RecursiveEntryList(overlay))
+    std::unordered_map<libcomp::String, CacheData> cache;
+
+    if(useCache)
     {
-        std::smatch match;
+        cache = LoadCache(cachePath);
+    }
+
+    static const libcomp::String compressedSuffix = ".compressed";
+
+    std::vector<FileJob> jobs;
 
+    // Find each file in the overlay and queue it.
+    for(auto filePath : RecursiveEntryList(overlay))
+    {
         auto file = filePath;
-        auto fileString = file.ToUtf8();
 
         // See if the file is an *.compressed file and ignore it.
-        if(std::regex_match(fileString, match, compressedRx))
+        if(file.Length() > compressedSuffix.Length() &&
+            file.Right(compressedSuffix.Length()) == compressedSuffix)
             continue;
 
         // Get the relative path.
         libcomp::String shortName = file.Mid(1);
 
-        // Make the path absolute.
-        file = overlay + file;
-
-        // Relative path for the compressed file.
-        libcomp::String shortComp = libcomp::String("%1.compressed").Arg(
-            shortName);
-
-        // Ignore the hashlist.dat and hashlist.ver files.
+        // Ignore the hashlist.dat, hashlist.ver and cache files.
         if(shortName == "hashlist.dat")
             continue;
         if(shortName == "hashlist.ver")
             continue;
+        if(shortName == CACHE_NAME)
+            continue;
 
-        // Check if the file is in the original hashlist.dat file.
-        auto it = files.find(shortComp);
+        FileJob job;
 
-        // If the file is in the base, remove the entry.
-        if(files.end() != it)
-        {
-            delete it->second;
-        }
+        // Make the path absolute.
+        job.absPath = overlay + file;
 
-        it = files.find(shortName);
+        // Relative path for the compressed file.
+        job.shortComp = libcomp::String("%1.compressed").Arg(shortName);
 
-        if(files.end() != it)
-        {
-            delete it->second;
+        // If the file is in the base, remove the entry.
+        files.erase(shortName);
+        files.erase(job.shortComp);
 
-            files.erase(it);
-        }
+        jobs.push_back(job);
+    }
 
-        // Create a new entry for the file.
-        FileData *d = new FileData;
-        d->path = shortComp;
+    auto start = std::chrono::steady_clock::now();
 
-        // Get the original file contents.
-        std::vector<char> uncomp_data = libcomp::Crypto::LoadFile(
-            file.ToUtf8());
+    // Compress and hash with a pool of workers.
+    {
+        std::atomic<size_t> nextJob(0);
+        std::vector<std::thread> workers;
 
-        // Ignore empty files
-        if (uncomp_data.empty())
+        for(unsigned int i = 0; i < threadCount; i++)
         {
-            continue;
+            workers.push_back(std::thread([&]()
+            {
+                for(size_t j = nextJob++; j < jobs.size(); j = nextJob++)
+                {
+                    ProcessFile(jobs[j], cache);
+                }
+            }));
         }
 
-        // Hash the original file.
-        d->uncompressed_hash = libcomp::Crypto::MD5(uncomp_data).ToUpper();
-        d->uncompressed_size = (int)uncomp_data.size();
+        for(auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
 
-        //
-        // Process the compressed copy now.
-        //
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
 
-        // Calculate max size.
-        int out_size = (int)((float)uncomp_data.size() * 0.001f + 0.5f);
-        out_size += (int32_t)uncomp_data.size() + 12;
-
-        char *out_buffer = new char[(size_t)out_size];
+    uint64_t hashedBytes = 0;
+    size_t hashedCount = 0;
+    size_t cachedCount = 0;
 
-        // Compress the file.
-        int32_t sz = libcomp::Compress::Compress(&uncomp_data[0], out_buffer,
-            (int32_t)uncomp_data.size(), out_size, 9);
+    for(auto& job : jobs)
+    {
+        if(!job.valid)
+            continue;
 
-        // Write the compressed copy
+        if(job.cached)
         {
-            std::ofstream file_comp;
-            file_comp.open(libcomp::String(file + ".compressed").C(),
-                std::ofstream::binary);
-            file_comp.write(out_buffer, (std::streamsize)sz);
-            file_comp.close();
+            cachedCount++;
+        }
+        else
+        {
+            hashedCount++;
+            hashedBytes += (uint64_t)job.data.uncompressed_size;
         }
-
-        // Get the hash for the compressed copy.
-        d->compressed_hash = libcomp::Crypto::MD5(std::vector<char>(
-            out_buffer, out_buffer + sz)).ToUpper();
-        d->compressed_size = sz;
 
         // Save the entry.
-        files[shortComp] = d;
+        files[job.shortComp] = job.data;
+    }
 
-        delete[] out_buffer;
+    double seconds = elapsed.count() > 0.0 ? elapsed.count() : 1e-9;
+
+    std::cout << "Hashed " << hashedCount << " files ("
+        << ((double)hashedBytes / 1048576.0) << " MB) and reused "
+        << cachedCount << " unchanged files in " << elapsed.count()
+        << " s using " << threadCount << " threads ("
+        << ((double)hashedBytes / 1048576.0 / seconds) << " MB/s)"
+        << std::endl;
+
+    if(useCache)
+    {
+        SaveCache(cachePath, jobs);
     }
 
     // Write the overlay hashlist.dat file now.
@@ -249,7 +551,7 @@ int main(int argc, char *argv[])
     // Add each file in the list.
     for(auto file : files)
     {
-        FileData *d = file.second;
+        FileData *d = &file.second;
 
 
         libcomp::String line = "FILE : .\\%1,%2,%3,%4,%5 ";